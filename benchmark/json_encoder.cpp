@@ -0,0 +1,249 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <benchmark/benchmark.h>
+
+#include <fmt/format.h>
+
+#include "roq/decimal.hpp"
+
+#include "roq/binance_futures/json/encoder.hpp"
+#include "roq/binance_futures/json/map.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+auto const ID = "qQAC6QMAAQAAVtg9ctAW"sv;
+auto const REQUEST_ID = "qQAC6QMAAQAAVtg9ctAV"sv;
+auto const RECV_WINDOW = 5000ms;
+auto const NOW_UTC = 1735689600123ms;
+
+auto create_create_order() {
+  auto create_order = CreateOrder{};
+  create_order.account = "A1"sv;
+  create_order.order_id = 1234;
+  create_order.exchange = "binance-futures"sv;
+  create_order.symbol = "BTCUSDT"sv;
+  create_order.side = Side::BUY;
+  create_order.order_type = roq::OrderType::LIMIT;
+  create_order.time_in_force = roq::TimeInForce::GTC;
+  create_order.quantity = 0.123;
+  create_order.price = 93456.7;
+  create_order.stop_price = NaN;
+  return create_order;
+}
+
+auto create_oms_order() {
+  auto order = server::oms::Order{};
+  order.symbol = "BTCUSDT"sv;
+  order.side = Side::BUY;
+  order.external_order_id = "17759343290"sv;
+  order.quantity = 0.123;
+  order.price = 93456.7;
+  order.quantity_precision = {0.001, Precision::_3};
+  order.price_precision = {0.1, Precision::_1};
+  return order;
+}
+
+// note! reference implementation (this is what the encoder used to do)
+
+std::string_view order_place_json_fmt(
+    std::vector<char> &buffer,
+    CreateOrder const &create_order,
+    server::oms::Order const &order,
+    std::string_view const &request_id,
+    std::chrono::milliseconds recv_window,
+    std::chrono::milliseconds now_utc,
+    std::string_view const &id) {
+  auto side = json::map(create_order.side).template get<json::Side>();
+  auto type = json::map(create_order.order_type).template get<json::OrderType>();
+  auto time_in_force = json::map(create_order.time_in_force).template get<json::TimeInForce>();
+  buffer.clear();
+  fmt::format_to(
+      std::back_inserter(buffer),
+      R"({{)"
+      R"("id":"{}",)"
+      R"("method":"order.place",)"
+      R"("params":{{)"
+      R"("newClientOrderId":"{}")"
+      R"(,"symbol":"{}")"
+      R"(,"side":"{}")"
+      R"(,"type":"{}")"
+      R"(,"quantity":"{}")"sv,
+      id,
+      request_id,
+      create_order.symbol,
+      side.as_raw_text(),
+      type.as_raw_text(),
+      Decimal{create_order.quantity, order.quantity_precision.precision});
+  if (time_in_force != json::TimeInForce{}) {
+    fmt::format_to(std::back_inserter(buffer), R"(,"timeInForce":"{}")"sv, time_in_force.as_raw_text());
+  }
+  if (!std::isnan(create_order.price)) {
+    fmt::format_to(std::back_inserter(buffer), R"(,"price":"{}")"sv, Decimal{create_order.price, order.price_precision.precision});
+  }
+  if (!std::isnan(create_order.stop_price)) {
+    fmt::format_to(std::back_inserter(buffer), R"(,"stopPrice":"{}")"sv, Decimal{create_order.stop_price, order.price_precision.precision});
+  }
+  fmt::format_to(
+      std::back_inserter(buffer),
+      R"(,"recvWindow":{})"
+      R"(,"timestamp":{})"
+      R"(}})"
+      R"(}})"sv,
+      recv_window.count(),
+      now_utc.count());
+  return {std::data(buffer), std::size(buffer)};
+}
+
+std::string_view order_cancel_json_fmt(
+    std::vector<char> &buffer,
+    server::oms::Order const &order,
+    std::chrono::milliseconds recv_window,
+    std::chrono::milliseconds now_utc,
+    std::string_view const &id) {
+  buffer.clear();
+  fmt::format_to(
+      std::back_inserter(buffer),
+      R"({{)"
+      R"("id":"{}",)"
+      R"("method":"order.cancel",)"
+      R"("params":{{)"
+      R"("symbol":"{}")"sv,
+      id,
+      order.symbol);
+  if (std::empty(order.external_order_id)) {
+    fmt::format_to(std::back_inserter(buffer), R"(,"origClientOrderId":"{}")"sv, order.client_order_id);
+  } else {
+    fmt::format_to(std::back_inserter(buffer), R"(,"orderId":{})"sv, order.external_order_id);
+  }
+  fmt::format_to(
+      std::back_inserter(buffer),
+      R"(,"recvWindow":{})"
+      R"(,"timestamp":{})"
+      R"(}})"
+      R"(}})"sv,
+      recv_window.count(),
+      now_utc.count());
+  return {std::data(buffer), std::size(buffer)};
+}
+
+std::string_view order_place_url_fmt(
+    std::vector<char> &buffer,
+    CreateOrder const &create_order,
+    server::oms::Order const &order,
+    std::string_view const &request_id,
+    std::chrono::milliseconds recv_window) {
+  auto side = json::map(create_order.side).template get<json::Side>();
+  auto type = json::map(create_order.order_type).template get<json::OrderType>();
+  auto time_in_force = json::map(create_order.time_in_force).template get<json::TimeInForce>();
+  buffer.clear();
+  fmt::format_to(
+      std::back_inserter(buffer),
+      R"(symbol={}&)"
+      R"(side={}&)"
+      R"(type={}&)"
+      R"(quantity={}&)"
+      R"(reduceOnly={}&)"
+      R"(timeInForce={}&)"
+      R"(price={}&)"
+      R"(newClientOrderId={}&)"
+      R"(recvWindow={})"sv,
+      create_order.symbol,
+      side.as_raw_text(),
+      type.as_raw_text(),
+      Decimal{create_order.quantity, order.quantity_precision.precision},
+      false,
+      time_in_force.as_raw_text(),
+      Decimal{create_order.price, order.price_precision.precision},
+      request_id,
+      recv_window.count());
+  return {std::data(buffer), std::size(buffer)};
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// order-place (json)
+
+void BM_json_encoder_order_place_json_fmt(benchmark::State &state) {
+  auto create_order = create_create_order();
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = order_place_json_fmt(buffer, create_order, order, REQUEST_ID, RECV_WINDOW, NOW_UTC, ID);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_place_json_fmt);
+
+void BM_json_encoder_order_place_json_writer(benchmark::State &state) {
+  json::OrderTemplates order_templates;
+  auto create_order = create_create_order();
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = json::Encoder::order_place_json(buffer, order_templates, create_order, order, REQUEST_ID, RECV_WINDOW, NOW_UTC, ID);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_place_json_writer);
+
+// order-cancel (json)
+
+void BM_json_encoder_order_cancel_json_fmt(benchmark::State &state) {
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = order_cancel_json_fmt(buffer, order, RECV_WINDOW, NOW_UTC, ID);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_cancel_json_fmt);
+
+void BM_json_encoder_order_cancel_json_writer(benchmark::State &state) {
+  auto cancel_order = CancelOrder{};
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = json::Encoder::order_cancel_json(buffer, cancel_order, order, REQUEST_ID, {}, RECV_WINDOW, NOW_UTC, ID);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_cancel_json_writer);
+
+// order-place (url)
+
+void BM_json_encoder_order_place_url_fmt(benchmark::State &state) {
+  auto create_order = create_create_order();
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = order_place_url_fmt(buffer, create_order, order, REQUEST_ID, RECV_WINDOW);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_place_url_fmt);
+
+void BM_json_encoder_order_place_url_writer(benchmark::State &state) {
+  json::OrderTemplates order_templates;
+  auto create_order = create_create_order();
+  auto order = create_oms_order();
+  std::vector<char> buffer;
+  for (auto _ : state) {
+    auto message = json::Encoder::order_place_url(buffer, order_templates, create_order, order, REQUEST_ID, RECV_WINDOW);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+BENCHMARK(BM_json_encoder_order_place_url_writer);
@@ -0,0 +1,154 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <benchmark/benchmark.h>
+
+#include "roq/core/json/parser.hpp"
+
+#include "roq/binance_futures/json/order_trade_update.hpp"
+#include "roq/binance_futures/json/trade_lite.hpp"
+#include "roq/binance_futures/json/user_stream_parser.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === HELPERS ===
+
+namespace {
+// note! captured fills
+
+auto const ORDER_TRADE_UPDATE = R"({)"
+                                R"("e":"ORDER_TRADE_UPDATE",)"
+                                R"("T":1634812374563,)"
+                                R"("E":1634812374567,)"
+                                R"("o":{)"
+                                R"("s":"XRPUSDT",)"
+                                R"("c":"-gAC6QMAAQAAYIZV_g4X",)"
+                                R"("S":"SELL",)"
+                                R"("o":"LIMIT",)"
+                                R"("f":"GTC",)"
+                                R"("q":"5",)"
+                                R"("p":"1.1583",)"
+                                R"("ap":"1.15830",)"
+                                R"("sp":"0",)"
+                                R"("x":"TRADE",)"
+                                R"("X":"FILLED",)"
+                                R"("i":17803846427,)"
+                                R"("l":"5",)"
+                                R"("z":"5",)"
+                                R"("L":"1.1583",)"
+                                R"("n":"0.00115829",)"
+                                R"("N":"USDT",)"
+                                R"("T":1634812374563,)"
+                                R"("t":673747843,)"
+                                R"("b":"0",)"
+                                R"("a":"0",)"
+                                R"("m":true,)"
+                                R"("R":false,)"
+                                R"("wt":"CONTRACT_PRICE",)"
+                                R"("ot":"LIMIT",)"
+                                R"("ps":"BOTH",)"
+                                R"("cp":false,)"
+                                R"("rp":"0",)"
+                                R"("pP":false,)"
+                                R"("si":0,)"
+                                R"("ss":0)"
+                                R"(})"
+                                R"(})"sv;
+
+auto const TRADE_LITE = R"({)"
+                        R"("e":"TRADE_LITE",)"
+                        R"("E":1721895408092,)"
+                        R"("T":1721895408214,)"
+                        R"("s":"BTCUSDT",)"
+                        R"("q":"0.001",)"
+                        R"("p":"0",)"
+                        R"("m":false,)"
+                        R"("c":"z8hcUoOsqEdKMeKPSABslD",)"
+                        R"("S":"BUY",)"
+                        R"("L":"64089.20",)"
+                        R"("l":"0.040",)"
+                        R"("t":109100866,)"
+                        R"("i":8886774)"
+                        R"(})"sv;
+
+size_t const BUFFER_SIZE = 8192;
+size_t const MAX_DEPTH = 1;
+
+struct Handler final : public json::UserStreamParser::Handler {
+  void operator()(Trace<json::FastOrderTradeUpdate> const &event) override { benchmark::DoNotOptimize(event.value); }
+  void operator()(Trace<json::AccountUpdate> const &) override {}
+  void operator()(Trace<json::MarginCall> const &) override {}
+  void operator()(Trace<json::StrategyUpdate> const &) override {}
+  void operator()(Trace<json::GridUpdate> const &) override {}
+  void operator()(Trace<json::AccountConfigUpdate> const &) override {}
+  void operator()(Trace<json::FastTradeLite> const &event) override { benchmark::DoNotOptimize(event.value); }
+  void operator()(Trace<json::ExecutionReport2> const &) override {}
+  void operator()(Trace<json::BalanceUpdate> const &) override {}
+  void operator()(Trace<json::LiabilityChange> const &) override {}
+  void operator()(Trace<json::OutboundAccountPosition> const &) override {}
+};
+
+// note! reference implementation (this is what the parser used to do)
+
+template <typename T>
+void dispatch_dom(std::string_view const &message, core::json::BufferStack &buffer_stack) {
+  core::json::Parser parser{message};
+  auto root = parser.root();
+  for (auto [key, value] : std::get<core::json::Object>(root)) {
+    if (key != "e"sv) {
+      continue;
+    }
+    T obj{message, buffer_stack};
+    benchmark::DoNotOptimize(obj);
+    break;
+  }
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// order-trade-update
+
+void BM_json_user_stream_parser_order_trade_update_dom(benchmark::State &state) {
+  core::json::BufferStack buffer_stack{BUFFER_SIZE, MAX_DEPTH};
+  for (auto _ : state) {
+    dispatch_dom<json::OrderTradeUpdate>(ORDER_TRADE_UPDATE, buffer_stack);
+  }
+}
+
+BENCHMARK(BM_json_user_stream_parser_order_trade_update_dom);
+
+void BM_json_user_stream_parser_order_trade_update_fast(benchmark::State &state) {
+  core::json::BufferStack buffer_stack{BUFFER_SIZE, MAX_DEPTH};
+  Handler handler;
+  for (auto _ : state) {
+    auto result = json::UserStreamParser::dispatch(handler, ORDER_TRADE_UPDATE, buffer_stack, {}, false);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_json_user_stream_parser_order_trade_update_fast);
+
+// trade-lite
+
+void BM_json_user_stream_parser_trade_lite_dom(benchmark::State &state) {
+  core::json::BufferStack buffer_stack{BUFFER_SIZE, MAX_DEPTH};
+  for (auto _ : state) {
+    dispatch_dom<json::TradeLite>(TRADE_LITE, buffer_stack);
+  }
+}
+
+BENCHMARK(BM_json_user_stream_parser_trade_lite_dom);
+
+void BM_json_user_stream_parser_trade_lite_fast(benchmark::State &state) {
+  core::json::BufferStack buffer_stack{BUFFER_SIZE, MAX_DEPTH};
+  Handler handler;
+  for (auto _ : state) {
+    auto result = json::UserStreamParser::dispatch(handler, TRADE_LITE, buffer_stack, {}, false);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_json_user_stream_parser_trade_lite_fast);
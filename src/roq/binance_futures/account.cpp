@@ -2,6 +2,8 @@
 
 #include "roq/binance_futures/account.hpp"
 
+#include <cassert>
+
 #include "roq/logging.hpp"
 
 using namespace std::literals;
@@ -37,24 +39,27 @@ auto create_crypto(auto &config, auto &name, auto margin_mode) {
 
 // === IMPLEMENTATION ===
 
-Account::Account(Config const &config, std::string_view const &name, MarginMode margin_mode)
-    : name{name}, margin_mode{margin_mode}, crypto_{create_crypto<decltype(crypto_)>(config, name, margin_mode)},
+Account::Account(Settings const &settings, Config const &config, std::string_view const &name, MarginMode margin_mode, tools::ClockOffset const &clock_offset)
+    : name{name}, margin_mode{margin_mode}, governor{settings.rest.order_rate_limit_utilization}, clock_offset_{clock_offset},
+      crypto_{create_crypto<decltype(crypto_)>(config, name, margin_mode)},
       query_encode_buffer_(tools::Crypto::QUERY_BUFFER_LENGTH) {
 }
 
-std::string Account::create_rest_signature() {
-  auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
-  return crypto_.create_rest_signature(now_utc);
+std::chrono::milliseconds Account::now_utc() const {
+  return clock_offset_.adjust(clock::get_realtime<std::chrono::milliseconds>());
+}
+
+std::string_view Account::create_rest_signature() {
+  return crypto_.create_rest_signature(query_encode_buffer_, now_utc());
 }
 
-std::string Account::create_rest_signature_body(std::string_view const &body) {
-  auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
-  return crypto_.create_rest_signature_body(now_utc, body);
+std::string_view Account::create_rest_signature_query(std::string_view const &query) {
+  return crypto_.create_rest_signature_query(query_encode_buffer_, now_utc(), query);
 }
 
-std::string Account::create_rest_signature_query(std::string_view const &query) {
-  auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
-  return crypto_.create_rest_signature_query(now_utc, query);
+std::string_view Account::sign_rest_body(std::vector<char> &buffer, std::string_view const &body) {
+  assert(std::data(body) == std::data(buffer));
+  return crypto_.sign_rest_body(buffer, std::size(body), now_utc());
 }
 
 }  // namespace binance_futures
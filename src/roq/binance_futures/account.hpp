@@ -6,16 +6,20 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "roq/binance_futures/config.hpp"
+#include "roq/binance_futures/settings.hpp"
 
+#include "roq/binance_futures/tools/clock_offset.hpp"
 #include "roq/binance_futures/tools/crypto.hpp"
+#include "roq/binance_futures/tools/governor.hpp"
 
 namespace roq {
 namespace binance_futures {
 
 struct Account final {
-  Account(Config const &, std::string_view const &name, MarginMode);
+  Account(Settings const &, Config const &, std::string_view const &name, MarginMode, tools::ClockOffset const &);
 
   Account(Account const &) = delete;
 
@@ -23,11 +27,17 @@ struct Account final {
 
   std::string_view get_rest_headers() const { return crypto_.get_rest_headers(); }
 
+  // note! request timestamp (adjusted by the estimated exchange clock offset, if enabled)
+  std::chrono::milliseconds now_utc() const;
+
   // classic
 
-  std::string create_rest_signature();
-  std::string create_rest_signature_body(std::string_view const &body);
-  std::string create_rest_signature_query(std::string_view const &query);
+  // note! the result is only valid until the next call
+  std::string_view create_rest_signature();
+  std::string_view create_rest_signature_query(std::string_view const &query);
+
+  // note! signs in place, the body must be a view of the front of the buffer
+  std::string_view sign_rest_body(std::vector<char> &buffer, std::string_view const &body);
 
   // ed25519
 
@@ -36,10 +46,14 @@ struct Account final {
   std::string const name;
   MarginMode const margin_mode;
 
+  // note! order rate limits are per account (shared by all connections)
+  tools::Governor governor;
+
  private:
+  tools::ClockOffset const &clock_offset_;
   tools::Crypto crypto_;
   std::string sign_buffer_;
-  std::vector<std::byte> query_encode_buffer_;
+  std::vector<char> query_encode_buffer_;
 };
 
 }  // namespace binance_futures
@@ -30,6 +30,7 @@ API API::create(Settings const &settings) {
             .order = "/fapi/v1/order"sv,
             .all_open_orders = "/fapi/v1/allOpenOrders"sv,
             .countdown_cancel_all = "/fapi/v1/countdownCancelAll"sv,
+            .batch_orders = "/fapi/v1/batchOrders"sv,
         },
         .papi{
             .listen_key = "/papi/v1/listenKey"sv,
@@ -61,6 +62,7 @@ API API::create(Settings const &settings) {
             .order = "/dapi/v1/order"sv,
             .all_open_orders = "/dapi/v1/allOpenOrders"sv,
             .countdown_cancel_all = "/dapi/v1/countdownCancelAll"sv,
+            .batch_orders = "/dapi/v1/batchOrders"sv,
         },
         .papi{
             .listen_key = "/papi/v1/listenKey"sv,
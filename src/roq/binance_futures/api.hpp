@@ -24,6 +24,7 @@ struct API final {
     std::string_view order;
     std::string_view all_open_orders;
     std::string_view countdown_cancel_all;
+    std::string_view batch_orders;
   } simple;
   struct {
     std::string_view listen_key;
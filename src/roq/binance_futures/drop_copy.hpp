@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "roq/api.hpp"
 
 #include "roq/metrics/writer.hpp"
@@ -18,9 +20,15 @@ struct DropCopy {
 
   virtual void operator()(Event<Start> const &) = 0;
   virtual void operator()(Event<Stop> const &) = 0;
-  virtual void operator()(Event<Timer> const &) = 0;
 
   virtual void operator()(metrics::Writer &) const = 0;
+
+  // note! only used when the user data stream is received by another session (ws-api)
+  virtual void set_ready(bool ready) = 0;
+  virtual void parse(std::string_view const &message) = 0;
+
+  // note! only used by redundant connections (the group decides which connection drives the download)
+  virtual void start_download() = 0;
 };
 
 }  // namespace binance_futures
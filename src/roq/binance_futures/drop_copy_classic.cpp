@@ -3,12 +3,16 @@
 #include "roq/binance_futures/drop_copy_classic.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <memory>
 
 #include "roq/mask.hpp"
 
 #include "roq/utils/common.hpp"
 #include "roq/utils/update.hpp"
 
+#include "roq/utils/charconv/to_string.hpp"
+
 #include "roq/utils/exceptions/unhandled.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
@@ -37,6 +41,12 @@ auto const SUPPORTS = Mask{
 };
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 2;
+
+uint32_t const TIMER_REFRESH = 1;
+
+size_t const MAX_TRADES = 1024;
+
+auto const TRADE_CURSOR_SAVE_FREQ = 10s;  // note! also saved when a trades download completes
 }  // namespace
 
 // === HELPERS ===
@@ -53,11 +63,14 @@ auto create_uri(auto &settings, auto &listen_key) {
   return io::web::URI{result};
 }
 
-auto create_connection(auto &handler, auto &settings, auto &context, auto &listen_key) {
+std::unique_ptr<web::socket::Client> create_connection(auto &handler, auto &settings, auto &context, auto &listen_key, auto &interface) {
+  if (std::empty(listen_key)) {
+    return {};  // note! attached to the ws-api session
+  }
   auto uri = create_uri(settings, listen_key);
   auto config = web::socket::Client::Config{
       // connection
-      .interface = {},
+      .interface = interface,
       .uris = {&uri, 1},
       .host = settings.ws.host,
       .validate_certificate = settings.net.tls_validate_certificate,
@@ -79,6 +92,18 @@ auto create_connection(auto &handler, auto &settings, auto &context, auto &liste
   return web::socket::Client::create(handler, context, config, []() { return std::string(); });
 }
 
+// note! account updates have no identifier (and several can share the same transaction time)
+auto get_fingerprint(auto &account_update) {
+  uint64_t result = {};
+  for (auto &item : account_update.data.balances) {
+    result = (result * 31) ^ std::bit_cast<uint64_t>(item.wallet_balance);
+  }
+  for (auto &item : account_update.data.positions) {
+    result = (result * 31) ^ std::bit_cast<uint64_t>(item.position_amount);
+  }
+  return static_cast<int64_t>(result);
+}
+
 struct create_metrics final : public utils::metrics::Factory {
   create_metrics(auto &settings, auto &group, auto const &function) : utils::metrics::Factory{settings.app.name, group, function} {}
 };
@@ -87,11 +112,24 @@ struct create_metrics final : public utils::metrics::Factory {
 // === IMPLEMENTATION ===
 
 DropCopyClassic::DropCopyClassic(
-    Handler &handler, io::Context &context, uint16_t stream_id, Account &account, Shared &shared, Request &request, std::string_view const &listen_key)
-    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_)}, connection_{create_connection(*this, shared.settings, context, listen_key)},
+    Handler &handler,
+    io::Context &context,
+    uint16_t stream_id,
+    Account &account,
+    Shared &shared,
+    Request &request,
+    std::string_view const &listen_key,
+    std::string_view const &interface,
+    DropCopyGroup *group)
+    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_)},
+      connection_{create_connection(*this, shared.settings, context, listen_key, interface)},
       decode_buffer_{shared.settings.misc.decode_buffer_size, MAX_DECODE_BUFFER_DEPTH},
       counter_{
           .disconnect = create_metrics(shared.settings, name_, "disconnect"sv),
+          .duplicate_trade = create_metrics(shared.settings, name_, "duplicate_trade"sv),
+          .first_arrival = create_metrics(shared.settings, name_, "first_arrival"sv),
+          .late_arrival = create_metrics(shared.settings, name_, "late_arrival"sv),
+          .unchanged = create_metrics(shared.settings, name_, "unchanged"sv),
       },
       profile_{
           .parse = create_metrics(shared.settings, name_, "parse"sv),
@@ -110,34 +148,92 @@ DropCopyClassic::DropCopyClassic(
       latency_{
           .ping = create_metrics(shared.settings, name_, "ping"sv),
           .heartbeat = create_metrics(shared.settings, name_, "heartbeat"sv),
+          .order_new = create_metrics(shared.settings, name_, "order_new"sv),
+          .order_fill = create_metrics(shared.settings, name_, "order_fill"sv),
       },
-      account_{account}, shared_{shared}, request_{request}, download_{{}, [this](auto state) { return download(state); }} {
+      account_{account}, shared_{shared}, request_{request}, download_{{}, [this](auto state) { return download(state); }},
+      group_{group}, trade_cache_{MAX_TRADES},
+      first_arrival_{group ? &(*group).get_first_arrival() : nullptr},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+      } {
 }
 
 bool DropCopyClassic::ready() const {
+  if (!static_cast<bool>(connection_)) {
+    return ready_;
+  }
   return (*connection_).ready();
 }
 
 void DropCopyClassic::operator()(Event<Start> const &) {
-  (*connection_).start();
+  if (static_cast<bool>(connection_)) {
+    (*connection_).start();
+  }
+  timer_.refresh.start(clock::get_system());
 }
 
 void DropCopyClassic::operator()(Event<Stop> const &) {
-  (*connection_).stop();
+  timer_.refresh.stop();
+  if (static_cast<bool>(connection_)) {
+    (*connection_).stop();
+  }
+}
+
+// note! the ws-api session reports subscription status (and the download is repeated after each new subscription)
+void DropCopyClassic::set_ready(bool ready) {
+  if (static_cast<bool>(connection_)) {
+    log::warn(R"(Unexpected: account="{}" is already using a listen-key connection)"sv, account_.name);
+    return;
+  }
+  if (ready) {
+    if (status_ == ConnectionStatus::DOWNLOADING || status_ == ConnectionStatus::READY) {
+      return;
+    }
+    start_download();
+  } else {
+    ready_ = false;
+    (*this)(ConnectionStatus::DISCONNECTED);
+    download_.reset();
+  }
 }
 
-void DropCopyClassic::operator()(Event<Timer> const &event) {
-  (*connection_).refresh(event.value.now);
-  check_response_balance();
-  check_response_account();
-  check_response_orders();
-  check_response_trades();
+void DropCopyClassic::start_download() {
+  (*this)(ConnectionStatus::DOWNLOADING);
+  download_.begin();
+}
+
+// tools::TimerWheel::Handler
+
+void DropCopyClassic::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      if (static_cast<bool>(connection_)) {
+        (*connection_).refresh(now);
+      }
+      check_response_balance();
+      check_response_account();
+      check_response_orders();
+      check_response_trades();
+      if (next_trade_cursor_save_ <= now) {
+        next_trade_cursor_save_ = now + TRADE_CURSOR_SAVE_FREQ;
+        request_.trade_cursor.save();
+      }
+      break;
+    default:
+      assert(false);
+  }
 }
 
 void DropCopyClassic::operator()(metrics::Writer &writer) const {
   writer
       // counter
       .write(counter_.disconnect, metrics::Type::COUNTER)
+      .write(counter_.duplicate_trade, metrics::Type::COUNTER)
+      .write(counter_.first_arrival, metrics::Type::COUNTER)
+      .write(counter_.late_arrival, metrics::Type::COUNTER)
+      .write(counter_.unchanged, metrics::Type::COUNTER)
       // profile
       .write(profile_.parse, metrics::Type::PROFILE)
       .write(profile_.order_trade_update, metrics::Type::PROFILE)
@@ -153,7 +249,9 @@ void DropCopyClassic::operator()(metrics::Writer &writer) const {
       .write(profile_.outbound_account_position, metrics::Type::PROFILE)
       // latency
       .write(latency_.ping, metrics::Type::LATENCY)
-      .write(latency_.heartbeat, metrics::Type::LATENCY);
+      .write(latency_.heartbeat, metrics::Type::LATENCY)
+      .write(latency_.order_new, metrics::Type::LATENCY)
+      .write(latency_.order_fill, metrics::Type::LATENCY);
 }
 
 void DropCopyClassic::operator()(web::socket::Client::Connected const &) {
@@ -164,11 +262,19 @@ void DropCopyClassic::operator()(web::socket::Client::Disconnected const &) {
   ready_ = false;
   (*this)(ConnectionStatus::DISCONNECTED);
   download_.reset();
+  // note! trades may be missed until the next download has completed (unless another connection of the group is still receiving)
+  if (group_ == nullptr || (*group_).disconnected(*this)) {
+    request_.trade_cursor.set_stale(clock::get_system());
+  }
 }
 
 void DropCopyClassic::operator()(web::socket::Client::Ready const &) {
-  (*this)(ConnectionStatus::DOWNLOADING);
-  download_.begin();
+  // note! only one connection of a redundant group drives the download
+  if (group_ != nullptr && !(*group_).ready(*this)) {
+    (*this)(ConnectionStatus::READY);
+    return;
+  }
+  start_download();
 }
 
 void DropCopyClassic::operator()(web::socket::Client::Close const &) {
@@ -205,11 +311,13 @@ void DropCopyClassic::operator()(ConnectionStatus status) {
         .encoding = {Encoding::JSON},
         .priority = Priority::PRIMARY,
         .connection_status = status_,
-        .interface = (*connection_).get_interface(),
-        .authority = (*connection_).get_current_authority(),
-        .path = (*connection_).get_current_path(),
-        .proxy = (*connection_).get_proxy(),
     };
+    if (static_cast<bool>(connection_)) {
+      stream_status.interface = (*connection_).get_interface();
+      stream_status.authority = (*connection_).get_current_authority();
+      stream_status.path = (*connection_).get_current_path();
+      stream_status.proxy = (*connection_).get_proxy();
+    }
     log::info("stream_status={}"sv, stream_status);
     create_trace_and_dispatch(handler_, trace_info, stream_status);
   }
@@ -241,6 +349,9 @@ uint32_t DropCopyClassic::download(DropCopyState state) {
       (*this)(ConnectionStatus::READY);
       assert(!ready_);
       ready_ = true;
+      if (group_ != nullptr) {
+        (*group_).downloaded(*this);
+      }
       return 0;
   }
   assert(false);
@@ -262,41 +373,53 @@ void DropCopyClassic::parse(std::string_view const &message) {
   });
 }
 
-void DropCopyClassic::operator()(Trace<json::OrderTradeUpdate> const &event) {
+void DropCopyClassic::operator()(Trace<json::FastOrderTradeUpdate> const &event) {
   profile_.order_trade_update([&]() {
     auto &trace_info = event.trace_info;
     auto &order_trade_update = event.value;
     log::info<3>("order_trade_update={}"sv, order_trade_update);
-    auto &execution_report = order_trade_update.execution_report;
-    auto external_order_id = fmt::format("{}"sv, execution_report.order_id);  // alloc
-    auto liquidity = execution_report.is_trade_maker ? Liquidity::MAKER : Liquidity::TAKER;
-    // XXX HANS execution_report.execution_type ==> OrderAck ???
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::ORDER_TRADE_UPDATE,
+        .status = static_cast<uint8_t>(static_cast<json::ExecutionType::type_t>(order_trade_update.execution_type)),
+        .order_id = order_trade_update.order_id,
+        .update_time = order_trade_update.transaction_time,
+        .trade_id = order_trade_update.trade_id,
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    // note! the event must have happened before we received it
+    shared_.clock_offset.update_lower_bound(clock::get_realtime<std::chrono::nanoseconds>(), order_trade_update.event_time);
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), order_trade_update.order_id);
+    auto liquidity = order_trade_update.is_trade_maker ? Liquidity::MAKER : Liquidity::TAKER;
+    // XXX HANS order_trade_update.execution_type ==> OrderAck ???
     auto order_update = server::oms::OrderUpdate{
         .account = account_.name,
         .exchange = shared_.settings.exchange,
-        .symbol = execution_report.symbol,
-        .side = map(execution_report.side),
+        .symbol = order_trade_update.symbol,
+        .side = map(order_trade_update.side),
         .position_effect = {},
         .margin_mode = {},
         .max_show_quantity = NaN,
-        .order_type = map(execution_report.order_type),
-        .time_in_force = map(execution_report.time_in_force),
+        .order_type = map(order_trade_update.order_type),
+        .time_in_force = map(order_trade_update.time_in_force),
         .execution_instructions = {},
         .create_time_utc = {},
         .update_time_utc = order_trade_update.transaction_time,
         .external_account = {},
         .external_order_id = external_order_id,
-        .client_order_id = execution_report.client_order_id,
-        .order_status = map(execution_report.order_status),
-        .quantity = execution_report.original_quantity,
-        .price = execution_report.original_price,
-        .stop_price = execution_report.stop_price,
+        .client_order_id = order_trade_update.client_order_id,
+        .order_status = map(order_trade_update.order_status),
+        .quantity = order_trade_update.original_quantity,
+        .price = order_trade_update.original_price,
+        .stop_price = order_trade_update.stop_price,
         .leverage = NaN,
         .remaining_quantity = NaN,
-        .traded_quantity = execution_report.order_filled_accumulated_quantity,
-        .average_traded_price = execution_report.average_price,
-        .last_traded_quantity = execution_report.last_filled_quantity,
-        .last_traded_price = execution_report.last_filled_price,
+        .traded_quantity = order_trade_update.order_filled_accumulated_quantity,
+        .average_traded_price = order_trade_update.average_price,
+        .last_traded_quantity = order_trade_update.last_filled_quantity,
+        .last_traded_price = order_trade_update.last_filled_price,
         .last_liquidity = liquidity,
         .routing_id = {},
         .max_request_version = {},
@@ -305,50 +428,79 @@ void DropCopyClassic::operator()(Trace<json::OrderTradeUpdate> const &event) {
         .update_type = UpdateType::INCREMENTAL,
         .sending_time_utc = order_trade_update.event_time,
     };
-    auto user_id = SOURCE_NONE;
+    // note! a redundant order update is dropped but the fill must still be published
+    auto redundant = !shared_.check_order_update(order_update, order_trade_update.order_id);
+    if (redundant && order_trade_update.execution_type != json::ExecutionType::TRADE) {
+      log::info<3>("Drop order update (redundant or out of order): order_trade_update={}"sv, order_trade_update);
+      return;
+    }
+    // note! the fill may already have been published from TRADE_LITE (the order update must then not repeat it)
+    auto duplicate_trade = order_trade_update.execution_type == json::ExecutionType::TRADE && shared_.settings.ws.trade_lite &&
+                           !is_new_trade(order_trade_update.order_id, order_trade_update.trade_id);
+    if (duplicate_trade) {
+      order_update.last_traded_quantity = NaN;
+      order_update.last_traded_price = NaN;
+      order_update.last_liquidity = {};
+    }
+    auto user_id = shared_.update_quote_leg(request_.quote_legs, order_update);  // note! quote legs are not known to the order management system
     auto order_id = ORDER_ID_NONE;
     auto strategy_id = STRATEGY_ID_NONE;
-    if (shared_.update_order(execution_report.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
-          user_id = order.user_id;
-          order_id = order.order_id;
-          strategy_id = order.strategy_id;
-        })) {
+    // note! the order update is forwarded if the routing is not yet known
+    auto route = redundant ? shared_.find_order_route(order_update, order_trade_update.order_id) : nullptr;
+    if (user_id != SOURCE_NONE) {
+    } else if (route) {
+      log::info<3>("Drop order update (redundant or out of order): order_trade_update={}"sv, order_trade_update);
+      user_id = (*route).user_id;
+      order_id = (*route).order_id;
+      strategy_id = (*route).strategy_id;
+    } else if (shared_.update_order(order_trade_update.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
+                 user_id = order.user_id;
+                 order_id = order.order_id;
+                 strategy_id = order.strategy_id;
+               })) {
+      shared_.set_order_route(order_update, order_trade_update.order_id, {.user_id = user_id, .order_id = order_id, .strategy_id = strategy_id});
     } else {
       log::warn("*** EXTERNAL ORDER ***"sv);
-      log::warn("execution_report={}"sv, execution_report);
+      log::warn("order_trade_update={}"sv, order_trade_update);
+    }
+    update_order_latency(order_trade_update.execution_type, user_id, order_id);
+    if (order_trade_update.execution_type != json::ExecutionType::TRADE) {
+      return;
     }
-    if (execution_report.execution_type != json::ExecutionType::TRADE) {
+    if (duplicate_trade) {
+      ++counter_.duplicate_trade;
       return;
     }
-    auto side = map(execution_report.side).template get<Side>();
-    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, execution_report.symbol);
+    update_trade_cursor(order_trade_update.symbol, order_trade_update.trade_id);
+    auto side = map(order_trade_update.side).template get<Side>();
+    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, order_trade_update.symbol);
     auto profit_loss_amount =
-        utils::compute_profit_loss_amount(side, execution_report.last_filled_quantity, execution_report.last_filled_price, ref_data.multiplier);
+        utils::compute_profit_loss_amount(side, order_trade_update.last_filled_quantity, order_trade_update.last_filled_price, ref_data.multiplier);
     auto fill = Fill{
-        .exchange_time_utc = execution_report.order_trade_time,
+        .exchange_time_utc = order_trade_update.order_trade_time,
         .external_trade_id = {},
-        .quantity = execution_report.last_filled_quantity,
-        .price = execution_report.last_filled_price,
+        .quantity = order_trade_update.last_filled_quantity,
+        .price = order_trade_update.last_filled_price,
         .liquidity = liquidity,
-        .commission_amount = execution_report.commission,
-        .commission_currency = execution_report.commission_asset,
+        .commission_amount = order_trade_update.commission,
+        .commission_currency = order_trade_update.commission_asset,
         .base_amount = NaN,
         .quote_amount = NaN,
         .profit_loss_amount = profit_loss_amount,
     };
-    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, execution_report.trade_id);
+    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, order_trade_update.trade_id);
     auto trade_update = TradeUpdate{
         .stream_id = stream_id_,
         .account = account_.name,
         .order_id = order_id,
         .exchange = shared_.settings.exchange,
-        .symbol = execution_report.symbol,
+        .symbol = order_trade_update.symbol,
         .side = side,
         .position_effect = {},
         .margin_mode = {},
         .quantity_type = {},
-        .create_time_utc = execution_report.order_trade_time,
-        .update_time_utc = execution_report.order_trade_time,
+        .create_time_utc = order_trade_update.order_trade_time,
+        .update_time_utc = order_trade_update.order_trade_time,
         .external_account = {},
         .external_order_id = external_order_id,
         .client_order_id = {},
@@ -359,7 +511,12 @@ void DropCopyClassic::operator()(Trace<json::OrderTradeUpdate> const &event) {
         .user = {},
         .strategy_id = strategy_id,
     };
-    create_trace_and_dispatch(handler_, trace_info, trade_update, true, user_id, execution_report.client_order_id);
+    auto position_update = update_position(order_trade_update.symbol, side, order_trade_update.last_filled_quantity, order_trade_update.transaction_time);
+    create_trace_and_dispatch(handler_, trace_info, trade_update, !position_update, user_id, order_trade_update.client_order_id);
+    if (position_update) {
+      (*position_update).sending_time_utc = order_trade_update.event_time;
+      create_trace_and_dispatch(handler_, trace_info, *position_update, true);
+    }
   });
 }
 
@@ -367,6 +524,18 @@ void DropCopyClassic::operator()(Trace<json::AccountUpdate> const &event) {
   profile_.account_update([&]() {
     auto &[trace_info, account_update] = event;
     log::info<2>("account_update={}"sv, account_update);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::ACCOUNT_UPDATE,
+        .status = {},
+        .order_id = {},
+        .update_time = account_update.transaction_time,
+        .trade_id = get_fingerprint(account_update),
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    funds_updates_.clear();
+    position_updates_.clear();
     for (auto &item : account_update.data.balances) {
       log::info<2>("item={}"sv, item);
       auto funds_update = FundsUpdate{
@@ -382,7 +551,7 @@ void DropCopyClassic::operator()(Trace<json::AccountUpdate> const &event) {
           .exchange_time_utc = account_update.transaction_time,
           .sending_time_utc = account_update.event_time,
       };
-      create_trace_and_dispatch(handler_, trace_info, funds_update, true);
+      add_funds_update(funds_update);
       if (!std::isnan(item.cross_wallet_balance)) {
         auto funds_update = FundsUpdate{
             .stream_id = stream_id_,
@@ -397,7 +566,7 @@ void DropCopyClassic::operator()(Trace<json::AccountUpdate> const &event) {
             .exchange_time_utc = account_update.transaction_time,
             .sending_time_utc = account_update.event_time,
         };
-        create_trace_and_dispatch(handler_, trace_info, funds_update, true);
+        add_funds_update(funds_update);
       }
     }
     for (auto &item : account_update.data.positions) {
@@ -418,6 +587,13 @@ void DropCopyClassic::operator()(Trace<json::AccountUpdate> const &event) {
         }
         return MarginMode{};
       }();
+      auto hedged = item.position_side == json::PositionSide::LONG || item.position_side == json::PositionSide::SHORT;
+      // note! older than the last fill (the position published from fills is more recent)
+      if (!request_.position_keeper.reconcile(item.symbol, margin_mode, item.position_amount, account_update.transaction_time, hedged) &&
+          shared_.settings.ws.position_from_fills) {
+        log::info<3>(R"(Drop position update (older than the last fill): symbol="{}")"sv, item.symbol);
+        continue;
+      }
       auto long_quantity = std::max(0.0, item.position_amount);
       auto short_quantity = std::max(0.0, -item.position_amount);
       auto position_update = PositionUpdate{
@@ -433,7 +609,16 @@ void DropCopyClassic::operator()(Trace<json::AccountUpdate> const &event) {
           .exchange_time_utc = account_update.transaction_time,
           .sending_time_utc = account_update.event_time,
       };
-      create_trace_and_dispatch(handler_, trace_info, position_update, true);
+      add_position_update(position_update);
+    }
+    // note! batched, is_last is only set for the final update
+    auto size = std::size(funds_updates_) + std::size(position_updates_);
+    size_t index = 0;
+    for (auto &funds_update : funds_updates_) {
+      create_trace_and_dispatch(handler_, trace_info, funds_update, ++index == size);
+    }
+    for (auto &position_update : position_updates_) {
+      create_trace_and_dispatch(handler_, trace_info, position_update, ++index == size);
     }
   });
 }
@@ -466,11 +651,124 @@ void DropCopyClassic::operator()(Trace<json::AccountConfigUpdate> const &event)
   });
 }
 
-void DropCopyClassic::operator()(Trace<json::TradeLite> const &event) {
+void DropCopyClassic::operator()(Trace<json::FastTradeLite> const &event) {
   profile_.trade_lite([&]() {
     auto &[trace_info, trade_lite] = event;
-    log::info<2>("trade_lite={}"sv, trade_lite);
-    log::warn("DEBUG trade_lite={}"sv, trade_lite);
+    log::info<3>("trade_lite={}"sv, trade_lite);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::TRADE_LITE,
+        .status = {},
+        .order_id = trade_lite.order_id,
+        .update_time = trade_lite.transaction_time,
+        .trade_id = trade_lite.trade_id,
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    if (!shared_.settings.ws.trade_lite) {
+      return;
+    }
+    // note! the trade may already have been published from ORDER_TRADE_UPDATE
+    if (!is_new_trade(trade_lite.order_id, trade_lite.trade_id)) {
+      ++counter_.duplicate_trade;
+      return;
+    }
+    update_trade_cursor(trade_lite.symbol, trade_lite.trade_id);
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), trade_lite.order_id);
+    auto liquidity = trade_lite.maker ? Liquidity::MAKER : Liquidity::TAKER;
+    // note! provisional (order status and accumulated quantities are only known when ORDER_TRADE_UPDATE is received)
+    auto order_update = server::oms::OrderUpdate{
+        .account = account_.name,
+        .exchange = shared_.settings.exchange,
+        .symbol = trade_lite.symbol,
+        .side = map(trade_lite.side),
+        .position_effect = {},
+        .margin_mode = {},
+        .max_show_quantity = NaN,
+        .order_type = {},
+        .time_in_force = {},
+        .execution_instructions = {},
+        .create_time_utc = {},
+        .update_time_utc = trade_lite.transaction_time,
+        .external_account = {},
+        .external_order_id = external_order_id,
+        .client_order_id = trade_lite.client_order_id,
+        .order_status = {},
+        .quantity = NaN,
+        .price = NaN,
+        .stop_price = NaN,
+        .leverage = NaN,
+        .remaining_quantity = NaN,
+        .traded_quantity = NaN,
+        .average_traded_price = NaN,
+        .last_traded_quantity = trade_lite.last_filled_quantity,
+        .last_traded_price = trade_lite.last_filled_price,
+        .last_liquidity = liquidity,
+        .routing_id = {},
+        .max_request_version = {},
+        .max_response_version = {},
+        .max_accepted_version = {},
+        .update_type = UpdateType::INCREMENTAL,
+        .sending_time_utc = trade_lite.event_time,
+    };
+    auto user_id = shared_.update_quote_leg(request_.quote_legs, order_update);  // note! quote legs are not known to the order management system
+    auto order_id = ORDER_ID_NONE;
+    auto strategy_id = STRATEGY_ID_NONE;
+    if (user_id == SOURCE_NONE && !shared_.update_order(trade_lite.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
+          user_id = order.user_id;
+          order_id = order.order_id;
+          strategy_id = order.strategy_id;
+        })) {
+      log::warn("*** EXTERNAL ORDER ***"sv);
+      log::warn("trade_lite={}"sv, trade_lite);
+    }
+    update_order_latency(json::ExecutionType::TRADE, user_id, order_id);
+    auto side = map(trade_lite.side).template get<Side>();
+    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, trade_lite.symbol);
+    auto profit_loss_amount = utils::compute_profit_loss_amount(side, trade_lite.last_filled_quantity, trade_lite.last_filled_price, ref_data.multiplier);
+    // note! commission is not available
+    auto fill = Fill{
+        .exchange_time_utc = trade_lite.transaction_time,
+        .external_trade_id = {},
+        .quantity = trade_lite.last_filled_quantity,
+        .price = trade_lite.last_filled_price,
+        .liquidity = liquidity,
+        .commission_amount = NaN,
+        .commission_currency = {},
+        .base_amount = NaN,
+        .quote_amount = NaN,
+        .profit_loss_amount = profit_loss_amount,
+    };
+    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, trade_lite.trade_id);
+    auto trade_update = TradeUpdate{
+        .stream_id = stream_id_,
+        .account = account_.name,
+        .order_id = order_id,
+        .exchange = shared_.settings.exchange,
+        .symbol = trade_lite.symbol,
+        .side = side,
+        .position_effect = {},
+        .margin_mode = {},
+        .quantity_type = {},
+        .create_time_utc = trade_lite.transaction_time,
+        .update_time_utc = trade_lite.transaction_time,
+        .external_account = {},
+        .external_order_id = external_order_id,
+        .client_order_id = {},
+        .fills = {&fill, 1},
+        .routing_id = {},
+        .update_type = UpdateType::INCREMENTAL,
+        .sending_time_utc = trade_lite.event_time,
+        .user = {},
+        .strategy_id = strategy_id,
+    };
+    auto position_update = update_position(trade_lite.symbol, side, trade_lite.last_filled_quantity, trade_lite.transaction_time);
+    create_trace_and_dispatch(handler_, trace_info, trade_update, !position_update, user_id, trade_lite.client_order_id);
+    if (position_update) {
+      (*position_update).sending_time_utc = trade_lite.event_time;
+      create_trace_and_dispatch(handler_, trace_info, *position_update, true);
+    }
   });
 }
 
@@ -507,6 +805,113 @@ void DropCopyClassic::operator()(Trace<json::OutboundAccountPosition> const &eve
   });
 }
 
+// note! skips incremental updates when nothing has changed (e.g. the same balance reported for every fill)
+void DropCopyClassic::add_funds_update(FundsUpdate const &funds_update) {
+  if (!request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold)) {
+    ++counter_.unchanged;
+    return;
+  }
+  funds_updates_.emplace_back(funds_update);
+}
+
+void DropCopyClassic::add_position_update(PositionUpdate const &position_update) {
+  if (!request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity)) {
+    ++counter_.unchanged;
+    return;
+  }
+  position_updates_.emplace_back(position_update);
+}
+
+// note! positions are published directly from fills (one round-trip before ACCOUNT_UPDATE)
+std::optional<PositionUpdate> DropCopyClassic::update_position(
+    std::string_view const &symbol, Side side, double quantity, std::chrono::milliseconds transaction_time) {
+  if (!shared_.settings.ws.position_from_fills) {
+    return {};
+  }
+  auto signed_quantity = side == Side::SELL ? -quantity : quantity;
+  tools::PositionKeeper::Position position;
+  if (!request_.position_keeper.fill(symbol, signed_quantity, transaction_time, position)) {
+    return {};
+  }
+  request_.account_cache.position(position.margin_mode, symbol, position.long_quantity, position.short_quantity);
+  return PositionUpdate{
+      .stream_id = stream_id_,
+      .account = account_.name,
+      .exchange = shared_.settings.exchange,
+      .symbol = symbol,
+      .margin_mode = position.margin_mode,
+      .external_account = {},
+      .long_quantity = position.long_quantity,
+      .short_quantity = position.short_quantity,
+      .update_type = UpdateType::INCREMENTAL,
+      .exchange_time_utc = transaction_time,
+      .sending_time_utc = {},
+  };
+}
+
+// note! redundant connections deliver the same events, the counters can be used to compute a win-rate per connection
+bool DropCopyClassic::is_first_arrival(tools::UserStreamEvent const &key) {
+  if (first_arrival_ == nullptr) {
+    return true;
+  }
+  if ((*first_arrival_)(key)) {
+    ++counter_.first_arrival;
+    return true;
+  }
+  ++counter_.late_arrival;
+  return false;
+}
+
+// note! the trade cache must be shared when the trade can be reported by different connections
+bool DropCopyClassic::is_new_trade(int64_t order_id, int64_t trade_id) {
+  auto key = tools::UserStreamEvent{
+      .type = tools::UserStreamEvent::Type::TRADE,
+      .status = {},
+      .order_id = order_id,
+      .update_time = {},
+      .trade_id = trade_id,
+  };
+  if (first_arrival_ == nullptr) {
+    return trade_cache_(key);
+  }
+  return (*first_arrival_)(key);
+}
+
+// note! the cursor must not skip past trades we have missed (after a disconnect or while a download is pending)
+void DropCopyClassic::update_trade_cursor(std::string_view const &symbol, int64_t trade_id) {
+  if (request_.trade_cursor.stale() || request_.respond_trades < request_.request_trades) {
+    return;
+  }
+  request_.trade_cursor.update(symbol, trade_id);
+}
+
+// note! wall-clock latency measured from when the order request was sent
+void DropCopyClassic::update_order_latency(json::ExecutionType execution_type, uint8_t user_id, uint64_t order_id) {
+  if (user_id == SOURCE_NONE) {
+    return;
+  }
+  auto key = tools::OrderLatency::Key{
+      .user_id = user_id,
+      .order_id = order_id,
+  };
+  auto now = clock::get_system();
+  switch (execution_type) {
+    using enum json::ExecutionType::type_t;
+    case NEW:
+      if (auto sample = shared_.order_latency.new_order(key, now); sample.count() > 0) {
+        latency_.order_new.update(sample);
+      }
+      break;
+    case TRADE:
+      if (auto sample = shared_.order_latency.first_fill(key, now); sample.count() > 0) {
+        latency_.order_fill.update(sample);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 // request
 
 void DropCopyClassic::request_balance() {
@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "roq/utils/metrics/counter.hpp"
 #include "roq/utils/metrics/latency.hpp"
@@ -21,16 +23,21 @@
 
 #include "roq/binance_futures/account.hpp"
 #include "roq/binance_futures/drop_copy.hpp"
+#include "roq/binance_futures/drop_copy_group.hpp"
 #include "roq/binance_futures/drop_copy_state.hpp"
 #include "roq/binance_futures/request.hpp"
 #include "roq/binance_futures/shared.hpp"
 
+#include "roq/binance_futures/tools/first_arrival.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 #include "roq/binance_futures/json/user_stream_parser.hpp"
 
 namespace roq {
 namespace binance_futures {
 
-struct DropCopyClassic final : public DropCopy, public web::socket::Client::Handler, public json::UserStreamParser::Handler {
+struct DropCopyClassic final : public DropCopy, public web::socket::Client::Handler, public json::UserStreamParser::Handler, public tools::TimerWheel::Handler {
   struct Handler {
     virtual void operator()(Trace<StreamStatus> const &) = 0;
     virtual void operator()(Trace<ExternalLatency> const &) = 0;
@@ -39,7 +46,17 @@ struct DropCopyClassic final : public DropCopy, public web::socket::Client::Hand
     virtual void operator()(Trace<PositionUpdate> const &, bool is_last) = 0;
   };
 
-  DropCopyClassic(Handler &, io::Context &, uint16_t stream_id, Account &, Shared &, Request &, std::string_view const &listen_key);
+  // note! an empty listen key means the user data stream is received (and forwarded) by the ws-api session
+  DropCopyClassic(
+      Handler &,
+      io::Context &,
+      uint16_t stream_id,
+      Account &,
+      Shared &,
+      Request &,
+      std::string_view const &listen_key,
+      std::string_view const &interface = {},
+      DropCopyGroup *group = nullptr);
 
   DropCopyClassic(DropCopyClassic &&) = delete;
   DropCopyClassic(DropCopyClassic const &) = delete;
@@ -48,10 +65,14 @@ struct DropCopyClassic final : public DropCopy, public web::socket::Client::Hand
 
   void operator()(Event<Start> const &) override;
   void operator()(Event<Stop> const &) override;
-  void operator()(Event<Timer> const &) override;
 
   void operator()(metrics::Writer &) const override;
 
+  void set_ready(bool ready) override;
+  void parse(std::string_view const &message) override;
+
+  void start_download() override;
+
  protected:
   void operator()(web::socket::Client::Connected const &) override;
   void operator()(web::socket::Client::Disconnected const &) override;
@@ -61,25 +82,37 @@ struct DropCopyClassic final : public DropCopy, public web::socket::Client::Hand
   void operator()(web::socket::Client::Text const &) override;
   void operator()(web::socket::Client::Binary const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
  private:
   void operator()(ConnectionStatus);
 
   uint32_t download(DropCopyState);
 
-  void parse(std::string_view const &message);
-
-  void operator()(Trace<json::OrderTradeUpdate> const &) override;
+  void operator()(Trace<json::FastOrderTradeUpdate> const &) override;
   void operator()(Trace<json::AccountUpdate> const &) override;
   void operator()(Trace<json::MarginCall> const &) override;
   void operator()(Trace<json::StrategyUpdate> const &) override;
   void operator()(Trace<json::GridUpdate> const &) override;
   void operator()(Trace<json::AccountConfigUpdate> const &) override;
-  void operator()(Trace<json::TradeLite> const &) override;
+  void operator()(Trace<json::FastTradeLite> const &) override;
   void operator()(Trace<json::ExecutionReport2> const &) override;
   void operator()(Trace<json::BalanceUpdate> const &) override;
   void operator()(Trace<json::LiabilityChange> const &) override;
   void operator()(Trace<json::OutboundAccountPosition> const &) override;
 
+  void add_funds_update(FundsUpdate const &);
+  void add_position_update(PositionUpdate const &);
+  std::optional<PositionUpdate> update_position(std::string_view const &symbol, Side, double quantity, std::chrono::milliseconds transaction_time);
+
+  bool is_first_arrival(tools::UserStreamEvent const &);
+  bool is_new_trade(int64_t order_id, int64_t trade_id);
+  void update_trade_cursor(std::string_view const &symbol, int64_t trade_id);
+
+  void update_order_latency(json::ExecutionType, uint8_t user_id, uint64_t order_id);
+
   void request_balance();
   void request_account();
   void request_orders();
@@ -100,14 +133,15 @@ struct DropCopyClassic final : public DropCopy, public web::socket::Client::Hand
   core::json::BufferStack decode_buffer_;
   // metrics
   struct {
-    utils::metrics::Counter disconnect;
+    utils::metrics::Counter disconnect, duplicate_trade, first_arrival, late_arrival, unchanged;
   } counter_;
   struct {
     utils::metrics::Profile parse, order_trade_update, account_update, margin_call, strategy_update, grid_update, account_config_update, trade_lite,
         execution_report, balance_update, liability_change, outbound_account_position;
   } profile_;
   struct {
-    utils::metrics::Latency ping, heartbeat;
+    utils::metrics::Latency ping, heartbeat,  //
+        order_new, order_fill;
   } latency_;
   // authentication
   Account &account_;
@@ -118,6 +152,16 @@ struct DropCopyClassic final : public DropCopy, public web::socket::Client::Hand
   bool ready_ = false;
   ConnectionStatus status_ = {};
   core::Download<DropCopyState> download_;
+  DropCopyGroup *const group_;  // note! redundant connections (null if not used)
+  tools::FirstArrival trade_cache_;
+  tools::FirstArrival *const first_arrival_;  // note! shared by redundant connections (null if not used)
+  std::vector<FundsUpdate> funds_updates_;  // note! batched from ACCOUNT_UPDATE
+  std::vector<PositionUpdate> position_updates_;
+  std::chrono::nanoseconds next_trade_cursor_save_ = {};
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+  } timer_;
 };
 
 }  // namespace binance_futures
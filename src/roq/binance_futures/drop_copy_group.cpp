@@ -0,0 +1,93 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/drop_copy_group.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "roq/logging.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+
+// === IMPLEMENTATION ===
+
+DropCopyGroup::DropCopyGroup(size_t capacity) : first_arrival_{capacity} {
+}
+
+void DropCopyGroup::add(std::unique_ptr<DropCopy> &&connection) {
+  assert(static_cast<bool>(connection));
+  connections_.emplace_back(std::move(connection));
+}
+
+bool DropCopyGroup::ready(DropCopy &connection) {
+  ready_.emplace_back(&connection);
+  if (downloaded_ || leader_ != nullptr) {
+    return false;
+  }
+  leader_ = &connection;
+  return true;
+}
+
+void DropCopyGroup::downloaded(DropCopy &connection) {
+  assert(leader_ == &connection);
+  if (leader_ != &connection) [[unlikely]] {
+    return;
+  }
+  leader_ = nullptr;
+  downloaded_ = true;
+}
+
+bool DropCopyGroup::disconnected(DropCopy &connection) {
+  std::erase(ready_, &connection);
+  if (std::empty(ready_)) {
+    leader_ = nullptr;
+    downloaded_ = false;
+    return true;
+  }
+  if (leader_ == &connection) {
+    log::info("Download was interrupted, continuing with another connection"sv);
+    leader_ = ready_.front();
+    (*leader_).start_download();
+  }
+  return false;
+}
+
+void DropCopyGroup::operator()(Event<Start> const &event) {
+  assert(!std::empty(connections_));
+  for (auto &item : connections_) {
+    (*item)(event);
+  }
+}
+
+void DropCopyGroup::operator()(Event<Stop> const &event) {
+  for (auto &item : connections_) {
+    (*item)(event);
+  }
+}
+
+void DropCopyGroup::operator()(metrics::Writer &writer) const {
+  for (auto &item : connections_) {
+    (*item)(writer);
+  }
+}
+
+// note! the user stream is never attached to the ws-api session when using redundant connections
+
+void DropCopyGroup::set_ready(bool) {
+  log::fatal("Unexpected"sv);
+}
+
+void DropCopyGroup::parse(std::string_view const &) {
+  log::fatal("Unexpected"sv);
+}
+
+void DropCopyGroup::start_download() {
+  log::fatal("Unexpected"sv);
+}
+
+}  // namespace binance_futures
+}  // namespace roq
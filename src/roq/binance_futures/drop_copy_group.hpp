@@ -0,0 +1,59 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "roq/binance_futures/drop_copy.hpp"
+
+#include "roq/binance_futures/tools/first_arrival.hpp"
+
+namespace roq {
+namespace binance_futures {
+
+// redundant user stream connections for the same account
+// note! all connections receive the same events, only the first copy of each event is processed
+// note! only one connection drives the download (it's repeated when that connection is lost before completion, or when all connections were lost)
+// note! each connection exports its own first (and late) arrival counters
+
+struct DropCopyGroup final : public DropCopy {
+  explicit DropCopyGroup(size_t capacity);
+
+  DropCopyGroup(DropCopyGroup &&) = delete;
+  DropCopyGroup(DropCopyGroup const &) = delete;
+
+  void add(std::unique_ptr<DropCopy> &&);
+
+  tools::FirstArrival &get_first_arrival() { return first_arrival_; }
+
+  // note! called by the connections
+
+  // returns true if the connection must drive the download
+  bool ready(DropCopy &);
+  void downloaded(DropCopy &);
+  // returns true if no connection remains
+  bool disconnected(DropCopy &);
+
+  void operator()(Event<Start> const &) override;
+  void operator()(Event<Stop> const &) override;
+
+  void operator()(metrics::Writer &) const override;
+
+  void set_ready(bool ready) override;
+  void parse(std::string_view const &message) override;
+
+  void start_download() override;
+
+ private:
+  tools::FirstArrival first_arrival_;
+  std::vector<std::unique_ptr<DropCopy>> connections_;
+  // state
+  std::vector<DropCopy *> ready_;
+  DropCopy *leader_ = nullptr;  // note! the connection driving the download
+  bool downloaded_ = false;
+};
+
+}  // namespace binance_futures
+}  // namespace roq
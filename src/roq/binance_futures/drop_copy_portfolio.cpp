@@ -3,12 +3,15 @@
 #include "roq/binance_futures/drop_copy_portfolio.hpp"
 
 #include <algorithm>
+#include <bit>
 
 #include "roq/mask.hpp"
 
 #include "roq/utils/common.hpp"
 #include "roq/utils/update.hpp"
 
+#include "roq/utils/charconv/to_string.hpp"
+
 #include "roq/utils/exceptions/unhandled.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
@@ -39,6 +42,10 @@ auto const SUPPORTS = Mask{
 };
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 2;
+
+uint32_t const TIMER_REFRESH = 1;
+
+size_t const MAX_TRADES = 1024;
 }  // namespace
 
 // === HELPERS ===
@@ -55,11 +62,11 @@ auto create_uri(auto &settings, auto &listen_key) {
   return io::web::URI{result};
 }
 
-auto create_connection(auto &handler, auto &settings, auto &context, auto &listen_key) {
+auto create_connection(auto &handler, auto &settings, auto &context, auto &listen_key, auto &interface) {
   auto uri = create_uri(settings, listen_key);
   auto config = web::socket::Client::Config{
       // connection
-      .interface = {},
+      .interface = interface,
       .uris = {&uri, 1},
       .host = settings.ws.pm_host,
       .validate_certificate = settings.net.tls_validate_certificate,
@@ -81,6 +88,18 @@ auto create_connection(auto &handler, auto &settings, auto &context, auto &liste
   return web::socket::Client::create(handler, context, config, []() { return std::string(); });
 }
 
+// note! account updates have no identifier (and several can share the same transaction time)
+auto get_fingerprint(auto &account_update) {
+  uint64_t result = {};
+  for (auto &item : account_update.data.balances) {
+    result = (result * 31) ^ std::bit_cast<uint64_t>(item.wallet_balance);
+  }
+  for (auto &item : account_update.data.positions) {
+    result = (result * 31) ^ std::bit_cast<uint64_t>(item.position_amount);
+  }
+  return static_cast<int64_t>(result);
+}
+
 struct create_metrics final : public utils::metrics::Factory {
   create_metrics(auto &settings, auto &group, auto const &function) : utils::metrics::Factory{settings.app.name, group, function} {}
 };
@@ -89,11 +108,24 @@ struct create_metrics final : public utils::metrics::Factory {
 // === IMPLEMENTATION ===
 
 DropCopyPortfolio::DropCopyPortfolio(
-    Handler &handler, io::Context &context, uint16_t stream_id, Account &account, Shared &shared, Request &request, std::string_view const &listen_key)
-    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_)}, connection_{create_connection(*this, shared.settings, context, listen_key)},
+    Handler &handler,
+    io::Context &context,
+    uint16_t stream_id,
+    Account &account,
+    Shared &shared,
+    Request &request,
+    std::string_view const &listen_key,
+    std::string_view const &interface,
+    DropCopyGroup *group)
+    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_)},
+      connection_{create_connection(*this, shared.settings, context, listen_key, interface)},
       decode_buffer_{shared.settings.misc.decode_buffer_size, MAX_DECODE_BUFFER_DEPTH},
       counter_{
           .disconnect = create_metrics(shared.settings, name_, "disconnect"sv),
+          .duplicate_trade = create_metrics(shared.settings, name_, "duplicate_trade"sv),
+          .first_arrival = create_metrics(shared.settings, name_, "first_arrival"sv),
+          .late_arrival = create_metrics(shared.settings, name_, "late_arrival"sv),
+          .unchanged = create_metrics(shared.settings, name_, "unchanged"sv),
       },
       profile_{
           .parse = create_metrics(shared.settings, name_, "parse"sv),
@@ -112,8 +144,15 @@ DropCopyPortfolio::DropCopyPortfolio(
       latency_{
           .ping = create_metrics(shared.settings, name_, "ping"sv),
           .heartbeat = create_metrics(shared.settings, name_, "heartbeat"sv),
+          .order_new = create_metrics(shared.settings, name_, "order_new"sv),
+          .order_fill = create_metrics(shared.settings, name_, "order_fill"sv),
       },
-      account_{account}, shared_{shared}, request_{request}, download_{{}, [this](auto state) { return download(state); }} {
+      account_{account}, shared_{shared}, request_{request}, download_{{}, [this](auto state) { return download(state); }},
+      group_{group}, trade_cache_{MAX_TRADES},
+      first_arrival_{group ? &(*group).get_first_arrival() : nullptr},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+      } {
 }
 
 bool DropCopyPortfolio::ready() const {
@@ -122,25 +161,40 @@ bool DropCopyPortfolio::ready() const {
 
 void DropCopyPortfolio::operator()(Event<Start> const &) {
   (*connection_).start();
+  timer_.refresh.start(clock::get_system());
 }
 
 void DropCopyPortfolio::operator()(Event<Stop> const &) {
+  timer_.refresh.stop();
   (*connection_).stop();
 }
 
-void DropCopyPortfolio::operator()(Event<Timer> const &event) {
-  (*connection_).refresh(event.value.now);
-  check_response_balance();
-  check_response_account();
-  check_response_position();
-  check_response_orders();
-  check_response_trades();
+// tools::TimerWheel::Handler
+
+void DropCopyPortfolio::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      (*connection_).refresh(now);
+      check_response_balance();
+      check_response_account();
+      check_response_position();
+      check_response_orders();
+      check_response_trades();
+      break;
+    default:
+      assert(false);
+  }
 }
 
 void DropCopyPortfolio::operator()(metrics::Writer &writer) const {
   writer
       // counter
       .write(counter_.disconnect, metrics::Type::COUNTER)
+      .write(counter_.duplicate_trade, metrics::Type::COUNTER)
+      .write(counter_.first_arrival, metrics::Type::COUNTER)
+      .write(counter_.late_arrival, metrics::Type::COUNTER)
+      .write(counter_.unchanged, metrics::Type::COUNTER)
       // profile
       .write(profile_.parse, metrics::Type::PROFILE)
       .write(profile_.order_trade_update, metrics::Type::PROFILE)
@@ -156,7 +210,19 @@ void DropCopyPortfolio::operator()(metrics::Writer &writer) const {
       .write(profile_.outbound_account_position, metrics::Type::PROFILE)
       // latency
       .write(latency_.ping, metrics::Type::LATENCY)
-      .write(latency_.heartbeat, metrics::Type::LATENCY);
+      .write(latency_.heartbeat, metrics::Type::LATENCY)
+      .write(latency_.order_new, metrics::Type::LATENCY)
+      .write(latency_.order_fill, metrics::Type::LATENCY);
+}
+
+// note! the ws-api session can not be used to receive the portfolio margin user data stream
+void DropCopyPortfolio::set_ready(bool) {
+  log::fatal("Unexpected"sv);
+}
+
+void DropCopyPortfolio::start_download() {
+  (*this)(ConnectionStatus::DOWNLOADING);
+  download_.begin();
 }
 
 void DropCopyPortfolio::operator()(web::socket::Client::Connected const &) {
@@ -167,11 +233,18 @@ void DropCopyPortfolio::operator()(web::socket::Client::Disconnected const &) {
   ready_ = false;
   (*this)(ConnectionStatus::DISCONNECTED);
   download_.reset();
+  if (group_ != nullptr) {
+    (*group_).disconnected(*this);
+  }
 }
 
 void DropCopyPortfolio::operator()(web::socket::Client::Ready const &) {
-  (*this)(ConnectionStatus::DOWNLOADING);
-  download_.begin();
+  // note! only one connection of a redundant group drives the download
+  if (group_ != nullptr && !(*group_).ready(*this)) {
+    (*this)(ConnectionStatus::READY);
+    return;
+  }
+  start_download();
 }
 
 void DropCopyPortfolio::operator()(web::socket::Client::Close const &) {
@@ -247,6 +320,9 @@ uint32_t DropCopyPortfolio::download(DropCopyPortfolioState state) {
       (*this)(ConnectionStatus::READY);
       assert(!ready_);
       ready_ = true;
+      if (group_ != nullptr) {
+        (*group_).downloaded(*this);
+      }
       return 0;
   }
   assert(false);
@@ -268,40 +344,52 @@ void DropCopyPortfolio::parse(std::string_view const &message) {
   });
 }
 
-void DropCopyPortfolio::operator()(Trace<json::OrderTradeUpdate> const &event) {
+void DropCopyPortfolio::operator()(Trace<json::FastOrderTradeUpdate> const &event) {
   profile_.order_trade_update([&]() {
     auto &[trace_info, order_trade_update] = event;
     log::info<3>("order_trade_update={}"sv, order_trade_update);
-    auto &execution_report = order_trade_update.execution_report;
-    auto external_order_id = fmt::format("{}"sv, execution_report.order_id);
-    auto liquidity = execution_report.is_trade_maker ? Liquidity::MAKER : Liquidity::TAKER;
-    // XXX HANS execution_report.execution_type ==> OrderAck ???
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::ORDER_TRADE_UPDATE,
+        .status = static_cast<uint8_t>(static_cast<json::ExecutionType::type_t>(order_trade_update.execution_type)),
+        .order_id = order_trade_update.order_id,
+        .update_time = order_trade_update.transaction_time,
+        .trade_id = order_trade_update.trade_id,
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    // note! the event must have happened before we received it
+    shared_.clock_offset.update_lower_bound(clock::get_realtime<std::chrono::nanoseconds>(), order_trade_update.event_time);
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), order_trade_update.order_id);
+    auto liquidity = order_trade_update.is_trade_maker ? Liquidity::MAKER : Liquidity::TAKER;
+    // XXX HANS order_trade_update.execution_type ==> OrderAck ???
     auto order_update = server::oms::OrderUpdate{
         .account = account_.name,
         .exchange = shared_.settings.exchange,
-        .symbol = execution_report.symbol,
-        .side = map(execution_report.side),
+        .symbol = order_trade_update.symbol,
+        .side = map(order_trade_update.side),
         .position_effect = {},
         .margin_mode = MarginMode::PORTFOLIO,
         .max_show_quantity = NaN,
-        .order_type = map(execution_report.order_type),
-        .time_in_force = map(execution_report.time_in_force),
+        .order_type = map(order_trade_update.order_type),
+        .time_in_force = map(order_trade_update.time_in_force),
         .execution_instructions = {},
         .create_time_utc = {},
         .update_time_utc = order_trade_update.transaction_time,
         .external_account = {},
         .external_order_id = external_order_id,
-        .client_order_id = execution_report.client_order_id,
-        .order_status = map(execution_report.order_status),
-        .quantity = execution_report.original_quantity,
-        .price = execution_report.original_price,
-        .stop_price = execution_report.stop_price,
+        .client_order_id = order_trade_update.client_order_id,
+        .order_status = map(order_trade_update.order_status),
+        .quantity = order_trade_update.original_quantity,
+        .price = order_trade_update.original_price,
+        .stop_price = order_trade_update.stop_price,
         .leverage = NaN,
         .remaining_quantity = NaN,
-        .traded_quantity = execution_report.order_filled_accumulated_quantity,
-        .average_traded_price = execution_report.average_price,
-        .last_traded_quantity = execution_report.last_filled_quantity,
-        .last_traded_price = execution_report.last_filled_price,
+        .traded_quantity = order_trade_update.order_filled_accumulated_quantity,
+        .average_traded_price = order_trade_update.average_price,
+        .last_traded_quantity = order_trade_update.last_filled_quantity,
+        .last_traded_price = order_trade_update.last_filled_price,
         .last_liquidity = liquidity,
         .routing_id = {},
         .max_request_version = {},
@@ -310,49 +398,76 @@ void DropCopyPortfolio::operator()(Trace<json::OrderTradeUpdate> const &event) {
         .update_type = UpdateType::INCREMENTAL,
         .sending_time_utc = order_trade_update.event_time,
     };
+    // note! a redundant order update is dropped but the fill must still be published
+    auto redundant = !shared_.check_order_update(order_update, order_trade_update.order_id);
+    if (redundant && order_trade_update.execution_type != json::ExecutionType::TRADE) {
+      log::info<3>("Drop order update (redundant or out of order): order_trade_update={}"sv, order_trade_update);
+      return;
+    }
+    // note! the fill may already have been published from TRADE_LITE (the order update must then not repeat it)
+    auto duplicate_trade = order_trade_update.execution_type == json::ExecutionType::TRADE && shared_.settings.ws.trade_lite &&
+                           !is_new_trade(order_trade_update.order_id, order_trade_update.trade_id);
+    if (duplicate_trade) {
+      order_update.last_traded_quantity = NaN;
+      order_update.last_traded_price = NaN;
+      order_update.last_liquidity = {};
+    }
     auto user_id = SOURCE_NONE;
     auto order_id = ORDER_ID_NONE;
     auto strategy_id = STRATEGY_ID_NONE;
-    if (shared_.update_order(execution_report.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
-          user_id = order.user_id;
-          order_id = order.order_id;
-          strategy_id = order.strategy_id;
-        })) {
+    // note! the order update is forwarded if the routing is not yet known
+    if (auto route = redundant ? shared_.find_order_route(order_update, order_trade_update.order_id) : nullptr; route) {
+      log::info<3>("Drop order update (redundant or out of order): order_trade_update={}"sv, order_trade_update);
+      user_id = (*route).user_id;
+      order_id = (*route).order_id;
+      strategy_id = (*route).strategy_id;
+    } else if (shared_.update_order(order_trade_update.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
+                 user_id = order.user_id;
+                 order_id = order.order_id;
+                 strategy_id = order.strategy_id;
+               })) {
+      shared_.set_order_route(order_update, order_trade_update.order_id, {.user_id = user_id, .order_id = order_id, .strategy_id = strategy_id});
     } else {
-      log::warn<2>("DEBUG: execution_report={}"sv, execution_report);
+      log::warn<2>("DEBUG: order_trade_update={}"sv, order_trade_update);
     }
-    if (execution_report.execution_type != json::ExecutionType::TRADE) {
+    update_order_latency(order_trade_update.execution_type, user_id, order_id);
+    if (order_trade_update.execution_type != json::ExecutionType::TRADE) {
       return;
     }
-    auto side = map(execution_report.side).template get<Side>();
-    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, execution_report.symbol);
+    request_balance_refresh();
+    if (duplicate_trade) {
+      ++counter_.duplicate_trade;
+      return;
+    }
+    auto side = map(order_trade_update.side).template get<Side>();
+    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, order_trade_update.symbol);
     auto profit_loss_amount =
-        utils::compute_profit_loss_amount(side, execution_report.last_filled_quantity, execution_report.last_filled_price, ref_data.multiplier);
+        utils::compute_profit_loss_amount(side, order_trade_update.last_filled_quantity, order_trade_update.last_filled_price, ref_data.multiplier);
     auto fill = Fill{
-        .exchange_time_utc = execution_report.order_trade_time,
+        .exchange_time_utc = order_trade_update.order_trade_time,
         .external_trade_id = {},
-        .quantity = execution_report.last_filled_quantity,
-        .price = execution_report.last_filled_price,
+        .quantity = order_trade_update.last_filled_quantity,
+        .price = order_trade_update.last_filled_price,
         .liquidity = liquidity,
-        .commission_amount = execution_report.commission,
-        .commission_currency = execution_report.commission_asset,
+        .commission_amount = order_trade_update.commission,
+        .commission_currency = order_trade_update.commission_asset,
         .base_amount = NaN,
         .quote_amount = NaN,
         .profit_loss_amount = profit_loss_amount,
     };
-    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, execution_report.trade_id);
+    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, order_trade_update.trade_id);
     auto trade_update = TradeUpdate{
         .stream_id = stream_id_,
         .account = account_.name,
         .order_id = order_id,
         .exchange = shared_.settings.exchange,
-        .symbol = execution_report.symbol,
+        .symbol = order_trade_update.symbol,
         .side = side,
         .position_effect = {},
         .margin_mode = MarginMode::PORTFOLIO,
         .quantity_type = {},
-        .create_time_utc = execution_report.order_trade_time,
-        .update_time_utc = execution_report.order_trade_time,
+        .create_time_utc = order_trade_update.order_trade_time,
+        .update_time_utc = order_trade_update.order_trade_time,
         .external_account = {},
         .external_order_id = external_order_id,
         .client_order_id = {},
@@ -363,7 +478,7 @@ void DropCopyPortfolio::operator()(Trace<json::OrderTradeUpdate> const &event) {
         .user = {},
         .strategy_id = strategy_id,
     };
-    create_trace_and_dispatch(handler_, trace_info, trade_update, true, user_id, execution_report.client_order_id);
+    create_trace_and_dispatch(handler_, trace_info, trade_update, true, user_id, order_trade_update.client_order_id);
   });
 }
 
@@ -371,7 +486,20 @@ void DropCopyPortfolio::operator()(Trace<json::AccountUpdate> const &event) {
   profile_.account_update([&]() {
     auto &[trace_info, account_update] = event;
     log::info<2>("account_update={}"sv, account_update);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::ACCOUNT_UPDATE,
+        .status = {},
+        .order_id = {},
+        .update_time = account_update.transaction_time,
+        .trade_id = get_fingerprint(account_update),
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    funds_updates_.clear();
+    position_updates_.clear();
     log::warn("DEBUG account_update={}"sv, account_update);
+    request_balance_refresh();
     if (!shared_.settings.misc.test_alt_funds_update) {
       for (auto &item : account_update.data.balances) {
         log::info<2>("item={}"sv, item);
@@ -388,7 +516,7 @@ void DropCopyPortfolio::operator()(Trace<json::AccountUpdate> const &event) {
             .exchange_time_utc = account_update.transaction_time,
             .sending_time_utc = account_update.event_time,
         };
-        create_trace_and_dispatch(handler_, trace_info, funds_update, true);
+        add_funds_update(funds_update);
         if (!std::isnan(item.cross_wallet_balance)) {
           auto funds_update = FundsUpdate{
               .stream_id = stream_id_,
@@ -403,7 +531,7 @@ void DropCopyPortfolio::operator()(Trace<json::AccountUpdate> const &event) {
               .exchange_time_utc = account_update.transaction_time,
               .sending_time_utc = account_update.event_time,
           };
-          create_trace_and_dispatch(handler_, trace_info, funds_update, true);
+          add_funds_update(funds_update);
         }
       }
     }
@@ -427,7 +555,16 @@ void DropCopyPortfolio::operator()(Trace<json::AccountUpdate> const &event) {
           .exchange_time_utc = account_update.transaction_time,
           .sending_time_utc = account_update.event_time,
       };
-      create_trace_and_dispatch(handler_, trace_info, position_update, true);
+      add_position_update(position_update);
+    }
+    // note! batched, is_last is only set for the final update
+    auto size = std::size(funds_updates_) + std::size(position_updates_);
+    size_t index = 0;
+    for (auto &funds_update : funds_updates_) {
+      create_trace_and_dispatch(handler_, trace_info, funds_update, ++index == size);
+    }
+    for (auto &position_update : position_updates_) {
+      create_trace_and_dispatch(handler_, trace_info, position_update, ++index == size);
     }
   });
 }
@@ -460,11 +597,119 @@ void DropCopyPortfolio::operator()(Trace<json::AccountConfigUpdate> const &event
   });
 }
 
-void DropCopyPortfolio::operator()(Trace<json::TradeLite> const &event) {
+void DropCopyPortfolio::operator()(Trace<json::FastTradeLite> const &event) {
   profile_.trade_lite([&]() {
     auto &[trace_info, trade_lite] = event;
-    log::info<2>("trade_lite={}"sv, trade_lite);
-    log::warn("DEBUG trade_lite={}"sv, trade_lite);
+    log::info<3>("trade_lite={}"sv, trade_lite);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::TRADE_LITE,
+        .status = {},
+        .order_id = trade_lite.order_id,
+        .update_time = trade_lite.transaction_time,
+        .trade_id = trade_lite.trade_id,
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    request_balance_refresh();
+    if (!shared_.settings.ws.trade_lite) {
+      return;
+    }
+    // note! the trade may already have been published from ORDER_TRADE_UPDATE
+    if (!is_new_trade(trade_lite.order_id, trade_lite.trade_id)) {
+      ++counter_.duplicate_trade;
+      return;
+    }
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), trade_lite.order_id);
+    auto liquidity = trade_lite.maker ? Liquidity::MAKER : Liquidity::TAKER;
+    // note! provisional (order status and accumulated quantities are only known when ORDER_TRADE_UPDATE is received)
+    auto order_update = server::oms::OrderUpdate{
+        .account = account_.name,
+        .exchange = shared_.settings.exchange,
+        .symbol = trade_lite.symbol,
+        .side = map(trade_lite.side),
+        .position_effect = {},
+        .margin_mode = {},
+        .max_show_quantity = NaN,
+        .order_type = {},
+        .time_in_force = {},
+        .execution_instructions = {},
+        .create_time_utc = {},
+        .update_time_utc = trade_lite.transaction_time,
+        .external_account = {},
+        .external_order_id = external_order_id,
+        .client_order_id = trade_lite.client_order_id,
+        .order_status = {},
+        .quantity = NaN,
+        .price = NaN,
+        .stop_price = NaN,
+        .leverage = NaN,
+        .remaining_quantity = NaN,
+        .traded_quantity = NaN,
+        .average_traded_price = NaN,
+        .last_traded_quantity = trade_lite.last_filled_quantity,
+        .last_traded_price = trade_lite.last_filled_price,
+        .last_liquidity = liquidity,
+        .routing_id = {},
+        .max_request_version = {},
+        .max_response_version = {},
+        .max_accepted_version = {},
+        .update_type = UpdateType::INCREMENTAL,
+        .sending_time_utc = trade_lite.event_time,
+    };
+    auto user_id = SOURCE_NONE;
+    auto order_id = ORDER_ID_NONE;
+    auto strategy_id = STRATEGY_ID_NONE;
+    if (!shared_.update_order(trade_lite.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
+          user_id = order.user_id;
+          order_id = order.order_id;
+          strategy_id = order.strategy_id;
+        })) {
+      log::warn("*** EXTERNAL ORDER ***"sv);
+      log::warn("trade_lite={}"sv, trade_lite);
+    }
+    update_order_latency(json::ExecutionType::TRADE, user_id, order_id);
+    auto side = map(trade_lite.side).template get<Side>();
+    auto ref_data = shared_.get_ref_data(shared_.settings.exchange, trade_lite.symbol);
+    auto profit_loss_amount = utils::compute_profit_loss_amount(side, trade_lite.last_filled_quantity, trade_lite.last_filled_price, ref_data.multiplier);
+    // note! commission is not available
+    auto fill = Fill{
+        .exchange_time_utc = trade_lite.transaction_time,
+        .external_trade_id = {},
+        .quantity = trade_lite.last_filled_quantity,
+        .price = trade_lite.last_filled_price,
+        .liquidity = liquidity,
+        .commission_amount = NaN,
+        .commission_currency = {},
+        .base_amount = NaN,
+        .quote_amount = NaN,
+        .profit_loss_amount = profit_loss_amount,
+    };
+    fmt::format_to(std::back_inserter(fill.external_trade_id), "{}"sv, trade_lite.trade_id);
+    auto trade_update = TradeUpdate{
+        .stream_id = stream_id_,
+        .account = account_.name,
+        .order_id = order_id,
+        .exchange = shared_.settings.exchange,
+        .symbol = trade_lite.symbol,
+        .side = side,
+        .position_effect = {},
+        .margin_mode = {},
+        .quantity_type = {},
+        .create_time_utc = trade_lite.transaction_time,
+        .update_time_utc = trade_lite.transaction_time,
+        .external_account = {},
+        .external_order_id = external_order_id,
+        .client_order_id = {},
+        .fills = {&fill, 1},
+        .routing_id = {},
+        .update_type = UpdateType::INCREMENTAL,
+        .sending_time_utc = trade_lite.event_time,
+        .user = {},
+        .strategy_id = strategy_id,
+    };
+    create_trace_and_dispatch(handler_, trace_info, trade_update, true, user_id, trade_lite.client_order_id);
   });
 }
 
@@ -472,7 +717,18 @@ void DropCopyPortfolio::operator()(Trace<json::ExecutionReport2> const &event) {
   profile_.execution_report([&]() {
     auto &[trace_info, execution_report] = event;
     log::info<2>("execution_report={}"sv, execution_report);
-    auto external_order_id = fmt::format("{}"sv, execution_report.order_id);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::EXECUTION_REPORT,
+        .status = static_cast<uint8_t>(static_cast<json::ExecutionType::type_t>(execution_report.execution_type)),
+        .order_id = execution_report.order_id,
+        .update_time = execution_report.transaction_time,
+        .trade_id = execution_report.trade_id,
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), execution_report.order_id);
     auto liquidity = execution_report.is_trade_maker ? Liquidity::MAKER : Liquidity::TAKER;
     // XXX HANS execution_report.execution_type ==> OrderAck ???
     auto order_update = server::oms::OrderUpdate{
@@ -509,20 +765,35 @@ void DropCopyPortfolio::operator()(Trace<json::ExecutionReport2> const &event) {
         .update_type = UpdateType::INCREMENTAL,
         .sending_time_utc = execution_report.event_time,
     };
+    // note! a redundant order update is dropped but the fill must still be published
+    auto redundant = !shared_.check_order_update(order_update, execution_report.order_id);
+    if (redundant && execution_report.execution_type != json::ExecutionType::TRADE) {
+      log::info<3>("Drop order update (redundant or out of order): execution_report={}"sv, execution_report);
+      return;
+    }
     auto user_id = SOURCE_NONE;
     auto order_id = ORDER_ID_NONE;
     auto strategy_id = STRATEGY_ID_NONE;
-    if (shared_.update_order(execution_report.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
-          user_id = order.user_id;
-          order_id = order.order_id;
-          strategy_id = order.strategy_id;
-        })) {
+    // note! the order update is forwarded if the routing is not yet known
+    if (auto route = redundant ? shared_.find_order_route(order_update, execution_report.order_id) : nullptr; route) {
+      log::info<3>("Drop order update (redundant or out of order): execution_report={}"sv, execution_report);
+      user_id = (*route).user_id;
+      order_id = (*route).order_id;
+      strategy_id = (*route).strategy_id;
+    } else if (shared_.update_order(execution_report.client_order_id, stream_id_, trace_info, order_update, [&](auto &order) {
+                 user_id = order.user_id;
+                 order_id = order.order_id;
+                 strategy_id = order.strategy_id;
+               })) {
+      shared_.set_order_route(order_update, execution_report.order_id, {.user_id = user_id, .order_id = order_id, .strategy_id = strategy_id});
     } else {
       log::warn<2>("DEBUG: execution_report={}"sv, execution_report);
     }
+    update_order_latency(execution_report.execution_type, user_id, order_id);
     if (execution_report.execution_type != json::ExecutionType::TRADE) {
       return;
     }
+    request_balance_refresh();
     auto side = map(execution_report.side).template get<Side>();
     auto ref_data = shared_.get_ref_data(shared_.settings.exchange, execution_report.symbol);
     auto profit_loss_amount =
@@ -571,6 +842,7 @@ void DropCopyPortfolio::operator()(Trace<json::BalanceUpdate> const &event) {
     auto &[trace_info, balance_update] = event;
     log::info<2>("balance_update={}"sv, balance_update);
     log::warn("DEBUG balance_update={}"sv, balance_update);
+    request_balance_refresh();
   });
 }
 
@@ -579,6 +851,7 @@ void DropCopyPortfolio::operator()(Trace<json::LiabilityChange> const &event) {
     auto &[trace_info, liability_change] = event;
     log::info<2>("liability_change={}"sv, liability_change);
     log::warn("DEBUG liability_change={}"sv, liability_change);
+    request_balance_refresh();
   });
 }
 
@@ -586,6 +859,16 @@ void DropCopyPortfolio::operator()(Trace<json::OutboundAccountPosition> const &e
   profile_.outbound_account_position([&]() {
     auto &[trace_info, outbound_account_position] = event;
     log::info<2>("outbound_account_position={}"sv, outbound_account_position);
+    auto key = tools::UserStreamEvent{
+        .type = tools::UserStreamEvent::Type::OUTBOUND_ACCOUNT_POSITION,
+        .status = {},
+        .order_id = {},
+        .update_time = outbound_account_position.event_time,
+        .trade_id = {},
+    };
+    if (!is_first_arrival(key)) {
+      return;
+    }
     log::warn("DEBUG outbound_account_position={}"sv, outbound_account_position);
     if (shared_.settings.misc.test_alt_funds_update) {
       for (auto &item : outbound_account_position.balances) {
@@ -609,6 +892,85 @@ void DropCopyPortfolio::operator()(Trace<json::OutboundAccountPosition> const &e
   });
 }
 
+// note! skips incremental updates when nothing has changed (e.g. the same balance reported for every fill)
+void DropCopyPortfolio::add_funds_update(FundsUpdate const &funds_update) {
+  if (!request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold)) {
+    ++counter_.unchanged;
+    return;
+  }
+  funds_updates_.emplace_back(funds_update);
+}
+
+void DropCopyPortfolio::add_position_update(PositionUpdate const &position_update) {
+  if (!request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity)) {
+    ++counter_.unchanged;
+    return;
+  }
+  position_updates_.emplace_back(position_update);
+}
+
+// note! balances are refreshed by order entry, coalesced from the first event
+void DropCopyPortfolio::request_balance_refresh() {
+  if (request_.balance_changed.count() == 0) {
+    request_.balance_changed = clock::get_system();
+  }
+}
+
+// note! redundant connections deliver the same events, the counters can be used to compute a win-rate per connection
+bool DropCopyPortfolio::is_first_arrival(tools::UserStreamEvent const &key) {
+  if (first_arrival_ == nullptr) {
+    return true;
+  }
+  if ((*first_arrival_)(key)) {
+    ++counter_.first_arrival;
+    return true;
+  }
+  ++counter_.late_arrival;
+  return false;
+}
+
+// note! the trade cache must be shared when the trade can be reported by different connections
+bool DropCopyPortfolio::is_new_trade(int64_t order_id, int64_t trade_id) {
+  auto key = tools::UserStreamEvent{
+      .type = tools::UserStreamEvent::Type::TRADE,
+      .status = {},
+      .order_id = order_id,
+      .update_time = {},
+      .trade_id = trade_id,
+  };
+  if (first_arrival_ == nullptr) {
+    return trade_cache_(key);
+  }
+  return (*first_arrival_)(key);
+}
+
+// note! wall-clock latency measured from when the order request was sent
+void DropCopyPortfolio::update_order_latency(json::ExecutionType execution_type, uint8_t user_id, uint64_t order_id) {
+  if (user_id == SOURCE_NONE) {
+    return;
+  }
+  auto key = tools::OrderLatency::Key{
+      .user_id = user_id,
+      .order_id = order_id,
+  };
+  auto now = clock::get_system();
+  switch (execution_type) {
+    using enum json::ExecutionType::type_t;
+    case NEW:
+      if (auto sample = shared_.order_latency.new_order(key, now); sample.count() > 0) {
+        latency_.order_new.update(sample);
+      }
+      break;
+    case TRADE:
+      if (auto sample = shared_.order_latency.first_fill(key, now); sample.count() > 0) {
+        latency_.order_fill.update(sample);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 // request
 
 void DropCopyPortfolio::request_balance() {
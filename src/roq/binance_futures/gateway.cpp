@@ -3,6 +3,7 @@
 #include "roq/binance_futures/gateway.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <limits>
 
@@ -19,26 +20,37 @@ using namespace std::literals;
 namespace roq {
 namespace binance_futures {
 
+// === CONSTANTS ===
+
+namespace {
+size_t const MAX_USER_STREAM_EVENTS = 4096;  // note! per account (only used with redundant user stream connections)
+}  // namespace
+
 // === HELPERS ===
 
 namespace {
 template <typename R>
-R create_accounts(auto &config) {
+R create_accounts(auto &settings, auto &config, auto &clock_offset) {
   using result_type = std::remove_cvref_t<R>;
   result_type result;
   for (auto &[_, account] : config.accounts) {
-    auto obj = std::make_unique<Account>(config, account.name, account.margin_mode);
+    auto obj = std::make_unique<Account>(settings, config, account.name, account.margin_mode, clock_offset);
     result.try_emplace(static_cast<std::string_view>(account.name), std::move(obj));
   }
   return result;
 }
 
 template <typename R>
-R create_requests(auto &config) {
+R create_requests(auto &settings, auto &config) {
   using result_type = std::remove_cvref_t<R>;
   result_type result;
   for (auto &[_, account] : config.accounts) {
-    result.try_emplace(static_cast<std::string_view>(account.name), Request{});
+    auto iter = result.try_emplace(static_cast<std::string_view>(account.name), Request{}).first;
+    auto &trades_cursor_dir = settings.rest.trades_cursor_dir;
+    if (!std::empty(trades_cursor_dir)) {
+      auto path = fmt::format("{}/{}.trades"sv, trades_cursor_dir, account.name);
+      (*iter).second.trade_cursor.load(path);
+    }
   }
   return result;
 }
@@ -56,7 +68,7 @@ R create_order_entry(auto &gateway, auto &context, auto &stream_id, auto &accoun
       case ISOLATED:
       case CROSS:
         if (shared.settings.ws_api) {
-          auto obj = std::make_unique<WebSocket>(gateway, context, ++stream_id, account, shared, request);
+          auto obj = std::make_unique<OrderRouter>(gateway, context, stream_id, account, shared, request);
           result.try_emplace(account.name, std::move(obj));
         } else {
           auto obj = std::make_unique<OrderEntryClassic>(gateway, context, ++stream_id, account, shared, request);
@@ -114,8 +126,9 @@ R create_download(auto &gateway, auto &context, auto &stream_id, auto &accounts,
 // === IMPLEMENTATION ===
 
 Gateway::Gateway(server::Dispatcher &dispatcher, Settings const &settings, Config const &config, io::Context &context)
-    : dispatcher_{dispatcher}, accounts_{create_accounts<decltype(accounts_)>(config)}, context_{context}, shared_{dispatcher, settings},
-      requests_{create_requests<decltype(requests_)>(config)}, rest_{*this, context_, ++stream_id_, shared_},
+    : dispatcher_{dispatcher}, clock_offset_{settings.rest.clock_offset},
+      accounts_{create_accounts<decltype(accounts_)>(settings, config, clock_offset_)}, context_{context}, shared_{dispatcher, settings, clock_offset_},
+      requests_{create_requests<decltype(requests_)>(settings, config)}, rest_{*this, context_, ++stream_id_, shared_},
       order_entry_{create_order_entry<decltype(order_entry_)>(*this, context_, stream_id_, accounts_, shared_, requests_)},
       drop_copy_{create_drop_copy<decltype(drop_copy_)>(accounts_)},
       download_{create_download<decltype(download_)>(*this, context_, stream_id_, accounts_, shared_, requests_)} {
@@ -137,7 +150,7 @@ void Gateway::operator()(Event<Stop> const &event) {
 }
 
 void Gateway::operator()(Event<Timer> const &event) {
-  dispatch(event);
+  shared_.timer_wheel.refresh(event.value.now);
 }
 
 void Gateway::operator()(Event<Control> const &event) {
@@ -186,8 +199,26 @@ void Gateway::operator()(Trace<TopOfBook> const &event, bool is_last) {
   dispatcher_(event, is_last);
 }
 
+// note! the depth also updates the pre-trade reference prices (book ticker may not be available)
 void Gateway::operator()(Trace<MarketByPriceUpdate> const &event, bool is_last) {
-  auto callback = []([[maybe_unused]] auto &market_by_price) {};
+  auto callback = [&](auto &market_by_price) {
+    if (!shared_.settings.risk.enable) {
+      return;
+    }
+    auto &[trace_info, market_by_price_update] = event;
+    auto instrument = shared_.find_instrument(market_by_price_update.symbol);
+    if (!instrument) {
+      return;
+    }
+    std::array<Layer, 1> layers;
+    auto result = market_by_price.extract(layers);
+    if (std::empty(result)) {
+      (*instrument).pre_trade.clear();
+      return;
+    }
+    auto &layer = result[0];
+    (*instrument).pre_trade.update(layer.bid_price, layer.ask_price, market_by_price_update.exchange_sequence);
+  };
   dispatcher_(event, is_last, bids_, asks_, callback);
 }
 
@@ -252,6 +283,28 @@ void Gateway::operator()(WebSocket::ListenKeyUpdate const &listen_key_update) {
   create_drop_copy_helper<DropCopyClassic>(listen_key_update);
 }
 
+void Gateway::operator()(WebSocket::UserStreamUpdate const &user_stream_update) {
+  auto &account = user_stream_update.account;
+  // note! an empty listen key attaches the drop-copy to the ws-api session
+  auto listen_key_update = WebSocket::ListenKeyUpdate{
+      .account = account,
+      .listen_key = {},
+  };
+  create_drop_copy_helper<DropCopyClassic>(listen_key_update);
+  auto iter = drop_copy_.find(account);
+  assert(iter != std::end(drop_copy_));
+  (*(*iter).second).set_ready(user_stream_update.ready);
+}
+
+void Gateway::operator()(WebSocket::UserStreamEvent const &user_stream_event) {
+  auto iter = drop_copy_.find(user_stream_event.account);
+  if (iter == std::end(drop_copy_) || !static_cast<bool>((*iter).second)) {
+    log::warn(R"(Unexpected: account="{}")"sv, user_stream_event.account);
+    return;
+  }
+  (*(*iter).second).parse(user_stream_event.message);
+}
+
 void Gateway::operator()(OrderEntryClassic::ListenKeyUpdate const &listen_key_update) {
   create_drop_copy_helper<DropCopyClassic>(listen_key_update);
 }
@@ -268,8 +321,25 @@ void Gateway::create_drop_copy_helper(auto &listen_key_update) {
   if (iter == std::end(drop_copy_)) {
     log::fatal(R"(Unexpected: account="{}")"sv, account);
   } else if (!static_cast<bool>((*iter).second)) {
-    log::info(R"(Create DropCopy (user-stream) for account="{}")"sv, account);
-    auto drop_copy = std::make_unique<T>(*this, context_, ++stream_id_, get_account(account), shared_, get_request(account), listen_key_update.listen_key);
+    auto &listen_key = listen_key_update.listen_key;
+    auto &network_interfaces = shared_.settings.ws.user_stream_network_interfaces;
+    auto get_interface = [&](size_t index) {
+      return std::empty(network_interfaces) ? std::string_view{} : std::string_view{network_interfaces[index % std::size(network_interfaces)]};
+    };
+    // note! the user stream can not be redundant when it is received by the ws-api session
+    auto size = std::empty(listen_key) ? size_t{1} : std::max<size_t>(shared_.settings.ws.user_stream_connections, 1);
+    log::info(R"(Create DropCopy (user-stream) for account="{}", connections={})"sv, account, size);
+    std::unique_ptr<DropCopy> drop_copy;
+    if (size == 1) {
+      drop_copy = std::make_unique<T>(*this, context_, ++stream_id_, get_account(account), shared_, get_request(account), listen_key, get_interface(0));
+    } else {
+      auto group = std::make_unique<DropCopyGroup>(MAX_USER_STREAM_EVENTS);
+      for (size_t i = 0; i < size; ++i) {
+        (*group).add(std::make_unique<T>(
+            *this, context_, ++stream_id_, get_account(account), shared_, get_request(account), listen_key, get_interface(i), group.get()));
+      }
+      drop_copy = std::move(group);
+    }
     MessageInfo message_info;
     Start start;
     create_event_and_dispatch(*drop_copy, message_info, start);
@@ -280,7 +350,14 @@ void Gateway::create_drop_copy_helper(auto &listen_key_update) {
 uint16_t Gateway::operator()(Event<CreateOrder> const &event, server::oms::Order const &order, std::string_view const &request_id) {
   auto &create_order = event.value;
   assert(!std::empty(create_order.account));
-  return get_order_entry(create_order.account)(event, order, request_id);
+  if (!shared_.client_order_id_filter(request_id)) [[unlikely]] {
+    log::warn(R"(Client order ids have variable length, external orders can not be classified: request_id="{}")"sv, request_id);
+  }
+  check_pre_trade(create_order);
+  check_order_rate_limit(create_order.account);
+  auto stream_id = get_order_entry(create_order.account)(event, order, request_id);
+  consume_order_rate_limit(create_order.account);
+  return stream_id;
 }
 
 uint16_t Gateway::operator()(
@@ -288,7 +365,10 @@ uint16_t Gateway::operator()(
   auto &modify_order = event.value;
   assert(!std::empty(modify_order.account));
   assert(modify_order.account == order.account);
-  return get_order_entry(modify_order.account)(event, order, request_id, previous_request_id);
+  check_order_rate_limit(modify_order.account);
+  auto stream_id = get_order_entry(modify_order.account)(event, order, request_id, previous_request_id);
+  consume_order_rate_limit(modify_order.account);
+  return stream_id;
 }
 
 uint16_t Gateway::operator()(
@@ -309,12 +389,24 @@ uint16_t Gateway::operator()(Event<CancelAllOrders> const &event, std::string_vi
   }
 }
 
-uint16_t Gateway::operator()(Event<MassQuote> const &) {
-  throw server::oms::NotSupported{"not supported"sv};
+uint16_t Gateway::operator()(Event<MassQuote> const &event) {
+  auto &mass_quote = event.value;
+  assert(!std::empty(mass_quote.account));
+  // note! each leg is an order (cancels are not throttled)
+  uint32_t count = {};
+  for (auto &quote : mass_quote.quotes) {
+    count += static_cast<uint32_t>(std::size(quote.bids) + std::size(quote.asks));
+  }
+  check_order_rate_limit(mass_quote.account, count);
+  auto stream_id = get_order_entry(mass_quote.account)(event);
+  consume_order_rate_limit(mass_quote.account, count);
+  return stream_id;
 }
 
-uint16_t Gateway::operator()(Event<CancelQuotes> const &) {
-  throw server::oms::NotSupported{"not supported"sv};
+uint16_t Gateway::operator()(Event<CancelQuotes> const &event) {
+  auto &cancel_quotes = event.value;
+  assert(!std::empty(cancel_quotes.account));
+  return get_order_entry(cancel_quotes.account)(event);
 }
 
 void Gateway::operator()(metrics::Writer &writer) const {
@@ -373,6 +465,58 @@ OrderEntry &Gateway::get_order_entry(std::string_view const &account) {
   throw RuntimeError{R"(Unknown account="{}")"sv, account};
 }
 
+// note! cancels are never throttled
+// note! tokens are only consumed once the request has been routed (e.g. not if the connection is not ready)
+
+void Gateway::check_order_rate_limit(std::string_view const &account, uint32_t count) {
+  auto now = clock::get_system();
+  if (!get_account(account).governor.check(now, count)) [[unlikely]] {
+    throw server::oms::Rejected{Origin::GATEWAY, Error::REQUEST_RATE_LIMIT_REACHED, "Order rate limit (client-side)"sv};
+  }
+}
+
+void Gateway::consume_order_rate_limit(std::string_view const &account, uint32_t count) {
+  get_account(account).governor.consume(count);
+}
+
+// note! rejects locally what the exchange would otherwise reject (and without using any of the rate-limit budget)
+
+void Gateway::check_pre_trade(CreateOrder const &create_order) {
+  if (!shared_.settings.risk.enable) {
+    return;
+  }
+  // note! instruments are created when reference data is downloaded (never from the order path)
+  auto instrument = shared_.find_instrument(create_order.symbol);
+  if (!instrument) [[unlikely]] {
+    throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Unknown symbol (pre-trade)"sv};
+  }
+  auto order = tools::PreTrade::Order{
+      .buy = create_order.side == Side::BUY,
+      .market = create_order.order_type == OrderType::MARKET,
+      .reduce_only = create_order.position_effect == PositionEffect::CLOSE || create_order.execution_instructions.has(ExecutionInstruction::DO_NOT_INCREASE),
+      .quantity = create_order.quantity,
+      .price = create_order.price,
+  };
+  // note! MAX_NUM_ORDERS is per account
+  switch ((*instrument).pre_trade.check(order, (*instrument).get_working_orders(create_order.account))) {
+    using enum tools::PreTrade::Result;
+    case OK:
+      break;
+    case MAX_QUANTITY:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Quantity exceeds maximum (pre-trade)"sv};
+    case MIN_NOTIONAL:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Notional below minimum (pre-trade)"sv};
+    case MAX_NOTIONAL:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Notional exceeds maximum (pre-trade)"sv};
+    case PRICE_BAND:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Price outside band (pre-trade)"sv};
+    case MAX_OPEN_ORDERS:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Too many open orders (pre-trade)"sv};
+    case NO_REFERENCE_PRICE:
+      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "No top of book for market order (pre-trade)"sv};
+  }
+}
+
 RestTrade &Gateway::get_rest_trade(std::string_view const &account) {
   auto iter = download_.find(account);
   if (iter != std::end(download_)) {
@@ -16,10 +16,12 @@
 #include "roq/binance_futures/account.hpp"
 #include "roq/binance_futures/config.hpp"
 #include "roq/binance_futures/drop_copy_classic.hpp"
+#include "roq/binance_futures/drop_copy_group.hpp"
 #include "roq/binance_futures/drop_copy_portfolio.hpp"
 #include "roq/binance_futures/market_data.hpp"
 #include "roq/binance_futures/order_entry_classic.hpp"
 #include "roq/binance_futures/order_entry_portfolio.hpp"
+#include "roq/binance_futures/order_router.hpp"
 #include "roq/binance_futures/request.hpp"
 #include "roq/binance_futures/rest.hpp"
 #include "roq/binance_futures/rest_trade.hpp"
@@ -86,6 +88,8 @@ struct Gateway final : public server::Handler,
   void ensure_symbol_slices(size_t size);
 
   void operator()(WebSocket::ListenKeyUpdate const &) override;
+  void operator()(WebSocket::UserStreamUpdate const &) override;
+  void operator()(WebSocket::UserStreamEvent const &) override;
   void operator()(OrderEntryClassic::ListenKeyUpdate const &) override;
   void operator()(OrderEntryPortfolio::ListenKeyUpdate const &) override;
 
@@ -105,8 +109,14 @@ struct Gateway final : public server::Handler,
   OrderEntry &get_order_entry(std::string_view const &account);
   RestTrade &get_rest_trade(std::string_view const &account);
 
+  void check_order_rate_limit(std::string_view const &account, uint32_t count = 1);
+  void consume_order_rate_limit(std::string_view const &account, uint32_t count = 1);
+  void check_pre_trade(CreateOrder const &);
+
  private:
   server::Dispatcher &dispatcher_;
+  // clock
+  tools::ClockOffset clock_offset_;
   // authentication
   utils::unordered_map<std::string, std::unique_ptr<Account>> const accounts_;
   // io
@@ -2,6 +2,9 @@
 
 #include "roq/binance_futures/json/encoder.hpp"
 
+#include <array>
+#include <span>
+
 #include "roq/logging.hpp"
 
 #include "roq/decimal.hpp"
@@ -12,14 +15,47 @@
 
 #include "roq/binance_futures/json/map.hpp"
 
-#define WS_USE_FMT
-
 using namespace std::literals;
 
 namespace roq {
 namespace binance_futures {
 namespace json {
 
+// === CONSTANTS ===
+
+namespace {
+// note! large enough for any request we send (including batches)
+size_t const MAX_MESSAGE_LENGTH = 4096;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+// note! writes straight into the (pre-sized) buffer, no format string parsing and no back-inserter
+template <typename Callback>
+std::string_view encode(std::vector<char> &buffer, Callback callback) {
+  if (std::size(buffer) < MAX_MESSAGE_LENGTH) [[unlikely]] {
+    buffer.resize(MAX_MESSAGE_LENGTH);
+  }
+  std::span buffer_2{reinterpret_cast<std::byte *>(std::data(buffer)), std::size(buffer)};
+  utils::text::Writer writer{buffer_2};
+  callback(writer);
+  return writer.finish();
+}
+
+void write_decimal(auto &writer, double value, Precision precision) {
+  std::array<char, FixedPoint::MAX_LENGTH> buffer;
+  auto result = FixedPoint::render(buffer, value, precision);
+  if (std::empty(result)) [[unlikely]] {
+    writer.write(Decimal{value, precision});
+  } else {
+    writer.write(result);
+  }
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
 // URL
 
 // user-trades
@@ -31,78 +67,60 @@ std::string_view Encoder::user_trades_url(
     std::chrono::milliseconds end_time,
     uint32_t limit,
     std::chrono::milliseconds recv_window) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(symbol={}&)"
-      R"(startTime={}&)"
-      R"(endTime={}&)"
-      R"(limit={}&)"
-      R"(recvWindow={})"sv,
-      symbol,
-      start_time.count(),
-      end_time.count(),
-      limit,
-      recv_window.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(symbol);
+    writer.write("&startTime="sv).write(start_time.count());
+    writer.write("&endTime="sv).write(end_time.count());
+    writer.write("&limit="sv).write(limit);
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
+}
+
+// note! trades are returned in ascending trade id order starting from (and including) from_id
+std::string_view Encoder::user_trades_from_id_url(
+    std::vector<char> &buffer, std::string_view const &symbol, int64_t from_id, uint32_t limit, std::chrono::milliseconds recv_window) {
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(symbol);
+    writer.write("&fromId="sv).write(from_id);
+    writer.write("&limit="sv).write(limit);
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
 }
 
 // order-place
 
 std::string_view Encoder::order_place_url(
     std::vector<char> &buffer,
+    OrderTemplates &order_templates,
     CreateOrder const &create_order,
     server::oms::Order const &order,
     std::string_view const &request_id,
     std::chrono::milliseconds recv_window) {
-  auto side = map(create_order.side).template get<Side>();
-  auto type = map(create_order.order_type).template get<OrderType>();
-  auto reduce_only = false;
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(symbol={}&)"
-      R"(side={}&)"
-      R"(type={}&)"
-      R"(quantity={}&)"
-      R"(reduceOnly={}&)"sv,
-      create_order.symbol,
-      side.as_raw_text(),
-      type.as_raw_text(),
-      Decimal{create_order.quantity, order.quantity_precision.precision},
-      reduce_only);
-  switch (create_order.order_type) {
-    using enum roq::OrderType;
-    case UNDEFINED:
-      assert(false);
-      break;
-    case MARKET:
-      assert(std::isnan(create_order.price));
-      break;
-    case LIMIT: {
-      assert(!std::isnan(create_order.price));
-      auto time_in_force = map(create_order.time_in_force).template get<TimeInForce>();
-      fmt::format_to(
-          std::back_inserter(buffer),
-          R"(timeInForce={}&)"
-          R"(price={}&)"sv,
-          time_in_force.as_raw_text(),
-          Decimal{create_order.price, order.price_precision.precision});
-      break;
+  auto &order_template = order_templates(create_order);
+  return encode(buffer, [&](auto &writer) {
+    writer.write(order_template.order_place_url).write(request_id);
+    writer.write("&quantity="sv);
+    write_decimal(writer, create_order.quantity, order.quantity_precision.precision);
+    switch (create_order.order_type) {
+      using enum roq::OrderType;
+      case UNDEFINED:
+        assert(false);
+        break;
+      case MARKET:
+        assert(std::isnan(create_order.price));
+        break;
+      case LIMIT:
+        assert(!std::isnan(create_order.price));
+        writer.write("&price="sv);
+        write_decimal(writer, create_order.price, order.price_precision.precision);
+        break;
     }
-  }
-  if (!std::isnan(create_order.stop_price)) {
-    fmt::format_to(std::back_inserter(buffer), R"(stopPrice={}&)"sv, Decimal{create_order.stop_price, order.price_precision.precision});
-  }
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(newClientOrderId={}&)"
-      R"(recvWindow={})"sv,
-      request_id,
-      recv_window.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+    if (!std::isnan(create_order.stop_price)) {
+      writer.write("&stopPrice="sv);
+      write_decimal(writer, create_order.stop_price, order.price_precision.precision);
+    }
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
 }
 
 // order-modify
@@ -115,69 +133,49 @@ std::string_view Encoder::order_modify_url(
     [[maybe_unused]] std::string_view const &previous_request_id,
     std::chrono::milliseconds recv_window,
     bool order_modify_full) {
-  buffer.clear();
   auto side = map(order.side).template get<Side>();
+  auto write_order_id = [&](auto &writer) {
+    writer.write("symbol="sv).write(order.symbol);
+    if (!std::empty(order.external_order_id)) {
+      writer.write("&orderId="sv).write(order.external_order_id);
+    }
+    writer.write("&origClientOrderId="sv).write(order.client_order_id);
+    writer.write("&side="sv).write(side.as_raw_text());
+  };
   if (order_modify_full) {  // fapi
     auto quantity = std::isnan(modify_order.quantity) ? order.quantity : modify_order.quantity;
     auto price = std::isnan(modify_order.price) ? order.price : modify_order.price;
-    fmt::format_to(std::back_inserter(buffer), R"(symbol={}&)"sv, order.symbol);
-    if (!std::empty(order.external_order_id)) {
-      fmt::format_to(std::back_inserter(buffer), R"(orderId={}&)"sv, order.external_order_id);
-    }
-    fmt::format_to(std::back_inserter(buffer), R"(origClientOrderId={}&)"sv, order.client_order_id);
-    fmt::format_to(
-        std::back_inserter(buffer),
-        R"(side={}&)"
-        R"(quantity={}&)"
-        R"(price={}&)"
-        R"(recvWindow={})"sv,
-        side.as_raw_text(),
-        Decimal{quantity, order.quantity_precision.precision},
-        Decimal{price, order.price_precision.precision},
-        recv_window.count());
-  } else {  // dapi
-    auto helper = [](auto value, auto last_value) {
-      if (!std::isnan(value) && !utils::is_equal(value, last_value)) {
-        return value;
-      }
-      return NaN;
-    };
-    auto quantity = helper(modify_order.quantity, order.quantity);
-    auto price = helper(modify_order.price, order.price);
-    if (!std::isnan(quantity) && std::isnan(price)) {
-      fmt::format_to(std::back_inserter(buffer), R"(symbol={}&)"sv, order.symbol);
-      if (!std::empty(order.external_order_id)) {
-        fmt::format_to(std::back_inserter(buffer), R"(orderId={}&)"sv, order.external_order_id);
-      }
-      fmt::format_to(std::back_inserter(buffer), R"(origClientOrderId={}&)"sv, order.client_order_id);
-      fmt::format_to(
-          std::back_inserter(buffer),
-          R"(side={}&)"
-          R"(quantity={}&)"
-          R"(recvWindow={})"sv,
-          side.as_raw_text(),
-          Decimal{modify_order.quantity, order.quantity_precision.precision},
-          recv_window.count());
-    } else if (std::isnan(quantity) && !std::isnan(price)) {
-      fmt::format_to(std::back_inserter(buffer), R"(symbol={}&)"sv, order.symbol);
-      if (!std::empty(order.external_order_id)) {
-        fmt::format_to(std::back_inserter(buffer), R"(orderId={}&)"sv, order.external_order_id);
-      }
-      fmt::format_to(std::back_inserter(buffer), R"(origClientOrderId={}&)"sv, order.client_order_id);
-      fmt::format_to(
-          std::back_inserter(buffer),
-          R"(side={}&)"
-          R"(price={}&)"
-          R"(recvWindow={})"sv,
-          side.as_raw_text(),
-          Decimal{modify_order.price, order.price_precision.precision},
-          recv_window.count());
-    } else {
-      throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Missing quantity or price"sv};
+    return encode(buffer, [&](auto &writer) {
+      write_order_id(writer);
+      writer.write("&quantity="sv).write(Decimal{quantity, order.quantity_precision.precision});
+      writer.write("&price="sv).write(Decimal{price, order.price_precision.precision});
+      writer.write("&recvWindow="sv).write(recv_window.count());
+    });
+  }
+  // dapi
+  auto helper = [](auto value, auto last_value) {
+    if (!std::isnan(value) && !utils::is_equal(value, last_value)) {
+      return value;
     }
+    return NaN;
+  };
+  auto quantity = helper(modify_order.quantity, order.quantity);
+  auto price = helper(modify_order.price, order.price);
+  if (!std::isnan(quantity) && std::isnan(price)) {
+    return encode(buffer, [&](auto &writer) {
+      write_order_id(writer);
+      writer.write("&quantity="sv).write(Decimal{modify_order.quantity, order.quantity_precision.precision});
+      writer.write("&recvWindow="sv).write(recv_window.count());
+    });
+  }
+  if (std::isnan(quantity) && !std::isnan(price)) {
+    return encode(buffer, [&](auto &writer) {
+      write_order_id(writer);
+      writer.write("&price="sv).write(Decimal{modify_order.price, order.price_precision.precision});
+      writer.write("&recvWindow="sv).write(recv_window.count());
+    });
   }
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  throw server::oms::Rejected{Origin::GATEWAY, Error::INVALID_REQUEST_ARGS, "Missing quantity or price"sv};
 }
 
 // order-cancel
@@ -189,46 +187,84 @@ std::string_view Encoder::order_cancel_url(
     [[maybe_unused]] std::string_view const &request_id,
     [[maybe_unused]] std::string_view const &previous_request_id,
     std::chrono::milliseconds recv_window) {
-  buffer.clear();
-  fmt::format_to(std::back_inserter(buffer), R"(symbol={}&)"sv, order.symbol);
-  if (!std::empty(order.external_order_id)) {
-    fmt::format_to(std::back_inserter(buffer), R"(orderId={}&)"sv, order.external_order_id);
-  }
-  fmt::format_to(std::back_inserter(buffer), R"(origClientOrderId={}&)"sv, order.client_order_id);
-  fmt::format_to(std::back_inserter(buffer), R"(recvWindow={})"sv, recv_window.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(order.symbol);
+    if (!std::empty(order.external_order_id)) {
+      writer.write("&orderId="sv).write(order.external_order_id);
+    }
+    writer.write("&origClientOrderId="sv).write(order.client_order_id);
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
 }
 
 // all-open-orders
 
 std::string_view Encoder::all_open_orders_url(std::vector<char> &buffer, std::string_view const &symbol, std::chrono::milliseconds recv_window) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(symbol={}&)"
-      R"(recvWindow={})"sv,
-      symbol,
-      recv_window.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(symbol);
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
 }
 
 // countdown
 
 std::string_view Encoder::countdown_cancel_open_orders_url(
     std::vector<char> &buffer, std::string_view const &symbol, std::chrono::milliseconds countdown_time, std::chrono::milliseconds recv_window) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(symbol={}&)"
-      R"(countdownTime={}&)"
-      R"(recvWindow={})"sv,
-      symbol,
-      countdown_time.count(),
-      recv_window.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(symbol);
+    writer.write("&countdownTime="sv).write(countdown_time.count());
+    writer.write("&recvWindow="sv).write(recv_window.count());
+  });
+}
+
+// batch-orders
+
+// note! the batch is a json list and must be url-encoded
+
+std::string_view Encoder::batch_orders_place_url(std::vector<char> &buffer, std::span<QuoteLeg const> const &legs, std::chrono::milliseconds recv_window) {
+  return encode(buffer, [&](auto &writer) {
+    writer.write("batchOrders=%5B"sv);
+    auto first = true;
+    for (auto &leg : legs) {
+      if (first) {
+        first = false;
+      } else {
+        writer.write("%2C"sv);
+      }
+      auto side = map(leg.side).template get<Side>();
+      writer.write("%7B%22symbol%22%3A%22"sv).write(leg.symbol);
+      writer.write("%22%2C%22side%22%3A%22"sv).write(side.as_raw_text());
+      writer.write("%22%2C%22type%22%3A%22LIMIT%22%2C%22timeInForce%22%3A%22GTC"sv);
+      writer.write("%22%2C%22quantity%22%3A%22"sv);
+      write_decimal(writer, leg.quantity, leg.quantity_precision);
+      writer.write("%22%2C%22price%22%3A%22"sv);
+      write_decimal(writer, leg.price, leg.price_precision);
+      writer.write("%22%2C%22newClientOrderId%22%3A%22"sv).write(leg.client_order_id);
+      writer.write("%22%7D"sv);
+    }
+    writer.write("%5D&recvWindow="sv).write(recv_window.count());
+  });
+}
+
+std::string_view Encoder::batch_orders_cancel_url(
+    std::vector<char> &buffer,
+    std::string_view const &symbol,
+    std::span<ClientOrderId const> const &client_order_ids,
+    std::chrono::milliseconds recv_window) {
+  return encode(buffer, [&](auto &writer) {
+    writer.write("symbol="sv).write(symbol);
+    writer.write("&origClientOrderIdList=%5B"sv);
+    auto first = true;
+    for (auto &client_order_id : client_order_ids) {
+      if (first) {
+        first = false;
+      } else {
+        writer.write("%2C"sv);
+      }
+      writer.write("%22"sv).write(static_cast<std::string_view>(client_order_id)).write("%22"sv);
+    }
+    writer.write("%5D&recvWindow="sv).write(recv_window.count());
+  });
 }
 
 // JSON
@@ -241,218 +277,144 @@ std::string_view Encoder::session_logon_json(
     std::chrono::milliseconds now_utc,
     std::string_view const &signature,
     std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"session.logon",)"
-      R"("params":{{)"
-      R"("apiKey":"{}",)"
-      R"("timestamp":{},)"
-      R"("signature":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      api_key,
-      now_utc.count(),
-      signature);
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"session.logon","params":{)"sv);
+    writer.write(R"("apiKey":")"sv).write(api_key);
+    writer.write(R"(","timestamp":)"sv).write(now_utc.count());
+    writer.write(R"(,"signature":")"sv).write(signature);
+    writer.write(R"("}})"sv);
+  });
 }
 
 // user-data-stream-start
 
 std::string_view Encoder::user_data_stream_start_json(std::vector<char> &buffer, std::string_view const &api_key, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"userDataStream.start",)"
-      R"("params":{{)"
-      R"("apiKey":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      api_key);
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"userDataStream.start","params":{)"sv);
+    writer.write(R"("apiKey":")"sv).write(api_key);
+    writer.write(R"("}})"sv);
+  });
 }
 
 // user-data-stream-ping
 
 std::string_view Encoder::user_data_stream_ping_json(std::vector<char> &buffer, std::string_view const &api_key, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"userDataStream.ping",)"
-      R"("params":{{)"
-      R"("apiKey":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      api_key);
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"userDataStream.ping","params":{)"sv);
+    writer.write(R"("apiKey":")"sv).write(api_key);
+    writer.write(R"("}})"sv);
+  });
+}
+
+// user-data-stream-subscribe
+
+// note! requires an authenticated session (session.logon)
+std::string_view Encoder::user_data_stream_subscribe_json(std::vector<char> &buffer, std::string_view const &id) {
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"userDataStream.subscribe"})"sv);
+  });
 }
 
 // account-balance
 
 std::string_view Encoder::account_balance_json(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"account.balance",)"
-      R"("params":{{)"
-      R"("timestamp":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"account.balance","params":{)"sv);
+    writer.write(R"("timestamp":")"sv).write(now_utc.count());
+    writer.write(R"("}})"sv);
+  });
 }
 
 // account-status
 
 std::string_view Encoder::account_status_json(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"account.status",)"
-      R"("params":{{)"
-      R"("timestamp":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"account.status","params":{)"sv);
+    writer.write(R"("timestamp":")"sv).write(now_utc.count());
+    writer.write(R"("}})"sv);
+  });
 }
 
 // account-position
 
 std::string_view Encoder::account_position_json(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"account.position",)"
-      R"("params":{{)"
-      R"("timestamp":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"account.position","params":{)"sv);
+    writer.write(R"("timestamp":")"sv).write(now_utc.count());
+    writer.write(R"("}})"sv);
+  });
 }
 
 // order-status
 
 std::string_view Encoder::order_status_json(
+    std::vector<char> &buffer,
+    std::string_view const &symbol,
+    std::string_view const &client_order_id,
+    std::chrono::milliseconds now_utc,
+    std::string_view const &id) {
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"order.status","params":{)"sv);
+    writer.write(R"("symbol":")"sv).write(symbol);
+    writer.write(R"(","origClientOrderId":")"sv).write(client_order_id);
+    writer.write(R"(","timestamp":")"sv).write(now_utc.count());
+    writer.write(R"("}})"sv);
+  });
+}
+
+// open-orders-cancel-all
+
+std::string_view Encoder::open_orders_cancel_all_json(
     std::vector<char> &buffer, std::string_view const &symbol, std::chrono::milliseconds now_utc, std::string_view const &id) {
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"order.status",)"
-      R"("params":{{)"
-      R"("symbol":"{}",)"
-      R"("timestamp":"{}")"
-      R"(}})"
-      R"(}})"sv,
-      id,
-      symbol,
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"openOrders.cancelAll","params":{)"sv);
+    writer.write(R"("symbol":")"sv).write(symbol);
+    writer.write(R"(","timestamp":")"sv).write(now_utc.count());
+    writer.write(R"("}})"sv);
+  });
 }
 
 // order-place
 
 std::string_view Encoder::order_place_json(
     std::vector<char> &buffer,
+    OrderTemplates &order_templates,
     CreateOrder const &create_order,
     server::oms::Order const &order,
     std::string_view const &request_id,
     std::chrono::milliseconds recv_window,
     std::chrono::milliseconds now_utc,
     std::string_view const &id) {
-  auto side = map(create_order.side).template get<Side>();
-  auto type = map(create_order.order_type).template get<OrderType>();
-  auto time_in_force = map(create_order.time_in_force).template get<TimeInForce>();
-#if defined(WS_USE_FMT)
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"order.place",)"
-      R"("params":{{)"
-      R"("newClientOrderId":"{}")"
-      R"(,"symbol":"{}")"
-      R"(,"side":"{}")"
-      R"(,"type":"{}")"
-      R"(,"quantity":"{}")"sv,
-      id,
-      request_id,
-      create_order.symbol,
-      side.as_raw_text(),
-      type.as_raw_text(),
-      Decimal{create_order.quantity, order.quantity_precision.precision});
-  if (time_in_force != json::TimeInForce{}) {
-    fmt::format_to(std::back_inserter(buffer), R"(,"timeInForce":"{}")"sv, time_in_force.as_raw_text());
-  }
-  if (!std::isnan(create_order.price)) {
-    fmt::format_to(std::back_inserter(buffer), R"(,"price":"{}")"sv, Decimal{create_order.price, order.price_precision.precision});
-  }
-  if (!std::isnan(create_order.stop_price)) {
-    fmt::format_to(std::back_inserter(buffer), R"(,"stopPrice":"{}")"sv, Decimal{create_order.stop_price, order.price_precision.precision});
-  }
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(,"recvWindow":{})"
-      R"(,"timestamp":{})"
-      R"(}})"
-      R"(}})"sv,
-      recv_window.count(),
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
-#else
-  buffer.resize(512);
-  std::span buffer_2{reinterpret_cast<std::byte *>(std::data(buffer)), std::size(buffer)};
-  utils::text::Writer writer{buffer_2};
-  writer.write("{"sv);
-  writer.write(R"("newClientOrderId":")"sv).write(request_id).write(R"(")"sv);
-  if (!std::isnan(create_order.price)) {
-    writer.write(R"(,"price":")"sv).write(Decimal{create_order.price, order.price_precision.precision}).write(R"(")"sv);
-  }
-  writer.write(R"(,"quantity":")"sv).write(Decimal{create_order.quantity, order.quantity_precision.precision}).write(R"(")"sv);
-  writer.write(R"(,"recvWindow":)"sv).write(recv_window.count());
-  writer.write(R"(,"side":")"sv).write(side.as_raw_text()).write(R"(")"sv);
-  if (!std::isnan(create_order.stop_price)) {
-    writer.write(R"(,"stopPrice":")"sv).write(Decimal{create_order.stop_price, order.price_precision.precision}).write(R"(")"sv);
-  }
-  writer.write(R"(,"symbol":")"sv).write(create_order.symbol).write(R"(")"sv);
-  if (time_in_force != json::TimeInForce{}) {
-    writer.write(R"(,"timeInForce":")"sv).write(time_in_force.as_raw_text()).write(R"(")"sv);
-  }
-  writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
-  writer.write(R"(,"type":")"sv).write(type.as_raw_text()).write(R"(")"sv);
-  writer.write("}"sv);
-  return writer.finish();
-#endif
+  auto &order_template = order_templates(create_order);
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(order_template.order_place_json).write(request_id);
+    writer.write(R"(","quantity":")"sv);
+    write_decimal(writer, create_order.quantity, order.quantity_precision.precision);
+    writer.write(R"(")"sv);
+    if (!std::isnan(create_order.price)) {
+      writer.write(R"(,"price":")"sv);
+      write_decimal(writer, create_order.price, order.price_precision.precision);
+      writer.write(R"(")"sv);
+    }
+    if (!std::isnan(create_order.stop_price)) {
+      writer.write(R"(,"stopPrice":")"sv);
+      write_decimal(writer, create_order.stop_price, order.price_precision.precision);
+      writer.write(R"(")"sv);
+    }
+    writer.write(R"(,"recvWindow":)"sv).write(recv_window.count());
+    writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
+    writer.write("}}"sv);
+  });
 }
 
 // order-modify
@@ -470,61 +432,24 @@ std::string_view Encoder::order_modify_json(
   auto side = map(order.side).template get<Side>();
   auto quantity = std::isnan(modify_order.quantity) ? order.quantity : modify_order.quantity;
   auto price = std::isnan(modify_order.price) ? order.price : modify_order.price;
-#if defined(WS_USE_FMT)
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"order.modify",)"
-      R"("params":{{)"
-      R"("symbol":"{}")"
-      R"(,"side":"{}")"sv,
-      id,
-      order.symbol,
-      side.as_raw_text());
-  if (std::empty(order.external_order_id)) {
-    fmt::format_to(std::back_inserter(buffer), R"(,"origClientOrderId":"{}")"sv, order.client_order_id);
-  } else {
-    fmt::format_to(std::back_inserter(buffer), R"(,"orderId":{})"sv, order.external_order_id);  // note! integer
-  }
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(,"quantity":"{}")"
-      R"(,"price":"{}")"
-      R"(,"recvWindow":{})"
-      R"(,"timestamp":{})"
-      R"(}})"
-      R"(}})"sv,
-      Decimal{quantity, order.quantity_precision.precision},
-      Decimal{price, order.price_precision.precision},
-      recv_window.count(),
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
-#else
-  buffer.resize(512);
-  std::span buffer_2{reinterpret_cast<std::byte *>(std::data(buffer)), std::size(buffer)};
-  utils::text::Writer writer{buffer_2};
-  writer.write("{"sv);
-  writer.write(R"("newClientOrderId":")"sv).write(request_id).write(R"(")"sv);
-  if (!std::empty(order.external_order_id)) {
-    writer.write(R"(,"orderId":)"sv).write(order.external_order_id);  // note! integer
-  }
-  writer.write(R"(,"origClientOrderId":")"sv).write(previous_request_id).write(R"(")"sv);
-  writer.write(R"(,"recvWindow":)"sv).write(recv_window.count());
-  if (!std::isnan(modify_order.price)) {
-    writer.write(R"(,"price":")"sv).write(Decimal{modify_order.price, order.price_precision.precision}).write(R"(")"sv);
-  }
-  if (!std::isnan(modify_order.quantity)) {
-    writer.write(R"(,"quantity":")"sv).write(Decimal{modify_order.quantity, order.quantity_precision.precision}).write(R"(")"sv);
-  }
-  writer.write(R"(,"side":")"sv).write(side.as_raw_text()).write(R"(")"sv);
-  writer.write(R"(,"symbol":")"sv).write(order.symbol).write(R"(")"sv);
-  writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
-  writer.write("}"sv);
-  return writer.finish();
-#endif
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"order.modify","params":{)"sv);
+    writer.write(R"("symbol":")"sv).write(order.symbol);
+    writer.write(R"(","side":")"sv).write(side.as_raw_text());
+    if (std::empty(order.external_order_id)) {
+      writer.write(R"(","origClientOrderId":")"sv).write(order.client_order_id).write(R"(")"sv);
+    } else {
+      writer.write(R"(","orderId":)"sv).write(order.external_order_id);  // note! integer
+    }
+    writer.write(R"(,"quantity":")"sv);
+    write_decimal(writer, quantity, order.quantity_precision.precision);
+    writer.write(R"(","price":")"sv);
+    write_decimal(writer, price, order.price_precision.precision);
+    writer.write(R"(","recvWindow":)"sv).write(recv_window.count());
+    writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
+    writer.write("}}"sv);
+  });
 }
 
 // order-cancel
@@ -533,53 +458,24 @@ std::string_view Encoder::order_cancel_json(
     std::vector<char> &buffer,
     roq::CancelOrder const &,
     server::oms::Order const &order,
-    std::string_view const &request_id,
-    std::string_view const &previous_request_id,
+    [[maybe_unused]] std::string_view const &request_id,
+    [[maybe_unused]] std::string_view const &previous_request_id,
     std::chrono::milliseconds recv_window,
     std::chrono::milliseconds now_utc,
     std::string_view const &id) {
-#if defined(WS_USE_FMT)
-  buffer.clear();
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"({{)"
-      R"("id":"{}",)"
-      R"("method":"order.cancel",)"
-      R"("params":{{)"
-      R"("symbol":"{}")"sv,
-      id,
-      order.symbol);
-  if (std::empty(order.external_order_id)) {
-    fmt::format_to(std::back_inserter(buffer), R"(,"origClientOrderId":"{}")"sv, order.client_order_id);
-  } else {
-    fmt::format_to(std::back_inserter(buffer), R"(,"orderId":{})"sv, order.external_order_id);  // note! integer
-  }
-  fmt::format_to(
-      std::back_inserter(buffer),
-      R"(,"recvWindow":{})"
-      R"(,"timestamp":{})"
-      R"(}})"
-      R"(}})"sv,
-      recv_window.count(),
-      now_utc.count());
-  std::string_view result{std::data(buffer), std::size(buffer)};
-  return result;
-#else
-  buffer.resize(512);
-  std::span buffer_2{reinterpret_cast<std::byte *>(std::data(buffer)), std::size(buffer)};
-  utils::text::Writer writer{buffer_2};
-  writer.write("{"sv);
-  writer.write(R"("newClientOrderId":")"sv).write(request_id).write(R"(")"sv);
-  if (!std::empty(order.external_order_id)) {
-    writer.write(R"(,"orderId":)"sv).write(order.external_order_id);  // note! integer
-  }
-  writer.write(R"(,"origClientOrderId":")"sv).write(previous_request_id).write(R"(")"sv);
-  writer.write(R"(,"recvWindow":)"sv).write(recv_window.count());
-  writer.write(R"(,"symbol":")"sv).write(order.symbol).write(R"(")"sv);
-  writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
-  writer.write("}"sv);
-  return writer.finish();
-#endif
+  return encode(buffer, [&](auto &writer) {
+    writer.write(R"({"id":")"sv).write(id);
+    writer.write(R"(","method":"order.cancel","params":{)"sv);
+    writer.write(R"("symbol":")"sv).write(order.symbol);
+    if (std::empty(order.external_order_id)) {
+      writer.write(R"(","origClientOrderId":")"sv).write(order.client_order_id).write(R"(")"sv);
+    } else {
+      writer.write(R"(","orderId":)"sv).write(order.external_order_id);  // note! integer
+    }
+    writer.write(R"(,"recvWindow":)"sv).write(recv_window.count());
+    writer.write(R"(,"timestamp":)"sv).write(now_utc.count());
+    writer.write("}}"sv);
+  });
 }
 
 }  // namespace json
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <chrono>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -14,11 +15,23 @@
 
 #include "roq/server/oms/order.hpp"
 
+#include "roq/binance_futures/json/order_templates.hpp"
+
 namespace roq {
 namespace binance_futures {
 namespace json {
 
 struct Encoder final {
+  struct QuoteLeg final {
+    std::string_view symbol;
+    roq::Side side = {};
+    double quantity = NaN;
+    double price = NaN;
+    std::string_view client_order_id;
+    Precision quantity_precision = {};
+    Precision price_precision = {};
+  };
+
   // URL
 
   // user-trades
@@ -31,10 +44,18 @@ struct Encoder final {
       uint32_t limit,
       std::chrono::milliseconds recv_window);
 
+  static std::string_view user_trades_from_id_url(
+      std::vector<char> &buffer, std::string_view const &symbol, int64_t from_id, uint32_t limit, std::chrono::milliseconds recv_window);
+
   // order-place
 
   static std::string_view order_place_url(
-      std::vector<char> &buffer, CreateOrder const &, server::oms::Order const &, std::string_view const &request_id, std::chrono::milliseconds recv_window);
+      std::vector<char> &buffer,
+      OrderTemplates &,
+      CreateOrder const &,
+      server::oms::Order const &,
+      std::string_view const &request_id,
+      std::chrono::milliseconds recv_window);
 
   // order-modify
 
@@ -66,6 +87,17 @@ struct Encoder final {
   static std::string_view countdown_cancel_open_orders_url(
       std::vector<char> &buffer, std::string_view const &symbol, std::chrono::milliseconds countdown_time, std::chrono::milliseconds recv_window);
 
+  // batch-orders
+
+  // note! always LIMIT / GTC
+  static std::string_view batch_orders_place_url(std::vector<char> &buffer, std::span<QuoteLeg const> const &, std::chrono::milliseconds recv_window);
+
+  static std::string_view batch_orders_cancel_url(
+      std::vector<char> &buffer,
+      std::string_view const &symbol,
+      std::span<ClientOrderId const> const &client_order_ids,
+      std::chrono::milliseconds recv_window);
+
   // JSON
 
   // session-logon
@@ -85,6 +117,10 @@ struct Encoder final {
 
   static std::string_view user_data_stream_ping_json(std::vector<char> &buffer, std::string_view const &api_key, std::string_view const &id);
 
+  // user-data-stream-subscribe
+
+  static std::string_view user_data_stream_subscribe_json(std::vector<char> &buffer, std::string_view const &id);
+
   // account-balance
 
   static std::string_view account_balance_json(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &id);
@@ -100,12 +136,22 @@ struct Encoder final {
   // order-status
 
   static std::string_view order_status_json(
+      std::vector<char> &buffer,
+      std::string_view const &symbol,
+      std::string_view const &client_order_id,
+      std::chrono::milliseconds now_utc,
+      std::string_view const &id);
+
+  // open-orders-cancel-all
+
+  static std::string_view open_orders_cancel_all_json(
       std::vector<char> &buffer, std::string_view const &symbol, std::chrono::milliseconds now_utc, std::string_view const &id);
 
   // order-place
 
   static std::string_view order_place_json(
       std::vector<char> &buffer,
+      OrderTemplates &,
       CreateOrder const &,
       server::oms::Order const &,
       std::string_view const &request_id,
@@ -0,0 +1,117 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/json/fast_order_trade_update.hpp"
+
+#include "roq/utils/hash/fnv.hpp"
+
+#include "roq/binance_futures/json/utils.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// === HELPERS ===
+
+namespace {
+constexpr auto hash(std::string_view const &key) {
+  return utils::hash::FNV::compute(key);
+}
+
+void update_execution_report(auto &result, core::json::Object const &object) {
+  for (auto [key, value] : object) {
+    switch (hash(key)) {
+      case hash("s"sv):
+        result.symbol = core::json::get<std::string_view>(value);
+        break;
+      case hash("c"sv):
+        result.client_order_id = core::json::get<std::string_view>(value);
+        break;
+      case hash("S"sv):
+        result.side = Side{value};
+        break;
+      case hash("o"sv):
+        result.order_type = OrderType{value};
+        break;
+      case hash("f"sv):
+        result.time_in_force = TimeInForce{value};
+        break;
+      case hash("q"sv):
+        result.original_quantity = core::json::get<double>(value);
+        break;
+      case hash("p"sv):
+        result.original_price = core::json::get<double>(value);
+        break;
+      case hash("ap"sv):
+        result.average_price = core::json::get<double>(value);
+        break;
+      case hash("sp"sv):
+        result.stop_price = core::json::get<double>(value);
+        break;
+      case hash("x"sv):
+        result.execution_type = ExecutionType{value};
+        break;
+      case hash("X"sv):
+        result.order_status = OrderStatus{value};
+        break;
+      case hash("i"sv):
+        result.order_id = core::json::get<int64_t>(value);
+        break;
+      case hash("l"sv):
+        result.last_filled_quantity = core::json::get<double>(value);
+        break;
+      case hash("z"sv):
+        result.order_filled_accumulated_quantity = core::json::get<double>(value);
+        break;
+      case hash("L"sv):
+        result.last_filled_price = core::json::get<double>(value);
+        break;
+      case hash("N"sv):
+        result.commission_asset = core::json::get<std::string_view>(value);
+        break;
+      case hash("n"sv):
+        result.commission = core::json::get<double>(value);
+        break;
+      case hash("T"sv):
+        json::update(result.order_trade_time, value);
+        break;
+      case hash("t"sv):
+        result.trade_id = core::json::get<int64_t>(value);
+        break;
+      case hash("m"sv):
+        result.is_trade_maker = core::json::get<bool>(value);
+        break;
+      default:
+        // note! not consumed
+        break;
+    }
+  }
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+bool FastOrderTradeUpdate::update(std::string_view const &key, core::json::Value const &value) {
+  switch (hash(key)) {
+    case hash("e"sv):
+      event_type = EventType{value};
+      return true;
+    case hash("E"sv):
+      json::update(event_time, value);
+      return true;
+    case hash("T"sv):
+      json::update(transaction_time, value);
+      return true;
+    case hash("o"sv):
+      update_execution_report(*this, std::get<core::json::Object>(value));
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
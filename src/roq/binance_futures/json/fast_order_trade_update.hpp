@@ -0,0 +1,119 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string_view>
+
+#include "roq/numbers.hpp"
+
+#include "roq/core/json/parser.hpp"
+
+#include "roq/binance_futures/json/event_type.hpp"
+#include "roq/binance_futures/json/execution_type.hpp"
+#include "roq/binance_futures/json/order_status.hpp"
+#include "roq/binance_futures/json/order_type.hpp"
+#include "roq/binance_futures/json/side.hpp"
+#include "roq/binance_futures/json/time_in_force.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// flat projection of OrderTradeUpdate (only the fields consumed by the drop copy handlers)
+// note! string views reference the message
+
+struct FastOrderTradeUpdate final {
+  EventType event_type = {};
+  std::chrono::milliseconds event_time = {};
+  std::chrono::milliseconds transaction_time = {};
+  // execution report
+  std::string_view symbol;
+  std::string_view client_order_id;
+  Side side = {};
+  OrderType order_type = {};
+  TimeInForce time_in_force = {};
+  double original_quantity = NaN;
+  double original_price = NaN;
+  double average_price = NaN;
+  double stop_price = NaN;
+  ExecutionType execution_type = {};
+  OrderStatus order_status = {};
+  int64_t order_id = {};
+  double last_filled_quantity = NaN;
+  double order_filled_accumulated_quantity = NaN;
+  double last_filled_price = NaN;
+  std::string_view commission_asset;
+  double commission = NaN;
+  std::chrono::milliseconds order_trade_time = {};
+  int64_t trade_id = {};
+  bool is_trade_maker = false;
+
+  // note! returns false if the key is not consumed (the caller decides if that's an error)
+  bool update(std::string_view const &key, core::json::Value const &value);
+};
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::binance_futures::json::FastOrderTradeUpdate> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::binance_futures::json::FastOrderTradeUpdate const &value, format_context &context) const {
+    using namespace std::literals;
+    return fmt::format_to(
+        context.out(),
+        R"({{)"
+        R"(event_type={}, )"
+        R"(event_time={}, )"
+        R"(transaction_time={}, )"
+        R"(symbol="{}", )"
+        R"(client_order_id="{}", )"
+        R"(side={}, )"
+        R"(order_type={}, )"
+        R"(time_in_force={}, )"
+        R"(original_quantity={}, )"
+        R"(original_price={}, )"
+        R"(average_price={}, )"
+        R"(stop_price={}, )"
+        R"(execution_type={}, )"
+        R"(order_status={}, )"
+        R"(order_id={}, )"
+        R"(last_filled_quantity={}, )"
+        R"(order_filled_accumulated_quantity={}, )"
+        R"(last_filled_price={}, )"
+        R"(commission_asset="{}", )"
+        R"(commission={}, )"
+        R"(order_trade_time={}, )"
+        R"(trade_id={}, )"
+        R"(is_trade_maker={})"
+        R"(}})"sv,
+        value.event_type,
+        value.event_time,
+        value.transaction_time,
+        value.symbol,
+        value.client_order_id,
+        value.side,
+        value.order_type,
+        value.time_in_force,
+        value.original_quantity,
+        value.original_price,
+        value.average_price,
+        value.stop_price,
+        value.execution_type,
+        value.order_status,
+        value.order_id,
+        value.last_filled_quantity,
+        value.order_filled_accumulated_quantity,
+        value.last_filled_price,
+        value.commission_asset,
+        value.commission,
+        value.order_trade_time,
+        value.trade_id,
+        value.is_trade_maker);
+  }
+};
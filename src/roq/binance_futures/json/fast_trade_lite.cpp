@@ -0,0 +1,74 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/json/fast_trade_lite.hpp"
+
+#include "roq/utils/hash/fnv.hpp"
+
+#include "roq/binance_futures/json/utils.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// === HELPERS ===
+
+namespace {
+constexpr auto hash(std::string_view const &key) {
+  return utils::hash::FNV::compute(key);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+bool FastTradeLite::update(std::string_view const &key, core::json::Value const &value) {
+  switch (hash(key)) {
+    case hash("e"sv):
+      event_type = EventType{value};
+      return true;
+    case hash("E"sv):
+      json::update(event_time, value);
+      return true;
+    case hash("T"sv):
+      json::update(transaction_time, value);
+      return true;
+    case hash("s"sv):
+      symbol = core::json::get<std::string_view>(value);
+      return true;
+    case hash("q"sv):
+      original_quantity = core::json::get<double>(value);
+      return true;
+    case hash("p"sv):
+      original_price = core::json::get<double>(value);
+      return true;
+    case hash("m"sv):
+      maker = core::json::get<bool>(value);
+      return true;
+    case hash("c"sv):
+      client_order_id = core::json::get<std::string_view>(value);
+      return true;
+    case hash("S"sv):
+      side = Side{value};
+      return true;
+    case hash("L"sv):
+      last_filled_price = core::json::get<double>(value);
+      return true;
+    case hash("l"sv):
+      last_filled_quantity = core::json::get<double>(value);
+      return true;
+    case hash("t"sv):
+      trade_id = core::json::get<int64_t>(value);
+      return true;
+    case hash("i"sv):
+      order_id = core::json::get<int64_t>(value);
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
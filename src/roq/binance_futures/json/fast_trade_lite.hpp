@@ -0,0 +1,84 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string_view>
+
+#include "roq/numbers.hpp"
+
+#include "roq/core/json/parser.hpp"
+
+#include "roq/binance_futures/json/event_type.hpp"
+#include "roq/binance_futures/json/side.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// flat equivalent of TradeLite (decoded in the same pass as the event type)
+// note! string views reference the message
+
+struct FastTradeLite final {
+  EventType event_type = {};
+  std::chrono::milliseconds event_time = {};
+  std::chrono::milliseconds transaction_time = {};
+  std::string_view symbol;
+  double original_quantity = NaN;
+  double original_price = NaN;
+  bool maker = false;
+  std::string_view client_order_id;
+  Side side = {};
+  double last_filled_price = NaN;
+  double last_filled_quantity = NaN;
+  int64_t trade_id = {};
+  int64_t order_id = {};
+
+  // note! returns false if the key is not consumed
+  bool update(std::string_view const &key, core::json::Value const &value);
+};
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
+
+template <>
+struct fmt::formatter<roq::binance_futures::json::FastTradeLite> {
+  constexpr auto parse(format_parse_context &context) { return std::begin(context); }
+  auto format(roq::binance_futures::json::FastTradeLite const &value, format_context &context) const {
+    using namespace std::literals;
+    return fmt::format_to(
+        context.out(),
+        R"({{)"
+        R"(event_type={}, )"
+        R"(event_time={}, )"
+        R"(transaction_time={}, )"
+        R"(symbol="{}", )"
+        R"(original_quantity={}, )"
+        R"(original_price={}, )"
+        R"(maker={}, )"
+        R"(client_order_id="{}", )"
+        R"(side={}, )"
+        R"(last_filled_price={}, )"
+        R"(last_filled_quantity={}, )"
+        R"(trade_id={}, )"
+        R"(order_id={})"
+        R"(}})"sv,
+        value.event_type,
+        value.event_time,
+        value.transaction_time,
+        value.symbol,
+        value.original_quantity,
+        value.original_price,
+        value.maker,
+        value.client_order_id,
+        value.side,
+        value.last_filled_price,
+        value.last_filled_quantity,
+        value.trade_id,
+        value.order_id);
+  }
+};
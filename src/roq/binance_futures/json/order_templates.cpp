@@ -0,0 +1,164 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/json/order_templates.hpp"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "roq/logging.hpp"
+
+#include "roq/binance_futures/json/map.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// === CONSTANTS ===
+
+namespace {
+size_t const MAX_DIGITS = 12;
+
+// note! keep well inside the range where doubles represent integers exactly
+double const MAX_SCALED = 1.0e15;
+
+constexpr auto POW10 = []() {
+  std::array<int64_t, MAX_DIGITS + 1> result = {};
+  int64_t value = 1;
+  for (auto &item : result) {
+    item = value;
+    value *= 10;
+  }
+  return result;
+}();
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+template <size_t N>
+std::string_view render_fixed_point(std::span<char, FixedPoint::MAX_LENGTH> buffer, double value) {
+  auto scaled = value * static_cast<double>(POW10[N]);
+  if (!(std::fabs(scaled) < MAX_SCALED)) [[unlikely]] {
+    return {};
+  }
+  auto fixed_point = std::llround(scaled);
+  auto negative = fixed_point < 0;
+  auto unsigned_value = static_cast<uint64_t>(negative ? -fixed_point : fixed_point);
+  auto integer = unsigned_value / POW10[N];
+  auto fraction = unsigned_value % POW10[N];
+  // note! rendered backwards from the end of the buffer
+  auto last = std::data(buffer) + std::size(buffer);
+  auto first = last;
+  if constexpr (N > 0) {
+    if (fraction != 0) {
+      auto digits = N;
+      while ((fraction % 10) == 0) {  // note! trailing zeros are not rendered
+        fraction /= 10;
+        --digits;
+      }
+      for (size_t i = 0; i < digits; ++i) {
+        *--first = static_cast<char>('0' + (fraction % 10));
+        fraction /= 10;
+      }
+      *--first = '.';
+    }
+  }
+  do {
+    *--first = static_cast<char>('0' + (integer % 10));
+    integer /= 10;
+  } while (integer != 0);
+  if (negative) {
+    *--first = '-';
+  }
+  return {first, static_cast<size_t>(last - first)};
+}
+
+template <size_t... I>
+constexpr auto create_renderers(std::index_sequence<I...>) {
+  return std::array<std::string_view (*)(std::span<char, FixedPoint::MAX_LENGTH>, double), sizeof...(I)>{render_fixed_point<I>...};
+}
+
+auto const RENDERERS = create_renderers(std::make_index_sequence<MAX_DIGITS + 1>{});
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// order-templates
+
+OrderTemplates::Template const &OrderTemplates::operator()(CreateOrder const &create_order) {
+  auto &templates = symbols_[create_order.symbol];
+  for (auto &item : templates) {
+    if (item.side == create_order.side && item.order_type == create_order.order_type && item.time_in_force == create_order.time_in_force) {
+      return item;
+    }
+  }
+  auto &result = templates.emplace_back(create(create_order));
+  ++size_;
+  log::debug(R"(order_place_json="{}", order_place_url="{}")"sv, result.order_place_json, result.order_place_url);
+  return result;
+}
+
+OrderTemplates::Template OrderTemplates::create(CreateOrder const &create_order) {
+  auto side = map(create_order.side).template get<json::Side>();
+  auto type = map(create_order.order_type).template get<json::OrderType>();
+  auto time_in_force = map(create_order.time_in_force).template get<json::TimeInForce>();
+  Template result{
+      .side = create_order.side,
+      .order_type = create_order.order_type,
+      .time_in_force = create_order.time_in_force,
+      .order_place_json = {},
+      .order_place_url = {},
+  };
+  // json
+  fmt::format_to(
+      std::back_inserter(result.order_place_json),
+      R"(","method":"order.place","params":{{)"
+      R"("symbol":"{}")"
+      R"(,"side":"{}")"
+      R"(,"type":"{}")"sv,
+      create_order.symbol,
+      side.as_raw_text(),
+      type.as_raw_text());
+  if (time_in_force != json::TimeInForce{}) {
+    fmt::format_to(std::back_inserter(result.order_place_json), R"(,"timeInForce":"{}")"sv, time_in_force.as_raw_text());
+  }
+  result.order_place_json += R"(,"newClientOrderId":")"sv;
+  // url
+  fmt::format_to(
+      std::back_inserter(result.order_place_url),
+      R"(symbol={}&)"
+      R"(side={}&)"
+      R"(type={}&)"
+      R"(reduceOnly=false&)"sv,
+      create_order.symbol,
+      side.as_raw_text(),
+      type.as_raw_text());
+  if (create_order.order_type == roq::OrderType::LIMIT) {
+    fmt::format_to(std::back_inserter(result.order_place_url), R"(timeInForce={}&)"sv, time_in_force.as_raw_text());
+  }
+  result.order_place_url += "newClientOrderId="sv;
+  return result;
+}
+
+// fixed-point
+
+std::string_view FixedPoint::render(std::span<char, MAX_LENGTH> buffer, double value, Precision precision) {
+  if (std::isnan(value)) [[unlikely]] {
+    return {};
+  }
+  auto digits = static_cast<int32_t>(precision) - static_cast<int32_t>(Precision::_0);
+  if (digits < 0 || static_cast<size_t>(digits) > MAX_DIGITS) [[unlikely]] {
+    return {};
+  }
+  return RENDERERS[digits](buffer, value);
+}
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,62 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/create_order.hpp"
+#include "roq/precision.hpp"
+
+#include "roq/utils/container.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace json {
+
+// pre-rendered static fragments of order requests
+// note! created on first use per (symbol, side, order_type, time_in_force) and then never changes
+
+struct OrderTemplates final {
+  struct Template final {
+    Side side = {};
+    OrderType order_type = {};
+    TimeInForce time_in_force = {};
+    // note! ends with the opening quote of the newClientOrderId value
+    std::string order_place_json;
+    // note! ends with "newClientOrderId="
+    std::string order_place_url;
+  };
+
+  OrderTemplates() = default;
+
+  OrderTemplates(OrderTemplates &&) = delete;
+  OrderTemplates(OrderTemplates const &) = delete;
+
+  // note! the result is only valid until the next call
+  Template const &operator()(CreateOrder const &);
+
+  size_t size() const { return size_; }
+
+ protected:
+  static Template create(CreateOrder const &);
+
+ private:
+  utils::unordered_map<std::string, std::vector<Template>> symbols_;
+  size_t size_ = {};
+};
+
+// precision-specialised fixed-point rendering
+// note! returns an empty result if the value can not be rendered (caller should fall back to Decimal)
+
+struct FixedPoint final {
+  static constexpr size_t const MAX_LENGTH = 32;
+
+  static std::string_view render(std::span<char, MAX_LENGTH> buffer, double value, Precision);
+};
+
+}  // namespace json
+}  // namespace binance_futures
+}  // namespace roq
@@ -29,6 +29,18 @@ void dispatch_helper(auto &handler, auto &message, auto &buffer_stack, auto &tra
   create_trace_and_dispatch(handler, trace_info, obj);
 }
 
+// note! fallback if the event type is not the first key
+template <typename T>
+void dispatch_fast_helper(auto &handler, auto &message, auto &trace_info) {
+  T obj;
+  core::json::Parser parser{message};
+  auto root = parser.root();
+  for (auto [key, value] : std::get<core::json::Object>(root)) {
+    obj.update(key, value);
+  }
+  create_trace_and_dispatch(handler, trace_info, obj);
+}
+
 auto try_dispatch(auto &handler, auto &message, auto &buffer_stack, auto event_type, auto &trace_info, auto allow_unknown_event_types) {
   switch (event_type) {
     using enum EventType::type_t;
@@ -47,7 +59,7 @@ auto try_dispatch(auto &handler, auto &message, auto &buffer_stack, auto event_t
       log::fatal("Unexpected"sv);
       break;
     case ORDER_TRADE_UPDATE:
-      dispatch_helper<OrderTradeUpdate>(handler, message, buffer_stack, trace_info);
+      dispatch_fast_helper<FastOrderTradeUpdate>(handler, message, trace_info);
       return true;
     case ACCOUNT_UPDATE:
       dispatch_helper<AccountUpdate>(handler, message, buffer_stack, trace_info);
@@ -68,7 +80,7 @@ auto try_dispatch(auto &handler, auto &message, auto &buffer_stack, auto event_t
       // XXX FIXME TODO need parsing
       return true;
     case TRADE_LITE:
-      dispatch_helper<TradeLite>(handler, message, buffer_stack, trace_info);
+      dispatch_fast_helper<FastTradeLite>(handler, message, trace_info);
       return true;
     case BALANCE_UPDATE:
       dispatch_helper<BalanceUpdate>(handler, message, buffer_stack, trace_info);
@@ -95,14 +107,58 @@ bool UserStreamParser::dispatch(
     core::json::BufferStack &buffer_stack,
     TraceInfo const &trace_info,
     bool allow_unknown_event_types) {
+  // fast path: fills are decoded in the same pass as the event type (expected to be the first key)
+  EventType event_type;
+  FastOrderTradeUpdate order_trade_update;
+  FastTradeLite trade_lite;
+  auto helper = [&](auto &key, auto &value) {
+    if (event_type == EventType{}) {
+      if (key != EVENT_TYPE) {
+        return true;
+      }
+      event_type = EventType{value};
+      switch (event_type) {
+        using enum EventType::type_t;
+        case ORDER_TRADE_UPDATE:
+          order_trade_update.event_type = event_type;
+          return false;
+        case TRADE_LITE:
+          trade_lite.event_type = event_type;
+          return false;
+        default:
+          return true;
+      }
+    }
+    if (event_type == EventType::ORDER_TRADE_UPDATE) {
+      order_trade_update.update(key, value);
+    } else {
+      trade_lite.update(key, value);
+    }
+    return false;
+  };
+  core::json::Parser::dispatch<core::json::Object>(helper, message);
+  switch (event_type) {
+    using enum EventType::type_t;
+    case UNDEFINED_INTERNAL:
+      break;
+    case ORDER_TRADE_UPDATE:
+      create_trace_and_dispatch(handler, trace_info, order_trade_update);
+      return true;
+    case TRADE_LITE:
+      create_trace_and_dispatch(handler, trace_info, trade_lite);
+      return true;
+    default:
+      return try_dispatch(handler, message, buffer_stack, event_type, trace_info, allow_unknown_event_types);
+  }
+  // slow path
   core::json::Parser parser{message};
   auto root = parser.root();
   for (auto [key, value] : std::get<core::json::Object>(root)) {
     if (key != EVENT_TYPE) {
       continue;
     }
-    EventType event_type{value};
-    if (try_dispatch(handler, message, buffer_stack, event_type, trace_info, allow_unknown_event_types)) {
+    EventType event_type_2{value};
+    if (try_dispatch(handler, message, buffer_stack, event_type_2, trace_info, allow_unknown_event_types)) {
       return true;
     }
     break;
@@ -12,13 +12,13 @@
 #include "roq/binance_futures/json/account_update.hpp"
 #include "roq/binance_futures/json/balance_update.hpp"
 #include "roq/binance_futures/json/execution_report_2.hpp"
+#include "roq/binance_futures/json/fast_order_trade_update.hpp"
+#include "roq/binance_futures/json/fast_trade_lite.hpp"
 #include "roq/binance_futures/json/grid_update.hpp"
 #include "roq/binance_futures/json/liability_change.hpp"
 #include "roq/binance_futures/json/margin_call.hpp"
-#include "roq/binance_futures/json/order_trade_update.hpp"
 #include "roq/binance_futures/json/outbound_account_position.hpp"
 #include "roq/binance_futures/json/strategy_update.hpp"
-#include "roq/binance_futures/json/trade_lite.hpp"
 
 namespace roq {
 namespace binance_futures {
@@ -26,13 +26,13 @@ namespace json {
 
 struct UserStreamParser final {
   struct Handler {
-    virtual void operator()(Trace<OrderTradeUpdate> const &) = 0;
+    virtual void operator()(Trace<FastOrderTradeUpdate> const &) = 0;
     virtual void operator()(Trace<AccountUpdate> const &) = 0;
     virtual void operator()(Trace<MarginCall> const &) = 0;
     virtual void operator()(Trace<StrategyUpdate> const &) = 0;
     virtual void operator()(Trace<GridUpdate> const &) = 0;
     virtual void operator()(Trace<AccountConfigUpdate> const &) = 0;
-    virtual void operator()(Trace<TradeLite> const &) = 0;
+    virtual void operator()(Trace<FastTradeLite> const &) = 0;
     virtual void operator()(Trace<ExecutionReport2> const &) = 0;
     virtual void operator()(Trace<BalanceUpdate> const &) = 0;
     virtual void operator()(Trace<LiabilityChange> const &) = 0;
@@ -2,6 +2,8 @@
 
 #include "roq/binance_futures/json/wsapi_parser.hpp"
 
+#include <cctype>
+
 #include "roq/logging.hpp"
 
 #include "roq/utils/hash/fnv.hpp"
@@ -19,6 +21,7 @@ namespace json {
 namespace {
 constexpr auto const KEY_ID = "id"sv;
 constexpr auto const KEY_ERROR = "error"sv;
+constexpr auto const KEY_EVENT = "event"sv;
 }  // namespace
 
 // === HELPERS ===
@@ -30,6 +33,108 @@ bool dispatch_helper(auto &handler, auto &value, auto &buffer_stack, auto &trace
   create_trace_and_dispatch(handler, trace_info, obj, std::forward<Args>(args)...);
   return true;
 }
+
+// note! returns the end of the string starting at offset (the position of the closing quote)
+size_t skip_string(std::string_view const &message, size_t offset) {
+  for (auto i = offset + 1; i < std::size(message); ++i) {
+    switch (message[i]) {
+      case '\\':
+        ++i;
+        break;
+      case '"':
+        return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// note! returns the end of the object or array starting at offset (the position of the closing bracket)
+size_t skip_object(std::string_view const &message, size_t offset) {
+  size_t depth = 0;
+  for (auto i = offset; i < std::size(message); ++i) {
+    switch (message[i]) {
+      case '"':
+        i = skip_string(message, i);
+        if (i == std::string_view::npos) {
+          return i;
+        }
+        break;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        if (--depth == 0) {
+          return i;
+        }
+        break;
+    }
+  }
+  return std::string_view::npos;
+}
+
+size_t skip_whitespace(std::string_view const &message, size_t offset) {
+  while (offset < std::size(message) && std::isspace(static_cast<unsigned char>(message[offset]))) {
+    ++offset;
+  }
+  return offset;
+}
+
+// note! returns the raw text of a top-level object member (empty if not found)
+std::string_view find_object(std::string_view const &message, std::string_view const &key) {
+  auto offset = skip_whitespace(message, 0);
+  if (offset >= std::size(message) || message[offset] != '{') {
+    return {};
+  }
+  ++offset;
+  while (offset < std::size(message)) {
+    offset = skip_whitespace(message, offset);
+    if (offset >= std::size(message) || message[offset] != '"') {
+      return {};
+    }
+    auto end = skip_string(message, offset);
+    if (end == std::string_view::npos) {
+      return {};
+    }
+    auto name = message.substr(offset + 1, end - offset - 1);
+    offset = skip_whitespace(message, end + 1);
+    if (offset >= std::size(message) || message[offset] != ':') {
+      return {};
+    }
+    offset = skip_whitespace(message, offset + 1);
+    if (offset >= std::size(message)) {
+      return {};
+    }
+    switch (message[offset]) {
+      case '"':
+        end = skip_string(message, offset);
+        break;
+      case '{':
+      case '[':
+        end = skip_object(message, offset);
+        if (name == key && message[offset] == '{' && end != std::string_view::npos) {
+          return message.substr(offset, end - offset + 1);
+        }
+        break;
+      default:
+        end = message.find_first_of(",}"sv, offset);
+        if (end != std::string_view::npos) {
+          --end;
+        }
+        break;
+    }
+    if (end == std::string_view::npos) {
+      return {};
+    }
+    offset = skip_whitespace(message, end + 1);
+    if (offset >= std::size(message) || message[offset] != ',') {
+      return {};
+    }
+    ++offset;
+  }
+  return {};
+}
 }  // namespace
 
 // === IMPLEMENTATION ===
@@ -47,6 +152,18 @@ bool WSAPIParser::dispatch(
       case utils::hash::FNV::compute(KEY_ERROR):
         result = dispatch_helper<WSAPIError>(handler, message, buffer_stack, trace_info);
         return true;
+      case utils::hash::FNV::compute(KEY_EVENT): {
+        // note! the event is an object and the user stream parser expects the raw text
+        auto user_data_event = UserDataEvent{
+            .message = find_object(message, KEY_EVENT),
+        };
+        if (std::empty(user_data_event.message)) {
+          break;
+        }
+        create_trace_and_dispatch(handler, trace_info, user_data_event);
+        result = true;
+        return true;
+      }
       case utils::hash::FNV::compute(KEY_ID): {
         auto value_2 = core::json::get<std::string_view>(value);
         if (!std::empty(value_2)) {
@@ -66,6 +183,9 @@ bool WSAPIParser::dispatch(
             case USER_DATA_STREAM_PING:
               // note! drop
               return false;
+            case USER_DATA_STREAM_SUBSCRIBE:
+              result = dispatch_helper<WSAPISubscribe>(handler, message, buffer_stack, trace_info);
+              return true;
             case ACCOUNT_BALANCE:
               result = dispatch_helper<WSAPIAccountBalance>(handler, message, buffer_stack, trace_info);
               return true;
@@ -93,6 +213,9 @@ bool WSAPIParser::dispatch(
             case ORDER_CANCEL:
               result = dispatch_helper<WSAPIOrderCancel>(handler, message, buffer_stack, trace_info, request);
               return true;
+            case ORDER_STATUS:
+              result = dispatch_helper<WSAPIOrderStatus>(handler, message, buffer_stack, trace_info, request);
+              return true;
           }
         }
         break;
@@ -20,7 +20,9 @@
 #include "roq/binance_futures/json/wsapi_order_cancel.hpp"
 #include "roq/binance_futures/json/wsapi_order_modify.hpp"
 #include "roq/binance_futures/json/wsapi_order_place.hpp"
+#include "roq/binance_futures/json/wsapi_order_status.hpp"
 #include "roq/binance_futures/json/wsapi_session_logon.hpp"
+#include "roq/binance_futures/json/wsapi_subscribe.hpp"
 #include "roq/binance_futures/json/wsapi_trades.hpp"
 
 namespace roq {
@@ -28,10 +30,17 @@ namespace binance_futures {
 namespace json {
 
 struct WSAPIParser final {
+  // note! user data stream event received on the ws-api session (the message should be dispatched by the user stream parser)
+  struct UserDataEvent final {
+    std::string_view message;
+  };
+
   struct Handler {
     virtual void operator()(Trace<WSAPIError> const &) = 0;
     virtual void operator()(Trace<WSAPISessionLogon> const &) = 0;
     virtual void operator()(Trace<WSAPIListenKey> const &) = 0;
+    virtual void operator()(Trace<WSAPISubscribe> const &) = 0;
+    virtual void operator()(Trace<UserDataEvent> const &) = 0;
     virtual void operator()(Trace<WSAPIAccountBalance> const &) = 0;
     virtual void operator()(Trace<WSAPIAccountStatus> const &) = 0;
     virtual void operator()(Trace<WSAPIAccountPosition> const &) = 0;
@@ -41,6 +50,7 @@ struct WSAPIParser final {
     virtual void operator()(Trace<WSAPIOrderPlace> const &, WSAPIRequest const &) = 0;
     virtual void operator()(Trace<WSAPIOrderModify> const &, WSAPIRequest const &) = 0;
     virtual void operator()(Trace<WSAPIOrderCancel> const &, WSAPIRequest const &) = 0;
+    virtual void operator()(Trace<WSAPIOrderStatus> const &, WSAPIRequest const &) = 0;
   };
 
   static bool dispatch(Handler &, std::string_view const &message, core::json::BufferStack &, TraceInfo const &, bool allow_unknown_event_types = false);
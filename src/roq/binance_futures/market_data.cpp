@@ -42,6 +42,9 @@ auto const SUPPORTS_SECONDARY = Mask{
 };
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 1;
+
+uint32_t const TIMER_REFRESH = 1;
+uint32_t const TIMER_SUBSCRIBE = 2;
 }  // namespace
 
 // === HELPERS ===
@@ -133,22 +136,39 @@ MarketData::MarketData(Handler &handler, io::Context &context, uint16_t stream_i
           .ping = create_metrics(shared.settings, name_, "ping"sv),
           .heartbeat = create_metrics(shared.settings, name_, "heartbeat"sv),
       },
-      shared_{shared} {
+      shared_{shared}, subscribe_queue_{{}, shared.get_request_retry()},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+          .subscribe = {shared.timer_wheel, *this, TIMER_SUBSCRIBE},
+      } {
 }
 
 void MarketData::operator()(Event<Start> const &) {
   (*connection_).start();
+  timer_.refresh.start(clock::get_system());
+  subscribe_queue_.attach(&timer_.subscribe);
 }
 
 void MarketData::operator()(Event<Stop> const &) {
+  subscribe_queue_.attach(nullptr);
+  timer_.subscribe.cancel();
+  timer_.refresh.stop();
   (*connection_).stop();
 }
 
-void MarketData::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
-  (*connection_).refresh(now);
-  if ((*connection_).ready()) {
-    check_subscribe_queue(now);
+// tools::TimerWheel::Handler
+
+void MarketData::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      (*connection_).refresh(now);
+      break;
+    case TIMER_SUBSCRIBE:
+      check_subscribe_queue(now);
+      break;
+    default:
+      assert(false);
   }
 }
 
@@ -181,10 +201,17 @@ void MarketData::subscribe(size_t start_from) {
 void MarketData::operator()(web::socket::Client::Connected const &) {
 }
 
+// note! pre-trade reference prices are stale once market data has been disconnected
 void MarketData::operator()(web::socket::Client::Disconnected const &) {
   ++counter_.disconnect;
   (*this)(ConnectionStatus::DISCONNECTED);
   subscribe_queue_.clear();
+  for (auto &symbol : shared_.symbols.get_slice(index_, 0)) {
+    auto instrument = shared_.find_instrument(symbol);
+    if (instrument) {
+      (*instrument).pre_trade.clear();
+    }
+  }
 }
 
 void MarketData::operator()(web::socket::Client::Ready const &) {
@@ -253,7 +280,7 @@ void MarketData::subscribe(std::span<Symbol const> const &symbols) {
   if (shared_.settings.download.time_series_lookback.count()) {
     subscribe(symbols, "kline_1m"sv);
     for (auto &symbol : symbols) {
-      shared_.time_series_request_queue.emplace_back(symbol);
+      shared_.time_series_request_queue.emplace_back(symbol, clock::get_system());
     }
   }
 }
@@ -271,7 +298,7 @@ void MarketData::subscribe(std::span<Symbol const> const &symbols, std::string_v
       fmt::join(symbols, separator),
       channel,
       id);
-  subscribe_queue_.emplace_back(message);
+  subscribe_queue_.emplace_back(message, clock::get_system());
 }
 
 void MarketData::parse(std::string_view const &message) {
@@ -391,6 +418,7 @@ void MarketData::operator()(Trace<json::BookTicker> const &event) {
     if (!instrument.tob_update(utils::safe_cast(book_ticker.order_book_update_id))) {
       return;
     }
+    instrument.pre_trade.update(book_ticker.best_bid_price, book_ticker.best_ask_price, book_ticker.order_book_update_id);
     auto top_of_book = TopOfBook{
         .stream_id = stream_id_,
         .exchange = shared_.settings.exchange,
@@ -481,14 +509,14 @@ void MarketData::operator()(Trace<json::DepthUpdate> const &event) {
         if (shared_.settings.ws.mbp_request_max_retries && shared_.settings.ws.mbp_request_max_retries < retries) {
           log::fatal(R"(Unexpected: symbol="{}", retries={})"sv, symbol, retries);
         }
-        shared_.depth_request_queue.emplace_back(symbol);
+        shared_.depth_request_queue.emplace_back(symbol, clock::get_system());
       };
       sequencer(mbp.bids, mbp.asks, first_sequence, last_sequence, previous_sequence, publish_update, publish_snapshot, request_snapshot);
     } catch (BadState &) {
       log::warn(R"(RESUBSCRIBE symbol="{}")"sv, symbol);
       // XXX FIXME publish stale
       sequencer.clear();
-      shared_.depth_request_queue.emplace_back(symbol);
+      shared_.depth_request_queue.emplace_back(symbol, clock::get_system());
     }
   });
 }
@@ -577,7 +605,12 @@ void MarketData::operator()(Trace<json::Kline> const &event) {
 
 // request
 
+// note! the timer is scheduled for when the next request is due (or when the connection could be ready)
 void MarketData::check_subscribe_queue(std::chrono::nanoseconds now) {
+  if (!(*connection_).ready()) {
+    timer_.subscribe.schedule(now + shared_.settings.misc.connection_refresh_freq);
+    return;
+  }
   subscribe_queue_.dispatch([&](auto now) { return shared_.rate_limiter.can_request(now); }, [&](auto &message) { (*connection_).send_text(message); }, now);
 }
 
@@ -8,8 +8,6 @@
 #include <utility>
 #include <vector>
 
-#include "roq/core/timer_queue.hpp"
-
 #include "roq/utils/metrics/counter.hpp"
 #include "roq/utils/metrics/latency.hpp"
 #include "roq/utils/metrics/profile.hpp"
@@ -26,12 +24,16 @@
 
 #include "roq/binance_futures/shared.hpp"
 
+#include "roq/binance_futures/tools/request_queue.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 #include "roq/binance_futures/json/market_stream_parser.hpp"
 
 namespace roq {
 namespace binance_futures {
 
-struct MarketData final : public web::socket::Client::Handler, public json::MarketStreamParser::Handler {
+struct MarketData final : public web::socket::Client::Handler, public json::MarketStreamParser::Handler, public tools::TimerWheel::Handler {
   struct Handler {
     virtual void operator()(Trace<StreamStatus> const &) = 0;
     virtual void operator()(Trace<ExternalLatency> const &) = 0;
@@ -50,7 +52,6 @@ struct MarketData final : public web::socket::Client::Handler, public json::Mark
 
   void operator()(Event<Start> const &);
   void operator()(Event<Stop> const &);
-  void operator()(Event<Timer> const &);
 
   void operator()(metrics::Writer &) const;
 
@@ -67,6 +68,10 @@ struct MarketData final : public web::socket::Client::Handler, public json::Mark
   void operator()(web::socket::Client::Text const &) override;
   void operator()(web::socket::Client::Binary const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
  private:
   void operator()(ConnectionStatus);
 
@@ -115,7 +120,12 @@ struct MarketData final : public web::socket::Client::Handler, public json::Mark
   // state
   ConnectionStatus status_ = {};
   // queue
-  core::TimerQueue<std::string> subscribe_queue_;
+  tools::RequestQueue<std::string> subscribe_queue_;
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+    tools::TimerWheel::Timer subscribe;
+  } timer_;
 };
 
 }  // namespace binance_futures
@@ -20,7 +20,6 @@ struct OrderEntry {
 
   virtual void operator()(Event<Start> const &) = 0;
   virtual void operator()(Event<Stop> const &) = 0;
-  virtual void operator()(Event<Timer> const &) = 0;
 
   virtual void operator()(metrics::Writer &) const = 0;
 
@@ -31,6 +30,9 @@ struct OrderEntry {
       Event<CancelOrder> const &, server::oms::Order const &, std::string_view const &request_id, std::string_view const &previous_request_id) = 0;
 
   virtual uint16_t operator()(Event<CancelAllOrders> const &, std::string_view const &request_id) = 0;
+
+  virtual uint16_t operator()(Event<MassQuote> const &) = 0;
+  virtual uint16_t operator()(Event<CancelQuotes> const &) = 0;
 };
 
 }  // namespace binance_futures
@@ -12,6 +12,7 @@
 #include "roq/utils/update.hpp"
 
 #include "roq/utils/charconv/from_chars.hpp"
+#include "roq/utils/charconv/to_string.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
 
@@ -36,17 +37,25 @@ auto const SUPPORTS = Mask{
     SupportType::CREATE_ORDER,
     SupportType::MODIFY_ORDER,
     SupportType::CANCEL_ORDER,
+    SupportType::MASS_QUOTE,
+    SupportType::CANCEL_QUOTES,
     SupportType::ORDER_ACK,
     SupportType::FUNDS,
     SupportType::POSITION,
 };
 
 auto const X_MBX_USED_WEIGHT_1M = "x-mbx-used-weight-1m"sv;
+auto const X_MBX_ORDER_COUNT_10S = "x-mbx-order-count-10s"sv;
 auto const X_MBX_ORDER_COUNT_1M = "x-mbx-order-count-1m"sv;
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 1;
 
 size_t const DOWNLOAD_TRADES_LIMIT = 1000;
+uint32_t const USER_TRADES_WEIGHT = 5;
+
+uint32_t const TIMER_REFRESH = 1;
+uint32_t const TIMER_LISTEN_KEY = 2;
+uint32_t const TIMER_COUNTDOWN = 3;
 }  // namespace
 
 // === HELPERS ===
@@ -101,6 +110,12 @@ auto get_download_trades_lookback(auto &settings, auto download_trades_is_first)
   return settings.download.trades_lookback;
 }
 
+// note! unique per session (client order ids must be unique)
+auto create_quote_prefix(auto stream_id) {
+  auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+  return fmt::format("q{}-{}-"sv, now_utc.count(), stream_id);
+}
+
 auto get_retry_after(auto &response) {
   std::chrono::nanoseconds result = {};
   response.dispatch(web::http::Header::RETRY_AFTER, [&](auto &value) {
@@ -118,11 +133,15 @@ auto get_retry_after(auto &response) {
 
 // === IMPLEMENTATION ===
 
-OrderEntryClassic::OrderEntryClassic(Handler &handler, io::Context &context, uint16_t stream_id, Account &account, Shared &shared, Request &request)
-    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_, account.name)}, connection_{create_connection(*this, shared.settings, context)},
+OrderEntryClassic::OrderEntryClassic(
+    Handler &handler, io::Context &context, uint16_t stream_id, Account &account, Shared &shared, Request &request, bool master)
+    : handler_{handler}, stream_id_{stream_id}, name_{create_name(stream_id_, account.name)}, master_{master},
+      connection_{create_connection(*this, shared.settings, context)},
       decode_buffer_{shared.settings.misc.decode_buffer_size, MAX_DECODE_BUFFER_DEPTH},
       counter_{
           .disconnect = create_metrics(shared.settings, name_, "disconnect"sv),
+          .batch_orders_reject = create_metrics(shared.settings, name_, "batch_orders_reject"sv),
+          .batch_orders_error = create_metrics(shared.settings, name_, "batch_orders_error"sv),
       },
       profile_{
           .listen_key = create_metrics(shared.settings, name_, "listen_key"sv),
@@ -145,34 +164,77 @@ OrderEntryClassic::OrderEntryClassic(Handler &handler, io::Context &context, uin
           .open_orders_cancel_all_ack = create_metrics(shared.settings, name_, "open_orders_cancel_all_ack"sv),
           .countdown_cancel_all = create_metrics(shared.settings, name_, "countdown_cancel_all"sv),
           .countdown_cancel_all_ack = create_metrics(shared.settings, name_, "countdown_cancel_all_ack"sv),
+          .mass_quote = create_metrics(shared.settings, name_, "mass_quote"sv),
+          .cancel_quotes = create_metrics(shared.settings, name_, "cancel_quotes"sv),
+          .batch_orders_place = create_metrics(shared.settings, name_, "batch_orders_place"sv),
+          .batch_orders_cancel = create_metrics(shared.settings, name_, "batch_orders_cancel"sv),
+          .batch_orders_ack = create_metrics(shared.settings, name_, "batch_orders_ack"sv),
       },
       latency_{
           .ping = create_metrics(shared.settings, name_, "ping"sv),
+          .order_place_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_place"sv),
+          .order_modify_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_modify"sv),
+          .order_cancel_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_cancel"sv),
       },
       rate_limiter_{
           .request_weight_1m = create_metrics(shared.settings, name_, "request_weight"sv, "1m"sv),
           .create_order_1m = create_metrics(shared.settings, name_, "create_order"sv, "1m"sv),
       },
-      account_{account}, shared_{shared}, request_{request}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }} {
+      account_{account}, shared_{shared}, request_{request}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+          .listen_key = {shared.timer_wheel, *this, TIMER_LISTEN_KEY},
+          .countdown = {shared.timer_wheel, *this, TIMER_COUNTDOWN},
+      },
+      quote_prefix_{create_quote_prefix(stream_id_)} {
+  log::info<5>(R"(stream_id={}, account="{}", master={})"sv, stream_id_, account_.name, master_);
 }
 
 void OrderEntryClassic::operator()(Event<Start> const &) {
   (*connection_).start();
+  auto now = clock::get_system();
+  timer_.refresh.start(now);
+  if (shared_.settings.rest.cancel_on_disconnect && shared_.settings.rest.order_countdown.count() != 0) {
+    timer_.countdown.schedule(now);
+  }
 }
 
 void OrderEntryClassic::operator()(Event<Stop> const &) {
+  timer_.refresh.stop();
+  timer_.listen_key.cancel();
+  timer_.countdown.cancel();
   (*connection_).stop();
 }
 
-void OrderEntryClassic::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
+// tools::TimerWheel::Handler
+
+void OrderEntryClassic::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      refresh(now);
+      break;
+    case TIMER_LISTEN_KEY:
+      refresh_listen_key(now);
+      break;
+    case TIMER_COUNTDOWN:
+      countdown_cancel_all();
+      timer_.countdown.schedule(now + shared_.settings.rest.order_countdown / 4);
+      break;
+    default:
+      assert(false);
+  }
+}
+
+void OrderEntryClassic::refresh(std::chrono::nanoseconds now) {
   (*connection_).refresh(now);
-  refresh_listen_key();
-  if (shared_.settings.rest.cancel_on_disconnect && shared_.settings.rest.order_countdown.count() != 0 && next_auto_cancel_ < now) {
-    next_auto_cancel_ = now + shared_.settings.rest.order_countdown / 4;
-    countdown_cancel_all();
+  if (ready() && download_trades_ && !download_trades_in_flight_) {
+    get_trades_next();  // note! resume when the request weight budget allows
   }
-  if (ready() && !downloading()) {
+  if (ready()) {
+    retry_quote_cancels(now);
+  }
+  if (master_ && ready() && !downloading()) {
     if (!downloading() && request_.respond_balance < request_.request_balance) {
       log::info<1>("Download balance..."sv);
       get_account_balance();
@@ -190,8 +252,8 @@ void OrderEntryClassic::operator()(Event<Timer> const &event) {
     }
     if (!downloading() && request_.respond_trades < request_.request_trades) {
       log::info<1>("Download trades..."sv);
-      get_trades();
       download_trades_ = true;
+      get_trades();
     }
   }
 }
@@ -200,6 +262,8 @@ void OrderEntryClassic::operator()(metrics::Writer &writer) const {
   writer
       // counter
       .write(counter_.disconnect, metrics::Type::COUNTER)
+      .write(counter_.batch_orders_reject, metrics::Type::COUNTER)
+      .write(counter_.batch_orders_error, metrics::Type::COUNTER)
       // profile
       .write(profile_.listen_key, metrics::Type::PROFILE)
       .write(profile_.listen_key_ack, metrics::Type::PROFILE)
@@ -221,8 +285,16 @@ void OrderEntryClassic::operator()(metrics::Writer &writer) const {
       .write(profile_.open_orders_cancel_all_ack, metrics::Type::PROFILE)
       .write(profile_.countdown_cancel_all, metrics::Type::PROFILE)
       .write(profile_.countdown_cancel_all_ack, metrics::Type::PROFILE)
+      .write(profile_.mass_quote, metrics::Type::PROFILE)
+      .write(profile_.cancel_quotes, metrics::Type::PROFILE)
+      .write(profile_.batch_orders_place, metrics::Type::PROFILE)
+      .write(profile_.batch_orders_cancel, metrics::Type::PROFILE)
+      .write(profile_.batch_orders_ack, metrics::Type::PROFILE)
       // latency
       .write(latency_.ping, metrics::Type::LATENCY)
+      .write(latency_.order_place_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_modify_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_cancel_round_trip, metrics::Type::LATENCY)
       // rate limiter
       .write(rate_limiter_.request_weight_1m, metrics::Type::RATE_LIMITER)
       .write(rate_limiter_.create_order_1m, metrics::Type::RATE_LIMITER);
@@ -250,6 +322,23 @@ uint16_t OrderEntryClassic::operator()(Event<CancelAllOrders> const &event, std:
   return stream_id_;
 }
 
+// note! leg order updates and batch rejects can not be reported to the order management system
+uint16_t OrderEntryClassic::operator()(Event<MassQuote> const &event) {
+  if (!shared_.settings.rest.mass_quote) {
+    throw server::oms::NotSupported{"not supported"sv};
+  }
+  mass_quote(event);
+  return stream_id_;
+}
+
+uint16_t OrderEntryClassic::operator()(Event<CancelQuotes> const &event) {
+  if (!shared_.settings.rest.mass_quote) {
+    throw server::oms::NotSupported{"not supported"sv};
+  }
+  cancel_quotes(event);
+  return stream_id_;
+}
+
 void OrderEntryClassic::operator()(Trace<web::rest::Client::Connected> const &) {
   if (download_.downloading()) {
     download_.bump();
@@ -269,6 +358,8 @@ void OrderEntryClassic::operator()(Trace<web::rest::Client::Disconnected> const
   download_account_ = false;
   download_orders_ = false;
   download_trades_ = false;
+  download_trades_in_flight_ = false;
+  trade_download_.reset();
 }
 
 void OrderEntryClassic::operator()(Trace<web::rest::Client::Latency> const &event) {
@@ -280,6 +371,7 @@ void OrderEntryClassic::operator()(Trace<web::rest::Client::Latency> const &even
   };
   create_trace_and_dispatch(handler_, trace_info, external_latency);
   latency_.ping.update(latency.sample);
+  round_trip_.update(latency.sample);
 }
 
 void OrderEntryClassic::operator()(Trace<web::rest::Client::MessageBegin> const &) {
@@ -300,6 +392,23 @@ void OrderEntryClassic::operator()(Trace<web::rest::Client::Header> const &event
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.request_weight_1m.set(value);
+      shared_.download_governor.sync(1min, shared_.limits.request_weight_1m, value, clock::get_system());
+    } catch (RuntimeError &) {
+      log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
+    }
+  }
+  if (utils::case_insensitive_compare(header.name, X_MBX_ORDER_COUNT_10S) == 0) {
+    try {
+      auto value = utils::charconv::from_string_relaxed<uint32_t>(header.value);
+      auto rate_limit = RateLimit{
+          .type = RateLimitType::CREATE_ORDER,
+          .period = 10s,
+          .end_time_utc = {},
+          .limit = shared_.limits.create_order_10s,
+          .value = value,
+      };
+      shared_.rate_limits.emplace_back(rate_limit);
+      account_.governor.sync(10s, shared_.limits.create_order_10s, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -316,6 +425,7 @@ void OrderEntryClassic::operator()(Trace<web::rest::Client::Header> const &event
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.create_order_1m.set(value);
+      account_.governor.sync(1min, shared_.limits.create_order_1m, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -439,6 +549,7 @@ void OrderEntryClassic::operator()(Trace<json::ListenKeyAck> const &event) {
   }
   auto now = clock::get_system();
   listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+  timer_.listen_key.schedule(listen_key_refresh_);
 }
 
 // account-balance
@@ -503,6 +614,7 @@ void OrderEntryClassic::operator()(Trace<json::AccountBalanceAck> const &event)
         .exchange_time_utc = item.update_time,
         .sending_time_utc = {},
     };
+    request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
     create_trace_and_dispatch(handler_, trace_info, funds_update, true);
     if (!std::isnan(item.cross_wallet_balance)) {
       auto funds_update = FundsUpdate{
@@ -518,6 +630,7 @@ void OrderEntryClassic::operator()(Trace<json::AccountBalanceAck> const &event)
           .exchange_time_utc = item.update_time,
           .sending_time_utc = {},
       };
+      request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
       create_trace_and_dispatch(handler_, trace_info, funds_update, true);
     }
   }
@@ -590,6 +703,13 @@ void OrderEntryClassic::operator()(Trace<json::AccountStatusAck> const &event) {
         .exchange_time_utc = account_status_ack.update_time,
         .sending_time_utc = {},
     };
+    auto hedged = !std::empty(item.position_side) && item.position_side != "BOTH"sv;
+    // note! older than the last fill (the position published from fills is more recent)
+    if (!request_.position_keeper.reconcile(item.symbol, margin_mode, item.position_amt, item.update_time, hedged) && shared_.settings.ws.position_from_fills) {
+      log::info<3>(R"(Drop position update (older than the last fill): symbol="{}")"sv, item.symbol);
+      continue;
+    }
+    request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity);
     create_trace_and_dispatch(handler_, trace_info, position_update, true);
   }
 }
@@ -646,7 +766,8 @@ void OrderEntryClassic::operator()(Trace<json::OpenOrdersAck> const &event) {
       continue;
     }
     open_orders_symbols_.emplace(item.symbol);
-    auto external_order_id = fmt::format("{}"sv, item.order_id);  // alloc
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), item.order_id);
     auto order_update = server::oms::OrderUpdate{
         .account = account_.name,
         .exchange = shared_.settings.exchange,
@@ -684,60 +805,90 @@ void OrderEntryClassic::operator()(Trace<json::OpenOrdersAck> const &event) {
     Trace event_2{trace_info, order_update};
     (*this)(event_2, item.client_order_id);
   }
+  shared_.reconcile_order_state(account_.name, open_orders_ack.data);
 }
 
 // trades
 
-// XXX FIXME download_trades_count
+// note! one symbol (and one page) at a time, resuming from the last seen trade id
 void OrderEntryClassic::get_trades() {
+  trade_download_.begin(shared_.settings.download.symbols, clock::get_system());
+  get_trades_next();
+}
+
+void OrderEntryClassic::get_trades_next() {
+  auto &trade_cursor = request_.trade_cursor;
+  if (!trade_download_.downloading()) {
+    log::info<1>("Download user-trades has COMPLETED!"sv);
+    trade_cursor.downloaded(trade_download_.start());
+    trade_cursor.save();
+    request_.respond_trades = clock::get_system();  // completion
+    download_trades_ = false;
+    download_trades_is_first_ = false;
+    return;
+  }
+  if (!shared_.download_governor(clock::get_system(), USER_TRADES_WEIGHT)) {
+    log::info<3>("Download user-trades is waiting for request weight budget..."sv);
+    return;  // note! retried from refresh
+  }
   profile_.trades([&]() {
-    auto &symbols = shared_.settings.download.symbols;
-    for (auto &symbol : symbols) {
+    auto symbol = trade_download_.current();
+    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
+    auto limit = shared_.settings.download.trades_limit ? shared_.settings.download.trades_limit : DOWNLOAD_TRADES_LIMIT;
+    std::string_view body;
+    if (auto trade_id = trade_cursor.get(symbol); trade_id) {
+      log::info<1>(R"(Download trades: symbol="{}", from_id={})"sv, symbol, trade_id + 1);
+      body = json::Encoder::user_trades_from_id_url(encode_buffer_, symbol, trade_id + 1, limit, recv_window);
+    } else {
+      // note! fall back to the lookback window if we haven't seen any trades for this symbol
       auto lookback = get_download_trades_lookback(shared_.settings, download_trades_is_first_);
-      log::info<1>("Download trades: lookback={}"sv, lookback);
-      auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
+      log::info<1>(R"(Download trades: symbol="{}", lookback={})"sv, symbol, lookback);
       auto end_time = clock::get_realtime<std::chrono::milliseconds>();
       auto start_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - lookback);
-      auto limit = shared_.settings.download.trades_limit ? shared_.settings.download.trades_limit : DOWNLOAD_TRADES_LIMIT;
-      auto body = json::Encoder::user_trades_url(encode_buffer_, symbol, start_time, end_time, limit, recv_window);
-      auto query = account_.create_rest_signature_query(body);
-      auto headers = account_.get_rest_headers();
-      auto request = web::rest::Request{
-          .method = web::http::Method::GET,
-          .path = shared_.api.simple.user_trades,
-          .query = query,
-          .accept = web::http::Accept::APPLICATION_JSON,
-          .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
-          .headers = headers,
-          .body = {},  // body,
-          .quality_of_service = {},
-      };
-      auto callback = [this]([[maybe_unused]] auto &request_id, auto &response) {
-        TraceInfo trace_info;
-        Trace event{trace_info, response};
-        get_trades_ack(event);
-      };
-      (*connection_)("user-trades"sv, request, callback);
+      body = json::Encoder::user_trades_url(encode_buffer_, symbol, start_time, end_time, limit, recv_window);
     }
+    auto query = account_.create_rest_signature_query(body);
+    auto headers = account_.get_rest_headers();
+    auto request = web::rest::Request{
+        .method = web::http::Method::GET,
+        .path = shared_.api.simple.user_trades,
+        .query = query,
+        .accept = web::http::Accept::APPLICATION_JSON,
+        .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
+        .headers = headers,
+        .body = {},  // body,
+        .quality_of_service = {},
+    };
+    auto callback = [this, limit]([[maybe_unused]] auto &request_id, auto &response) {
+      TraceInfo trace_info;
+      Trace event{trace_info, response};
+      get_trades_ack(event, limit);
+    };
+    (*connection_)("user-trades"sv, request, callback);
+    download_trades_in_flight_ = true;
   });
 }
 
-void OrderEntryClassic::get_trades_ack(Trace<web::rest::Response> const &event) {
+void OrderEntryClassic::get_trades_ack(Trace<web::rest::Response> const &event, uint32_t limit) {
+  download_trades_in_flight_ = false;
   profile_.trades_ack([&]() {
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
       log::warn(R"(account="{}", origin={}, error={}, status={}, text="{}")"sv, account_.name, origin, error, status, text);
+      trade_download_.reset();
       download_trades_ = false;
     };
     auto handle_success = [&](auto &body) {
       json::TradesAck trades_ack{body, decode_buffer_};
       Trace event_2{event, trades_ack};
       (*this)(event_2);
-      request_.respond_trades = clock::get_system();  // completion
-      download_trades_ = false;
-      download_trades_is_first_ = false;
+      auto more = std::size(trades_ack.data) >= limit;  // note! a full page means there could be more
+      trade_download_.next(more);
     };
     process_response(event, handle_error, handle_success);
   });
+  if (download_trades_) {
+    get_trades_next();
+  }
 }
 
 // note! always external because we don't get ClOrdID
@@ -746,6 +897,7 @@ void OrderEntryClassic::operator()(Trace<json::TradesAck> const &event) {
   log::info<2>("trades_ack={}"sv, trades_ack);
   for (auto &item : trades_ack.data) {
     log::info<2>("item={}"sv, item);
+    request_.trade_cursor.update(item.symbol, item.id);
     auto liquidity = item.maker ? Liquidity::MAKER : Liquidity::TAKER;
     auto side = map(item.side).template get<Side>();
     auto ref_data = shared_.get_ref_data(shared_.settings.exchange, item.symbol);
@@ -793,16 +945,16 @@ void OrderEntryClassic::operator()(Trace<json::TradesAck> const &event) {
 
 // ...
 
-void OrderEntryClassic::refresh_listen_key() {
+void OrderEntryClassic::refresh_listen_key(std::chrono::nanoseconds now) {
   if (!ready()) {
-    return;
+    return;  // note! re-scheduled when the listen key is acquired after reconnect
   }
-  auto now = clock::get_system();
   if (listen_key_refresh_.count() == 0 || now < listen_key_refresh_) {
     return;
   }
   log::info("Refreshing listen key..."sv);
   listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+  timer_.listen_key.schedule(listen_key_refresh_);
   get_listen_key();
 }
 
@@ -815,27 +967,30 @@ void OrderEntryClassic::order_place(Event<CreateOrder> const &event, server::oms
     }
     auto &[message_info, create_order] = event;
     open_orders_symbols_.emplace(create_order.symbol);
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body = json::Encoder::order_place_url(encode_buffer_, create_order, order, request_id, recv_window);
-    auto query = account_.create_rest_signature_body(body);
+    auto recv_window = shared_.get_order_recv_window();
+    auto params = json::Encoder::order_place_url(encode_buffer_, shared_.order_templates, create_order, order, request_id, recv_window);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::POST,
         .path = shared_.api.simple.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = create_order.order_id]([[maybe_unused]] auto &request_id, auto &response) {
+    auto callback = [this, user_id = message_info.source, order_id = create_order.order_id, start = clock::get_system()](
+                        [[maybe_unused]] auto &request_id, auto &response) {
+      update_round_trip(latency_.order_place_round_trip, start);
       uint32_t version = 1;
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_place_ack(event, user_id, order_id, version);
     };
     (*connection_)(request_id, request, callback);
+    shared_.order_latency.begin({.user_id = message_info.source, .order_id = create_order.order_id}, clock::get_system());
   });
 }
 
@@ -868,7 +1023,8 @@ void OrderEntryClassic::order_place_ack(Trace<web::rest::Response> const &event,
 void OrderEntryClassic::operator()(Trace<json::OrderPlaceAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_place_ack] = event;
   log::info<2>("order_place_ack={}, user_id={}, order_id={}, version={}"sv, order_place_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_place_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_place_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::CREATE_ORDER,
       .origin = Origin::EXCHANGE,
@@ -932,23 +1088,24 @@ void OrderEntryClassic::order_modify(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, modify_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body =
+    auto recv_window = shared_.get_order_recv_window();
+    auto params =
         json::Encoder::order_modify_url(encode_buffer_, modify_order, order, request_id, previous_request_id, recv_window, shared_.api.modify_order_full);
-    auto query = account_.create_rest_signature_body(body);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::PUT,
         .path = shared_.api.simple.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = modify_order.order_id, version = modify_order.version](
+    auto callback = [this, user_id = message_info.source, order_id = modify_order.order_id, version = modify_order.version, start = clock::get_system()](
                         [[maybe_unused]] auto &request_id, auto &response) {
+      update_round_trip(latency_.order_modify_round_trip, start);
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_modify_ack(event, user_id, order_id, version);
@@ -986,7 +1143,8 @@ void OrderEntryClassic::order_modify_ack(Trace<web::rest::Response> const &event
 void OrderEntryClassic::operator()(Trace<json::OrderModifyAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_modify_ack] = event;
   log::info<2>("order_modify_ack={}, user_id={}, order_id={}, version={}"sv, order_modify_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_modify_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_modify_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::MODIFY_ORDER,
       .origin = Origin::EXCHANGE,
@@ -1050,22 +1208,23 @@ void OrderEntryClassic::order_cancel(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, cancel_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body = json::Encoder::order_cancel_url(encode_buffer_, cancel_order, order, request_id, previous_request_id, recv_window);
-    auto query = account_.create_rest_signature_body(body);
+    auto recv_window = shared_.get_order_recv_window();
+    auto params = json::Encoder::order_cancel_url(encode_buffer_, cancel_order, order, request_id, previous_request_id, recv_window);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::DELETE,
         .path = shared_.api.simple.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = cancel_order.order_id, version = cancel_order.version](
+    auto callback = [this, user_id = message_info.source, order_id = cancel_order.order_id, version = cancel_order.version, start = clock::get_system()](
                         [[maybe_unused]] auto &request_id, auto &response) {
+      update_round_trip(latency_.order_cancel_round_trip, start);
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_cancel_ack(event, user_id, order_id, version);
@@ -1103,7 +1262,8 @@ void OrderEntryClassic::order_cancel_ack(Trace<web::rest::Response> const &event
 void OrderEntryClassic::operator()(Trace<json::OrderCancelAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_cancel_ack] = event;
   log::info<2>("order_cancel_ack={}, user_id={}, order_id={}, version={}"sv, order_cancel_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_cancel_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_cancel_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::CANCEL_ORDER,
       .origin = Origin::EXCHANGE,
@@ -1168,13 +1328,13 @@ void OrderEntryClassic::open_orders_cancel_all(Event<CancelAllOrders> const &eve
       if (!std::empty(cancel_all_orders.symbol) && symbol != cancel_all_orders.symbol) {
         continue;
       }
-      auto body = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
-      auto query = account_.create_rest_signature_body(body);
+      auto params = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
       auto headers = account_.get_rest_headers();
       auto request = web::rest::Request{
           .method = web::http::Method::DELETE,
           .path = shared_.api.simple.all_open_orders,
-          .query = query,
+          .query = {},
           .accept = web::http::Accept::APPLICATION_JSON,
           .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
           .headers = headers,
@@ -1264,13 +1424,13 @@ void OrderEntryClassic::countdown_cancel_all() {
     for (auto &symbol : open_orders_symbols_) {
       auto countdown_time = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_countdown);
       auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-      auto body = json::Encoder::countdown_cancel_open_orders_url(encode_buffer_, symbol, countdown_time, recv_window);
-      auto query = account_.create_rest_signature_body(body);
+      auto params = json::Encoder::countdown_cancel_open_orders_url(encode_buffer_, symbol, countdown_time, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
       auto headers = account_.get_rest_headers();
       auto request = web::rest::Request{
           .method = web::http::Method::POST,
           .path = shared_.api.simple.countdown_cancel_all,
-          .query = query,
+          .query = {},
           .accept = web::http::Accept::APPLICATION_JSON,
           .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
           .headers = headers,
@@ -1306,6 +1466,279 @@ void OrderEntryClassic::operator()(Trace<json::CountdownCancelAllAck> const &eve
   log::info<2>("countdown_cancel_all_ack={}"sv, countdown_cancel_all_ack);
 }
 
+// mass-quote
+
+// note! previous legs are cancelled and new legs are placed, both using batches
+// note! previous legs are tracked until the exchange has acknowledged the cancel (retried from the refresh timer)
+// note! new legs are only placed when all previous legs have been cancelled (avoids double exposure)
+// note! a new quote replaces new legs which have not yet been placed
+void OrderEntryClassic::mass_quote(Event<MassQuote> const &event) {
+  profile_.mass_quote([&]() {
+    if (!ready()) {
+      throw server::oms::NotReady{"not ready"sv};
+    }
+    auto &[message_info, mass_quote] = event;
+    auto now = clock::get_system();
+    auto recv_window = shared_.get_order_recv_window();
+    for (auto &quote : mass_quote.quotes) {
+      open_orders_symbols_.emplace(quote.symbol);
+      quote_cancels_.clear();
+      auto callback = [&](auto &client_order_id) { quote_cancels_.emplace_back() = client_order_id; };
+      request_.quote_legs.cancel(quote.symbol, now, shared_.settings.rest.request_timeout, callback);
+      batch_orders_cancel(quote.symbol, quote_cancels_, recv_window);
+      auto instrument = shared_.find_instrument(quote.symbol);
+      auto quantity_precision = instrument ? (*instrument).quantity_precision : Precision{};
+      auto price_precision = instrument ? (*instrument).price_precision : Precision{};
+      auto iter = pending_quotes_.find(quote.symbol);
+      if (iter == std::end(pending_quotes_)) {
+        iter = pending_quotes_.emplace(quote.symbol, PendingQuote{}).first;
+      }
+      auto &symbol = (*iter).first;  // note! legs reference the map key
+      auto &pending_quote = (*iter).second;
+      if (!std::empty(pending_quote.legs)) {
+        log::warn(R"(Replacing pending quote: symbol="{}", size={})"sv, symbol, std::size(pending_quote.legs));
+      }
+      pending_quote.user_id = message_info.source;
+      pending_quote.client_order_ids.clear();
+      pending_quote.client_order_ids.reserve(std::size(quote.bids) + std::size(quote.asks));  // note! legs reference the client order ids
+      pending_quote.legs.clear();
+      auto helper = [&](auto side, auto &levels) {
+        for (auto &level : levels) {
+          auto &client_order_id = pending_quote.client_order_ids.emplace_back();
+          fmt::format_to(std::back_inserter(client_order_id), "{}{}"sv, quote_prefix_, ++quote_sequence_);
+          auto leg = json::Encoder::QuoteLeg{
+              .symbol = symbol,
+              .side = side,
+              .quantity = level.quantity,
+              .price = level.price,
+              .client_order_id = client_order_id,
+              .quantity_precision = quantity_precision,
+              .price_precision = price_precision,
+          };
+          pending_quote.legs.emplace_back(leg);
+        }
+      };
+      helper(Side::BUY, quote.bids);
+      helper(Side::SELL, quote.asks);
+      place_quote(symbol);
+    }
+  });
+}
+
+void OrderEntryClassic::cancel_quotes(Event<CancelQuotes> const &) {
+  profile_.cancel_quotes([&]() {
+    if (!ready()) {
+      throw server::oms::NotReady{"not ready"sv};
+    }
+    auto now = clock::get_system();
+    auto recv_window = shared_.get_order_recv_window();
+    for (auto &[_, pending_quote] : pending_quotes_) {
+      pending_quote.legs.clear();
+    }
+    request_.quote_legs.get_symbols([&](auto &symbol) {
+      quote_cancels_.clear();
+      auto callback = [&](auto &client_order_id) { quote_cancels_.emplace_back() = client_order_id; };
+      request_.quote_legs.cancel(symbol, now, shared_.settings.rest.request_timeout, callback);
+      batch_orders_cancel(symbol, quote_cancels_, recv_window);
+    });
+  });
+}
+
+// note! cancels which have not been acknowledged are sent again
+void OrderEntryClassic::retry_quote_cancels(std::chrono::nanoseconds now) {
+  auto recv_window = shared_.get_order_recv_window();
+  request_.quote_legs.get_symbols([&](auto &symbol) {
+    quote_cancels_.clear();
+    auto callback = [&](auto &client_order_id) { quote_cancels_.emplace_back() = client_order_id; };
+    request_.quote_legs.retry(symbol, now, shared_.settings.rest.request_timeout, callback);
+    if (!std::empty(quote_cancels_)) {
+      log::warn(R"(Retry quote cancel: symbol="{}", size={})"sv, symbol, std::size(quote_cancels_));
+      batch_orders_cancel(symbol, quote_cancels_, recv_window);
+    }
+  });
+  for (auto &[symbol, _] : pending_quotes_) {
+    place_quote(symbol);  // note! legs may have been removed by the user stream
+  }
+}
+
+// note! the legs are only known to the quote legs tracker once they're placed
+void OrderEntryClassic::place_quote(std::string_view const &symbol) {
+  auto iter = pending_quotes_.find(symbol);
+  if (iter == std::end(pending_quotes_)) {
+    return;
+  }
+  auto &[symbol_2, pending_quote] = *iter;
+  if (std::empty(pending_quote.legs) || request_.quote_legs.cancelling(symbol_2)) {
+    return;
+  }
+  if (!ready()) {
+    log::warn(R"(Dropping pending quote: symbol="{}", size={})"sv, symbol_2, std::size(pending_quote.legs));
+    pending_quote.legs.clear();
+    return;
+  }
+  for (auto &leg : pending_quote.legs) {
+    request_.quote_legs.add(symbol_2, leg.client_order_id, pending_quote.user_id);
+  }
+  batch_orders_place(pending_quote.legs, shared_.get_order_recv_window());
+  pending_quote.legs.clear();
+}
+
+// batch-orders
+
+// note! the client order ids are captured because error items can only be matched by position
+void OrderEntryClassic::batch_orders_place(std::span<json::Encoder::QuoteLeg const> const &legs, std::chrono::milliseconds recv_window) {
+  profile_.batch_orders_place([&]() {
+    auto max_size = std::max<size_t>(shared_.settings.rest.batch_orders_max_size, 1);
+    for (size_t offset = 0; offset < std::size(legs); offset += max_size) {
+      auto batch = legs.subspan(offset, std::min(max_size, std::size(legs) - offset));
+      auto params = json::Encoder::batch_orders_place_url(encode_buffer_, batch, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
+      auto headers = account_.get_rest_headers();
+      auto request = web::rest::Request{
+          .method = web::http::Method::POST,
+          .path = shared_.api.simple.batch_orders,
+          .query = {},
+          .accept = web::http::Accept::APPLICATION_JSON,
+          .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
+          .headers = headers,
+          .body = body,
+          .quality_of_service = io::QualityOfService::IMMEDIATE,
+      };
+      std::vector<ClientOrderId> client_order_ids;
+      client_order_ids.reserve(std::size(batch));
+      for (auto &leg : batch) {
+        client_order_ids.emplace_back() = leg.client_order_id;
+      }
+      auto callback = [this, symbol = std::string{batch.front().symbol}, client_order_ids = std::move(client_order_ids)](
+                          [[maybe_unused]] auto &request_id, auto &response) {
+        TraceInfo trace_info;
+        Trace event{trace_info, response};
+        batch_orders_ack(event, symbol, client_order_ids, false);
+      };
+      (*connection_)("batch-orders"sv, request, callback);
+    }
+  });
+}
+
+void OrderEntryClassic::batch_orders_cancel(
+    std::string_view const &symbol, std::span<ClientOrderId const> const &client_order_ids, std::chrono::milliseconds recv_window) {
+  profile_.batch_orders_cancel([&]() {
+    auto max_size = std::max<size_t>(shared_.settings.rest.batch_cancel_max_size, 1);
+    for (size_t offset = 0; offset < std::size(client_order_ids); offset += max_size) {
+      auto batch = client_order_ids.subspan(offset, std::min(max_size, std::size(client_order_ids) - offset));
+      auto params = json::Encoder::batch_orders_cancel_url(encode_buffer_, symbol, batch, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
+      auto headers = account_.get_rest_headers();
+      auto request = web::rest::Request{
+          .method = web::http::Method::DELETE,
+          .path = shared_.api.simple.batch_orders,
+          .query = {},
+          .accept = web::http::Accept::APPLICATION_JSON,
+          .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
+          .headers = headers,
+          .body = body,
+          .quality_of_service = io::QualityOfService::IMMEDIATE,
+      };
+      auto callback = [this, symbol = std::string{symbol}, client_order_ids = std::vector<ClientOrderId>{std::begin(batch), std::end(batch)}](
+                          [[maybe_unused]] auto &request_id, auto &response) {
+        TraceInfo trace_info;
+        Trace event{trace_info, response};
+        batch_orders_ack(event, symbol, client_order_ids, true);
+      };
+      (*connection_)("batch-orders"sv, request, callback);
+    }
+  });
+}
+
+// note! a failed cancel is retried (the legs are still tracked), a failed place is cancelled (the legs may have reached the exchange)
+void OrderEntryClassic::batch_orders_ack(
+    Trace<web::rest::Response> const &event, std::string_view const &symbol, std::span<ClientOrderId const> const &client_order_ids, bool cancel) {
+  profile_.batch_orders_ack([&]() {
+    auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
+      ++counter_.batch_orders_error;
+      log::warn(R"(origin={}, error={}, status={}, text="{}", symbol="{}", cancel={})"sv, origin, error, status, text, symbol, cancel);
+      if (!cancel && ready()) {
+        batch_orders_cancel(symbol, client_order_ids, shared_.get_order_recv_window());
+      }
+    };
+    auto handle_success = [&](auto &body) {
+      json::BatchOrdersAck batch_orders_ack{body, decode_buffer_};
+      Trace event_2{event, batch_orders_ack};
+      (*this)(event_2, symbol, client_order_ids, cancel);
+    };
+    process_response(event, handle_error, handle_success);
+  });
+}
+
+// note! one item per leg (same order as the request), either an order or an error
+void OrderEntryClassic::operator()(
+    Trace<json::BatchOrdersAck> const &event, std::string_view const &symbol, std::span<ClientOrderId const> const &client_order_ids, bool cancel) {
+  auto &[trace_info, batch_orders_ack] = event;
+  log::info<2>("batch_orders_ack={}"sv, batch_orders_ack);
+  for (size_t i = 0; i < std::size(batch_orders_ack.data); ++i) {
+    auto &item = batch_orders_ack.data[i];
+    if (item.code != 0) {
+      if (i >= std::size(client_order_ids)) [[unlikely]] {
+        log::warn(R"(Unexpected: batch response has more items than the request (symbol="{}"))"sv, symbol);
+        break;
+      }
+      std::string_view client_order_id = client_order_ids[i];
+      if (cancel && json::guess_error(item.code) == Error::UNKNOWN_EXTERNAL_ORDER_ID) {
+        // note! the leg is already done
+        request_.quote_legs.remove(symbol, client_order_id);
+        continue;
+      }
+      ++counter_.batch_orders_reject;
+      log::warn(R"(Batch order rejected: client_order_id="{}", cancel={}, code={}, msg="{}")"sv, client_order_id, cancel, item.code, item.msg);
+      if (!cancel) {
+        request_.quote_legs.remove(symbol, client_order_id);
+      }
+      continue;
+    }
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), item.order_id);
+    auto order_update = server::oms::OrderUpdate{
+        .account = account_.name,
+        .exchange = shared_.settings.exchange,
+        .symbol = item.symbol,
+        .side = map(item.side),
+        .position_effect = {},
+        .margin_mode = {},
+        .max_show_quantity = NaN,
+        .order_type = map(item.type),
+        .time_in_force = map(item.time_in_force),
+        .execution_instructions = {},
+        .create_time_utc = {},
+        .update_time_utc = item.update_time,
+        .external_account = {},
+        .external_order_id = external_order_id,
+        .client_order_id = item.client_order_id,
+        .order_status = map(item.status),
+        .quantity = item.orig_qty,
+        .price = item.price,
+        .stop_price = item.stop_price,
+        .leverage = NaN,
+        .remaining_quantity = NaN,
+        .traded_quantity = item.executed_qty,
+        .average_traded_price = item.avg_price,
+        .last_traded_quantity = NaN,
+        .last_traded_price = NaN,
+        .last_liquidity = {},
+        .routing_id = {},
+        .max_request_version = {},
+        .max_response_version = {},
+        .max_accepted_version = {},
+        .update_type = UpdateType::INCREMENTAL,
+        .sending_time_utc = {},
+    };
+    Trace event_2{trace_info, order_update};
+    (*this)(event_2, item.client_order_id);
+  }
+  if (cancel) {
+    place_quote(symbol);
+  }
+}
+
 // helpers
 
 void OrderEntryClassic::process_response(web::rest::Response const &response, auto error_handler, auto success_handler) {
@@ -1368,20 +1801,55 @@ void OrderEntryClassic::process_response(web::rest::Response const &response, au
 template <typename... Args>
 void OrderEntryClassic::operator()(Trace<server::oms::Response> const &event, uint8_t user_id, uint64_t order_id, Args &&...args) {
   auto &[trace_info, response] = event;
-  if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<Args>(args)..., []([[maybe_unused]] auto &order) {})) {
-  } else {
-    log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+  if (response.request_type == RequestType::CANCEL_ORDER) {
+    auto key = tools::Race::Key{
+        .user_id = user_id,
+        .order_id = order_id,
+        .version = response.version,
+    };
+    if (!shared_.cancel_race(key, response.request_status == RequestStatus::ACCEPTED)) {
+      log::info<1>("Drop response (cancel race): user_id={}, order_id={}, request_status={}"sv, user_id, order_id, response.request_status);
+      return;
+    }
   }
+  auto update_order = [&](auto &&...args_2) {
+    if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<decltype(args_2)>(args_2)..., [](auto &) {})) {
+    } else {
+      log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+    }
+  };
+  if constexpr (sizeof...(Args) == 1) {
+    // note! the response must always be delivered
+    if (!shared_.check_order_update(args...)) {
+      log::info<3>("Drop order update (redundant or out of order): user_id={}, order_id={}"sv, user_id, order_id);
+      update_order();
+      return;
+    }
+  }
+  update_order(std::forward<Args>(args)...);
 }
 
 void OrderEntryClassic::operator()(Trace<server::oms::OrderUpdate> const &event, std::string_view const &client_order_id) {
   auto &[trace_info, order_update] = event;
+  if (!shared_.check_order_update(order_update)) {
+    log::info<3>(R"(Drop order update (redundant or out of order): client_order_id="{}")"sv, client_order_id);
+    return;
+  }
+  if (shared_.update_quote_leg(request_.quote_legs, order_update) != SOURCE_NONE) {
+    return;  // note! quote legs are not known to the order management system
+  }
   if (shared_.update_order(client_order_id, stream_id_, trace_info, order_update, [&]([[maybe_unused]] auto &order) {})) {
   } else {
     log::warn("*** EXTERNAL ORDER ***"sv);
   }
 }
 
+void OrderEntryClassic::update_round_trip(utils::metrics::Latency &latency, std::chrono::nanoseconds start) {
+  auto sample = clock::get_system() - start;
+  latency.update(sample);
+  round_trip_.update(sample);
+}
+
 void OrderEntryClassic::waf_limit_violation() {
   if (shared_.settings.rest.terminate_on_403) {
     log::fatal("WAF limit violation"sv);
@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "roq/utils/container.hpp"
 
@@ -28,6 +32,11 @@
 #include "roq/binance_futures/request.hpp"
 #include "roq/binance_futures/shared.hpp"
 
+#include "roq/binance_futures/tools/round_trip.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+#include "roq/binance_futures/tools/trade_download.hpp"
+
 #include "roq/binance_futures/json/listen_key_ack.hpp"
 
 #include "roq/binance_futures/json/account_balance_ack.hpp"
@@ -42,10 +51,13 @@
 
 #include "roq/binance_futures/json/countdown_cancel_all_ack.hpp"
 
+#include "roq/binance_futures/json/batch_orders_ack.hpp"
+#include "roq/binance_futures/json/encoder.hpp"
+
 namespace roq {
 namespace binance_futures {
 
-struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Handler {
+struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Handler, public tools::TimerWheel::Handler {
   struct ListenKeyUpdate final {
     std::string_view account;
     std::string_view listen_key;
@@ -62,7 +74,7 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
     virtual void operator()(ListenKeyUpdate const &) = 0;
   };
 
-  OrderEntryClassic(Handler &, io::Context &, uint16_t stream_id, Account &, Shared &, Request &);
+  OrderEntryClassic(Handler &, io::Context &, uint16_t stream_id, Account &, Shared &, Request &, bool master = true);
 
   OrderEntryClassic(OrderEntryClassic &&) = delete;
   OrderEntryClassic(OrderEntryClassic const &) = delete;
@@ -70,9 +82,11 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
   bool ready() const { return status_ == ConnectionStatus::READY; }
   bool downloading() const { return download_balance_ || download_account_ || download_orders_ || download_trades_; }
 
+  // note! smoothed order round-trip (ping samples keep an idle connection ranked)
+  std::chrono::nanoseconds round_trip() const { return round_trip_.get(); }
+
   void operator()(Event<Start> const &) override;
   void operator()(Event<Stop> const &) override;
-  void operator()(Event<Timer> const &) override;
 
   void operator()(metrics::Writer &) const override;
 
@@ -84,6 +98,9 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
 
   uint16_t operator()(Event<CancelAllOrders> const &, std::string_view const &request_id) override;
 
+  uint16_t operator()(Event<MassQuote> const &) override;
+  uint16_t operator()(Event<CancelQuotes> const &) override;
+
  protected:
   // web::rest::Client::Handler
 
@@ -94,6 +111,12 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
   void operator()(Trace<web::rest::Client::Header> const &) override;
   void operator()(Trace<web::rest::Client::MessageEnd> const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
+  void refresh(std::chrono::nanoseconds now);
+
   void operator()(ConnectionStatus);
 
   uint32_t download(OrderEntryState state);
@@ -125,12 +148,13 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
   // trades
 
   void get_trades();
-  void get_trades_ack(Trace<web::rest::Response> const &);
+  void get_trades_next();
+  void get_trades_ack(Trace<web::rest::Response> const &, uint32_t limit);
   void operator()(Trace<json::TradesAck> const &);
 
   // refresh-listen-key
 
-  void refresh_listen_key();
+  void refresh_listen_key(std::chrono::nanoseconds now);
 
   // order-place
 
@@ -162,6 +186,21 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
   void countdown_cancel_all_ack(Trace<web::rest::Response> const &);
   void operator()(Trace<json::CountdownCancelAllAck> const &);
 
+  // mass-quote
+
+  void mass_quote(Event<MassQuote> const &);
+  void cancel_quotes(Event<CancelQuotes> const &);
+  void retry_quote_cancels(std::chrono::nanoseconds now);
+  void place_quote(std::string_view const &symbol);
+
+  // batch-orders
+
+  void batch_orders_place(std::span<json::Encoder::QuoteLeg const> const &, std::chrono::milliseconds recv_window);
+  void batch_orders_cancel(std::string_view const &symbol, std::span<ClientOrderId const> const &, std::chrono::milliseconds recv_window);
+  void batch_orders_ack(
+      Trace<web::rest::Response> const &, std::string_view const &symbol, std::span<ClientOrderId const> const &client_order_ids, bool cancel);
+  void operator()(Trace<json::BatchOrdersAck> const &, std::string_view const &symbol, std::span<ClientOrderId const> const &client_order_ids, bool cancel);
+
   // helpers
 
   void process_response(web::rest::Response const &, auto error_handler, auto success_handler);
@@ -173,18 +212,21 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
 
   void waf_limit_violation();
 
+  void update_round_trip(utils::metrics::Latency &, std::chrono::nanoseconds start);
+
  private:
   Handler &handler_;
   // config
   uint16_t const stream_id_;
   std::string const name_;
+  bool const master_;
   // connection
   std::unique_ptr<web::rest::Client> const connection_;
   // buffers
   core::json::BufferStack decode_buffer_;
   // metrics
   struct {
-    utils::metrics::Counter disconnect;
+    utils::metrics::Counter disconnect, batch_orders_reject, batch_orders_error;
   } counter_;
   struct {
     utils::metrics::Profile  //
@@ -198,10 +240,13 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
         order_modify, order_modify_ack,                      //
         order_cancel, order_cancel_ack,                      //
         open_orders_cancel_all, open_orders_cancel_all_ack,  //
-        countdown_cancel_all, countdown_cancel_all_ack;
+        countdown_cancel_all, countdown_cancel_all_ack,      //
+        mass_quote, cancel_quotes,                           //
+        batch_orders_place, batch_orders_cancel, batch_orders_ack;
   } profile_;
   struct {
-    utils::metrics::Latency ping;
+    utils::metrics::Latency ping,  //
+        order_place_round_trip, order_modify_round_trip, order_cancel_round_trip;
   } latency_;
   struct {
     utils::metrics::Gauge request_weight_1m, create_order_1m;
@@ -216,15 +261,32 @@ struct OrderEntryClassic final : public OrderEntry, public web::rest::Client::Ha
   std::chrono::nanoseconds listen_key_refresh_ = {};
   ConnectionStatus status_ = {};
   core::Download<OrderEntryState> download_;
+  tools::RoundTrip round_trip_;
   // experimental
   utils::unordered_set<std::string> open_orders_symbols_;
-  std::chrono::nanoseconds next_auto_cancel_ = {};
   bool download_balance_ = false;
   bool download_account_ = false;
   bool download_orders_ = false;
   bool download_trades_ = false;
+  bool download_trades_in_flight_ = false;
   std::vector<char> encode_buffer_;
   bool download_trades_is_first_ = true;
+  tools::TradeDownload trade_download_;  // note! never shared (the trade cursor is)
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+    tools::TimerWheel::Timer listen_key, countdown;
+  } timer_;
+  // quotes
+  std::string const quote_prefix_;
+  uint64_t quote_sequence_ = {};
+  std::vector<ClientOrderId> quote_cancels_;
+  struct PendingQuote final {
+    uint8_t user_id = {};
+    std::vector<ClientOrderId> client_order_ids;
+    std::vector<json::Encoder::QuoteLeg> legs;  // note! references the symbol (map key) and the client order ids
+  };
+  std::map<std::string, PendingQuote, std::less<>> pending_quotes_;  // note! new legs waiting for the previous legs to be cancelled
 };
 
 }  // namespace binance_futures
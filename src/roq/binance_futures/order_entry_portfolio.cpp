@@ -12,6 +12,7 @@
 #include "roq/utils/update.hpp"
 
 #include "roq/utils/charconv/from_chars.hpp"
+#include "roq/utils/charconv/to_string.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
 
@@ -42,11 +43,15 @@ auto const SUPPORTS = Mask{
 };
 
 auto const X_MBX_USED_WEIGHT_1M = "x-mbx-used-weight-1m"sv;
+auto const X_MBX_ORDER_COUNT_10S = "x-mbx-order-count-10s"sv;
 auto const X_MBX_ORDER_COUNT_1M = "x-mbx-order-count-1m"sv;
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 1;
 
 size_t const DOWNLOAD_TRADES_LIMIT = 1000;
+
+uint32_t const TIMER_REFRESH = 1;
+uint32_t const TIMER_LISTEN_KEY = 2;
 }  // namespace
 
 // === HELPERS ===
@@ -148,26 +153,52 @@ OrderEntryPortfolio::OrderEntryPortfolio(Handler &handler, io::Context &context,
       },
       latency_{
           .ping = create_metrics(shared.settings, name_, "ping"sv),
+          .order_place_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_place"sv),
+          .order_modify_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_modify"sv),
+          .order_cancel_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_cancel"sv),
       },
       rate_limiter_{
           .request_weight_1m = create_metrics(shared.settings, name_, "request_weight"sv, "1m"sv),
           .create_order_1m = create_metrics(shared.settings, name_, "create_order"sv, "1m"sv),
       },
-      account_{account}, shared_{shared}, request_{request}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }} {
+      account_{account}, shared_{shared}, request_{request}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+          .listen_key = {shared.timer_wheel, *this, TIMER_LISTEN_KEY},
+      } {
 }
 
 void OrderEntryPortfolio::operator()(Event<Start> const &) {
   (*connection_).start();
+  auto now = clock::get_system();
+  timer_.refresh.start(now);
+  balance_refresh_ = now + shared_.settings.misc.test_pm_balance_freq;
 }
 
 void OrderEntryPortfolio::operator()(Event<Stop> const &) {
+  timer_.refresh.stop();
+  timer_.listen_key.cancel();
   (*connection_).stop();
 }
 
-void OrderEntryPortfolio::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
+// tools::TimerWheel::Handler
+
+void OrderEntryPortfolio::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      refresh(now);
+      break;
+    case TIMER_LISTEN_KEY:
+      refresh_listen_key(now);
+      break;
+    default:
+      assert(false);
+  }
+}
+
+void OrderEntryPortfolio::refresh(std::chrono::nanoseconds now) {
   (*connection_).refresh(now);
-  refresh_listen_key(now);
   refresh_balance(now);
   if (ready() && !downloading()) {
     if (!downloading() && request_.respond_balance < request_.request_balance) {
@@ -225,6 +256,9 @@ void OrderEntryPortfolio::operator()(metrics::Writer &writer) const {
       .write(profile_.open_orders_cancel_all_ack, metrics::Type::PROFILE)
       // latency
       .write(latency_.ping, metrics::Type::LATENCY)
+      .write(latency_.order_place_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_modify_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_cancel_round_trip, metrics::Type::LATENCY)
       // rate limiter
       .write(rate_limiter_.request_weight_1m, metrics::Type::RATE_LIMITER)
       .write(rate_limiter_.create_order_1m, metrics::Type::RATE_LIMITER);
@@ -252,6 +286,15 @@ uint16_t OrderEntryPortfolio::operator()(Event<CancelAllOrders> const &event, st
   return stream_id_;
 }
 
+// note! the papi does not support batch orders
+uint16_t OrderEntryPortfolio::operator()(Event<MassQuote> const &) {
+  throw server::oms::NotSupported{"not supported"sv};
+}
+
+uint16_t OrderEntryPortfolio::operator()(Event<CancelQuotes> const &) {
+  throw server::oms::NotSupported{"not supported"sv};
+}
+
 void OrderEntryPortfolio::operator()(Trace<web::rest::Client::Connected> const &) {
   if (download_.downloading()) {
     download_.bump();
@@ -303,6 +346,23 @@ void OrderEntryPortfolio::operator()(Trace<web::rest::Client::Header> const &eve
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.request_weight_1m.set(value);
+      shared_.download_governor.sync(1min, shared_.limits.request_weight_1m, value, clock::get_system());
+    } catch (RuntimeError &) {
+      log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
+    }
+  }
+  if (utils::case_insensitive_compare(header.name, X_MBX_ORDER_COUNT_10S) == 0) {
+    try {
+      auto value = utils::charconv::from_string_relaxed<uint32_t>(header.value);
+      auto rate_limit = RateLimit{
+          .type = RateLimitType::CREATE_ORDER,
+          .period = 10s,
+          .end_time_utc = {},
+          .limit = shared_.limits.create_order_10s,
+          .value = value,
+      };
+      shared_.rate_limits.emplace_back(rate_limit);
+      account_.governor.sync(10s, shared_.limits.create_order_10s, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -319,6 +379,7 @@ void OrderEntryPortfolio::operator()(Trace<web::rest::Client::Header> const &eve
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.create_order_1m.set(value);
+      account_.governor.sync(1min, shared_.limits.create_order_1m, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -444,6 +505,7 @@ void OrderEntryPortfolio::operator()(Trace<json::ListenKeyAck> const &event) {
   }
   auto now = clock::get_system();
   listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+  timer_.listen_key.schedule(listen_key_refresh_);
 }
 
 // account-balance
@@ -512,6 +574,7 @@ void OrderEntryPortfolio::operator()(Trace<json::AccountBalanceAck> const &event
         .exchange_time_utc = item.update_time,
         .sending_time_utc = {},
     };
+    request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
     create_trace_and_dispatch(handler_, trace_info, funds_update, true);
     /*
     if (!std::isnan(item.cross_wallet_balance)) {
@@ -603,6 +666,7 @@ void OrderEntryPortfolio::operator()(Trace<json::AccountStatusAck> const &event)
         .exchange_time_utc = account_status_ack.update_time,
         .sending_time_utc = {},
     };
+    request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity);
     create_trace_and_dispatch(handler_, trace_info, position_update, true);
   }
 }
@@ -675,6 +739,7 @@ void OrderEntryPortfolio::operator()(Trace<json::PositionList> const &event) {
         .exchange_time_utc = item.update_time,
         .sending_time_utc = {},
     };
+    request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity);
     create_trace_and_dispatch(handler_, trace_info, position_update, true);
   }
 }
@@ -733,7 +798,8 @@ void OrderEntryPortfolio::operator()(Trace<json::OpenOrdersAck> const &event) {
       continue;
     }
     open_orders_symbols_.emplace(item.symbol);
-    auto external_order_id = fmt::format("{}"sv, item.order_id);  // alloc
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), item.order_id);
     auto remaining_quantity = item.orig_qty - item.executed_qty;
     auto average_traded_price = utils::compare(item.executed_qty, 0.0) == 0 ? NaN : item.avg_price;
     auto order_update = server::oms::OrderUpdate{
@@ -773,6 +839,7 @@ void OrderEntryPortfolio::operator()(Trace<json::OpenOrdersAck> const &event) {
     Trace event_2{trace_info, order_update};
     (*this)(event_2, item.client_order_id);
   }
+  shared_.reconcile_order_state(account_.name, open_orders_ack.data);
 }
 
 // trades
@@ -886,28 +953,32 @@ void OrderEntryPortfolio::operator()(Trace<json::TradesAck> const &event) {
 
 void OrderEntryPortfolio::refresh_listen_key(std::chrono::nanoseconds now) {
   if (!ready()) {
-    return;
+    return;  // note! re-scheduled when the listen key is acquired after reconnect
   }
   if (listen_key_refresh_.count() == 0 || now < listen_key_refresh_) {
     return;
   }
   log::info("Refreshing listen key..."sv);
   listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+  timer_.listen_key.schedule(listen_key_refresh_);
   get_listen_key();
 }
 
+// note! driven by user stream events (coalesced from the first event) with a slow safety poll
 void OrderEntryPortfolio::refresh_balance(std::chrono::nanoseconds now) {
   if (!ready()) {
     return;
   }
-  if (shared_.settings.misc.test_pm_balance_freq.count() == 0) {
+  auto &settings = shared_.settings.misc;
+  auto &balance_changed = request_.balance_changed;
+  auto changed = settings.pm_balance_delay.count() != 0 && balance_changed.count() != 0 && (balance_changed + settings.pm_balance_delay) <= now;
+  auto expired = settings.test_pm_balance_freq.count() != 0 && balance_refresh_ <= now;
+  if (!changed && !expired) {
     return;
   }
-  if (now < balance_refresh_) {
-    return;
-  }
-  log::info("Refreshing balance..."sv);
-  balance_refresh_ = now + shared_.settings.misc.test_pm_balance_freq;
+  log::info<1>("Refreshing balance... (changed={}, expired={})"sv, changed, expired);
+  request_.balance_changed = {};
+  balance_refresh_ = now + settings.test_pm_balance_freq;
   get_account_balance(true);
 }
 
@@ -920,27 +991,30 @@ void OrderEntryPortfolio::order_place(Event<CreateOrder> const &event, server::o
     }
     auto &[message_info, create_order] = event;
     open_orders_symbols_.emplace(create_order.symbol);
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body = json::Encoder::order_place_url(encode_buffer_, create_order, order, request_id, recv_window);
-    auto query = account_.create_rest_signature_body(body);
+    auto recv_window = shared_.get_order_recv_window();
+    auto params = json::Encoder::order_place_url(encode_buffer_, shared_.order_templates, create_order, order, request_id, recv_window);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::POST,
         .path = shared_.api.papi.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = create_order.order_id]([[maybe_unused]] auto &request_id, auto &response) {
+    auto callback = [this, user_id = message_info.source, order_id = create_order.order_id, start = clock::get_system()](
+                        [[maybe_unused]] auto &request_id, auto &response) {
+      latency_.order_place_round_trip.update(clock::get_system() - start);
       uint32_t version = 1;
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_place_ack(event, user_id, order_id, version);
     };
     (*connection_)(request_id, request, callback);
+    shared_.order_latency.begin({.user_id = message_info.source, .order_id = create_order.order_id}, clock::get_system());
   });
 }
 
@@ -973,7 +1047,8 @@ void OrderEntryPortfolio::order_place_ack(Trace<web::rest::Response> const &even
 void OrderEntryPortfolio::operator()(Trace<json::OrderPlaceAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_place_ack] = event;
   log::info<2>("order_place_ack={}, user_id={}, order_id={}, version={}"sv, order_place_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_place_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_place_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::CREATE_ORDER,
       .origin = Origin::EXCHANGE,
@@ -1037,22 +1112,23 @@ void OrderEntryPortfolio::order_modify(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, modify_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body = json::Encoder::order_modify_url(encode_buffer_, modify_order, order, request_id, previous_request_id, recv_window, true);
-    auto query = account_.create_rest_signature_body(body);
+    auto recv_window = shared_.get_order_recv_window();
+    auto params = json::Encoder::order_modify_url(encode_buffer_, modify_order, order, request_id, previous_request_id, recv_window, true);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::PUT,
         .path = shared_.api.papi.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = modify_order.order_id, version = modify_order.version](
+    auto callback = [this, user_id = message_info.source, order_id = modify_order.order_id, version = modify_order.version, start = clock::get_system()](
                         [[maybe_unused]] auto &request_id, auto &response) {
+      latency_.order_modify_round_trip.update(clock::get_system() - start);
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_modify_ack(event, user_id, order_id, version);
@@ -1093,7 +1169,8 @@ void OrderEntryPortfolio::order_modify_ack(Trace<web::rest::Response> const &eve
 void OrderEntryPortfolio::operator()(Trace<json::OrderModifyAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_modify_ack] = event;
   log::info<2>("order_modify_ack={}, user_id={}, order_id={}, version={}"sv, order_modify_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_modify_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_modify_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::MODIFY_ORDER,
       .origin = Origin::EXCHANGE,
@@ -1157,22 +1234,23 @@ void OrderEntryPortfolio::order_cancel(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, cancel_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto body = json::Encoder::order_cancel_url(encode_buffer_, cancel_order, order, request_id, previous_request_id, recv_window);
-    auto query = account_.create_rest_signature_body(body);
+    auto recv_window = shared_.get_order_recv_window();
+    auto params = json::Encoder::order_cancel_url(encode_buffer_, cancel_order, order, request_id, previous_request_id, recv_window);
+    auto body = account_.sign_rest_body(encode_buffer_, params);
     auto headers = account_.get_rest_headers();
     auto request = web::rest::Request{
         .method = web::http::Method::DELETE,
         .path = shared_.api.papi.order,
-        .query = query,
+        .query = {},
         .accept = web::http::Accept::APPLICATION_JSON,
         .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
         .headers = headers,
         .body = body,
         .quality_of_service = io::QualityOfService::IMMEDIATE,
     };
-    auto callback = [this, user_id = message_info.source, order_id = cancel_order.order_id, version = cancel_order.version](
+    auto callback = [this, user_id = message_info.source, order_id = cancel_order.order_id, version = cancel_order.version, start = clock::get_system()](
                         [[maybe_unused]] auto &request_id, auto &response) {
+      latency_.order_cancel_round_trip.update(clock::get_system() - start);
       TraceInfo trace_info;
       Trace event{trace_info, response};
       order_cancel_ack(event, user_id, order_id, version);
@@ -1210,7 +1288,8 @@ void OrderEntryPortfolio::order_cancel_ack(Trace<web::rest::Response> const &eve
 void OrderEntryPortfolio::operator()(Trace<json::OrderCancelAck> const &event, uint8_t user_id, uint64_t order_id, uint32_t version) {
   auto &[trace_info, order_cancel_ack] = event;
   log::info<2>("order_cancel_ack={}, user_id={}, order_id={}, version={}"sv, order_cancel_ack, user_id, order_id, version);
-  auto external_order_id = fmt::format("{}"sv, order_cancel_ack.order_id);  // alloc
+  ExternalOrderId external_order_id;
+  utils::charconv::to_string(std::back_inserter(external_order_id), order_cancel_ack.order_id);
   auto response = server::oms::Response{
       .request_type = RequestType::CANCEL_ORDER,
       .origin = Origin::EXCHANGE,
@@ -1275,13 +1354,13 @@ void OrderEntryPortfolio::open_orders_cancel_all(Event<CancelAllOrders> const &e
       if (!std::empty(cancel_all_orders.symbol) && symbol != cancel_all_orders.symbol) {
         continue;
       }
-      auto body = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
-      auto query = account_.create_rest_signature_body(body);
+      auto params = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
       auto headers = account_.get_rest_headers();
       auto request = web::rest::Request{
           .method = web::http::Method::DELETE,
           .path = shared_.api.papi.all_open_orders,
-          .query = query,
+          .query = {},
           .accept = web::http::Accept::APPLICATION_JSON,
           .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
           .headers = headers,
@@ -1426,14 +1505,29 @@ void OrderEntryPortfolio::process_response(web::rest::Response const &response,
 template <typename... Args>
 void OrderEntryPortfolio::operator()(Trace<server::oms::Response> const &event, uint8_t user_id, uint64_t order_id, Args &&...args) {
   auto &[trace_info, response] = event;
-  if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<Args>(args)..., []([[maybe_unused]] auto &order) {})) {
-  } else {
-    log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+  auto update_order = [&](auto &&...args_2) {
+    if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<decltype(args_2)>(args_2)..., [](auto &) {})) {
+    } else {
+      log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+    }
+  };
+  if constexpr (sizeof...(Args) == 1) {
+    // note! the response must always be delivered
+    if (!shared_.check_order_update(args...)) {
+      log::info<3>("Drop order update (redundant or out of order): user_id={}, order_id={}"sv, user_id, order_id);
+      update_order();
+      return;
+    }
   }
+  update_order(std::forward<Args>(args)...);
 }
 
 void OrderEntryPortfolio::operator()(Trace<server::oms::OrderUpdate> const &event, std::string_view const &client_order_id) {
   auto &[trace_info, order_update] = event;
+  if (!shared_.check_order_update(order_update)) {
+    log::info<3>(R"(Drop order update (redundant or out of order): client_order_id="{}")"sv, client_order_id);
+    return;
+  }
   if (shared_.update_order(client_order_id, stream_id_, trace_info, order_update, [&]([[maybe_unused]] auto &order) {})) {
   } else {
     log::warn("*** EXTERNAL ORDER ***"sv);
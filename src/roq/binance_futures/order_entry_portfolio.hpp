@@ -28,6 +28,9 @@
 #include "roq/binance_futures/request.hpp"
 #include "roq/binance_futures/shared.hpp"
 
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 #include "roq/binance_futures/json/listen_key_ack.hpp"
 
 #include "roq/binance_futures/json/account_balance_ack.hpp"
@@ -44,7 +47,7 @@
 namespace roq {
 namespace binance_futures {
 
-struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::Handler {
+struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::Handler, public tools::TimerWheel::Handler {
   struct ListenKeyUpdate final {
     std::string_view account;
     std::string_view listen_key;
@@ -71,7 +74,6 @@ struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::
 
   void operator()(Event<Start> const &) override;
   void operator()(Event<Stop> const &) override;
-  void operator()(Event<Timer> const &) override;
 
   void operator()(metrics::Writer &) const override;
 
@@ -83,6 +85,9 @@ struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::
 
   uint16_t operator()(Event<CancelAllOrders> const &, std::string_view const &request_id) override;
 
+  uint16_t operator()(Event<MassQuote> const &) override;
+  uint16_t operator()(Event<CancelQuotes> const &) override;
+
  protected:
   // web::rest::Client::Handler
 
@@ -93,6 +98,12 @@ struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::
   void operator()(Trace<web::rest::Client::Header> const &) override;
   void operator()(Trace<web::rest::Client::MessageEnd> const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
+  void refresh(std::chrono::nanoseconds now);
+
   void operator()(ConnectionStatus);
 
   uint32_t download(OrderEntryState state);
@@ -201,7 +212,8 @@ struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::
         open_orders_cancel_all, open_orders_cancel_all_ack;
   } profile_;
   struct {
-    utils::metrics::Latency ping;
+    utils::metrics::Latency ping,  //
+        order_place_round_trip, order_modify_round_trip, order_cancel_round_trip;
   } latency_;
   struct {
     utils::metrics::Gauge request_weight_1m, create_order_1m;
@@ -226,6 +238,11 @@ struct OrderEntryPortfolio final : public OrderEntry, public web::rest::Client::
   bool download_trades_ = false;
   std::vector<char> encode_buffer_;
   bool download_trades_is_first_ = true;
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+    tools::TimerWheel::Timer listen_key;
+  } timer_;
 };
 
 }  // namespace binance_futures
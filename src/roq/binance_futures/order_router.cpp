@@ -0,0 +1,301 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/order_router.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+
+#include "roq/logging.hpp"
+
+#include "roq/clock.hpp"
+
+#include "roq/utils/metrics/factory.hpp"
+
+#include "roq/server/oms/exceptions.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+
+// === CONSTANTS ===
+
+namespace {
+auto const NAME = "router"sv;
+
+auto const NO_STANDBY = std::numeric_limits<size_t>::max();
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+auto create_name(auto &account) {
+  return fmt::format("{}:{}"sv, NAME, account);
+}
+
+auto create_sessions(auto &handler, auto &context, auto &stream_id, auto &account, auto &shared, auto &request) {
+  auto &network_interfaces = shared.settings.ws_api_2.network_interfaces;
+  auto size = std::max<size_t>(shared.settings.ws_api_2.sessions, 1) + (shared.settings.ws_api_2.hot_standby ? 1 : 0);
+  std::vector<std::unique_ptr<WebSocket>> result;
+  for (size_t i = 0; i < size; ++i) {
+    auto master = i == 0;
+    auto interface = std::empty(network_interfaces) ? std::string_view{} : std::string_view{network_interfaces[i % std::size(network_interfaces)]};
+    auto obj = std::make_unique<WebSocket>(handler, context, ++stream_id, account, shared, request, master, interface);
+    result.emplace_back(std::move(obj));
+  }
+  return result;
+}
+
+// note! only used for order actions, downloads are left to the master session
+
+auto create_rest(auto &handler, auto &context, auto &stream_id, auto &account, auto &shared, auto &request) {
+  std::unique_ptr<OrderEntryClassic> result;
+  if (shared.settings.ws_api_2.rest_fallback) {
+    result = std::make_unique<OrderEntryClassic>(handler, context, ++stream_id, account, shared, request, false);
+  }
+  return result;
+}
+
+auto get_standby(auto &settings, auto &sessions) {
+  if (!settings.ws_api_2.hot_standby) {
+    return NO_STANDBY;
+  }
+  return std::size(sessions) - 1;
+}
+struct create_metrics final : public utils::metrics::Factory {
+  create_metrics(auto &settings, auto &group, auto const &function, auto const &params) : utils::metrics::Factory{settings.app.name, group, function, params} {}
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+OrderRouter::OrderRouter(WebSocket::Handler &handler, io::Context &context, uint16_t &stream_id, Account &account, Shared &shared, Request &request)
+    : handler_{handler}, shared_{shared}, name_{create_name(account.name)},
+      sessions_{create_sessions(*this, context, stream_id, account, shared, request)},
+      rest_{create_rest(*this, context, stream_id, account, shared, request)}, standby_{get_standby(shared.settings, sessions_)},
+      race_cancel_{shared.settings.ws_api_2.race_cancel},
+      counter_{
+          .ws_api = create_metrics(shared.settings, name_, "route"sv, "ws_api"sv),
+          .rest = create_metrics(shared.settings, name_, "route"sv, "rest"sv),
+      } {
+  log::info<1>(
+      R"(account="{}", sessions={}, hot_standby={}, rest_fallback={}, race_cancel={})"sv,
+      account.name,
+      std::size(sessions_),
+      standby_ != NO_STANDBY,
+      static_cast<bool>(rest_),
+      race_cancel_);
+}
+
+void OrderRouter::operator()(Event<Start> const &event) {
+  for (auto &item : sessions_) {
+    (*item)(event);
+  }
+  if (rest_) {
+    (*rest_)(event);
+  }
+}
+
+void OrderRouter::operator()(Event<Stop> const &event) {
+  for (auto &item : sessions_) {
+    (*item)(event);
+  }
+  if (rest_) {
+    (*rest_)(event);
+  }
+}
+
+void OrderRouter::operator()(metrics::Writer &writer) const {
+  writer
+      // counter
+      .write(counter_.ws_api, metrics::Type::COUNTER)
+      .write(counter_.rest, metrics::Type::COUNTER);
+  for (auto &item : sessions_) {
+    (*item)(writer);
+  }
+  if (rest_) {
+    (*rest_)(writer);
+  }
+}
+
+uint16_t OrderRouter::operator()(Event<CreateOrder> const &event, server::oms::Order const &order, std::string_view const &request_id) {
+  return select()(event, order, request_id);
+}
+
+uint16_t OrderRouter::operator()(
+    Event<ModifyOrder> const &event, server::oms::Order const &order, std::string_view const &request_id, std::string_view const &previous_request_id) {
+  return select()(event, order, request_id, previous_request_id);
+}
+
+// note! a duplicate cancel is harmless and the response arriving first is used
+
+uint16_t OrderRouter::operator()(
+    Event<CancelOrder> const &event, server::oms::Order const &order, std::string_view const &request_id, std::string_view const &previous_request_id) {
+  auto &first = select();
+  auto result = first(event, order, request_id, previous_request_id);
+  if (!race_cancel_) {
+    return result;
+  }
+  auto second = find(&first);
+  if (second == nullptr) {
+    return result;
+  }
+  try {
+    (*second)(event, order, request_id, previous_request_id);
+  } catch (std::exception &e) {
+    log::warn(R"(Unable to race cancel (what="{}"))"sv, e.what());
+    return result;
+  }
+  auto &[message_info, cancel_order] = event;
+  auto key = tools::Race::Key{
+      .user_id = message_info.source,
+      .order_id = cancel_order.order_id,
+      .version = cancel_order.version,
+  };
+  // note! responses are dispatched from the event loop and will therefore always arrive after this
+  shared_.cancel_race.begin(key, 2, clock::get_system());
+  return result;
+}
+
+uint16_t OrderRouter::operator()(Event<CancelAllOrders> const &event, std::string_view const &request_id) {
+  return select()(event, request_id);
+}
+
+// note! batch orders are only supported by rest
+
+uint16_t OrderRouter::operator()(Event<MassQuote> const &event) {
+  if (rest_) {
+    return (*rest_)(event);
+  }
+  return select()(event);
+}
+
+uint16_t OrderRouter::operator()(Event<CancelQuotes> const &event) {
+  if (rest_) {
+    return (*rest_)(event);
+  }
+  return select()(event);
+}
+
+// WebSocket::Handler
+
+void OrderRouter::operator()(Trace<StreamStatus> const &event) {
+  handler_(event);
+  failover();
+}
+
+void OrderRouter::operator()(Trace<ExternalLatency> const &event) {
+  handler_(event);
+}
+
+void OrderRouter::operator()(Trace<RateLimitsUpdate> const &event) {
+  handler_(event);
+}
+
+void OrderRouter::operator()(Trace<TradeUpdate> const &event, bool is_last, uint8_t user_id, std::string_view const &request_id) {
+  handler_(event, is_last, user_id, request_id);
+}
+
+void OrderRouter::operator()(Trace<FundsUpdate> const &event, bool is_last) {
+  handler_(event, is_last);
+}
+
+void OrderRouter::operator()(Trace<PositionUpdate> const &event, bool is_last) {
+  handler_(event, is_last);
+}
+
+void OrderRouter::operator()(WebSocket::ListenKeyUpdate const &listen_key_update) {
+  handler_(listen_key_update);
+}
+
+void OrderRouter::operator()(WebSocket::UserStreamUpdate const &user_stream_update) {
+  handler_(user_stream_update);
+}
+
+void OrderRouter::operator()(WebSocket::UserStreamEvent const &user_stream_event) {
+  handler_(user_stream_event);
+}
+
+void OrderRouter::operator()(OrderEntryClassic::ListenKeyUpdate const &listen_key_update) {
+  auto listen_key_update_2 = WebSocket::ListenKeyUpdate{
+      .account = listen_key_update.account,
+      .listen_key = listen_key_update.listen_key,
+  };
+  handler_(listen_key_update_2);
+}
+
+// note! orders are identified by client order id and any session can therefore modify or cancel
+
+OrderEntry &OrderRouter::select() {
+  auto result = find(nullptr);
+  if (result == nullptr) [[unlikely]] {
+    throw server::oms::NotReady{"not ready"sv};
+  }
+  if (result == rest_.get()) {
+    ++counter_.rest;
+  } else {
+    ++counter_.ws_api;
+  }
+  return *result;
+}
+
+OrderEntry *OrderRouter::find(OrderEntry const *exclude) {
+  OrderEntry *result = nullptr;
+  std::chrono::nanoseconds round_trip = {};
+  auto helper = [&](auto &path) {
+    if (&path == exclude || !path.ready()) {
+      return;
+    }
+    if (result == nullptr || path.round_trip() < round_trip) {
+      result = &path;
+      round_trip = path.round_trip();
+    }
+  };
+  for (size_t i = 0; i < std::size(sessions_); ++i) {
+    if (i != standby_) {
+      helper(*sessions_[i]);
+    }
+  }
+  if (rest_) {
+    helper(*rest_);
+  }
+  if (result == nullptr && standby_ != NO_STANDBY) {
+    helper(*sessions_[standby_]);
+  }
+  return result;
+}
+
+// note! the hot standby is preferred since it is otherwise idle
+
+void OrderRouter::failover() {
+  auto &master = *sessions_[master_];
+  if (master.ready() || std::size(sessions_) < 2) {
+    return;
+  }
+  auto candidate = [&]() {
+    if (standby_ != NO_STANDBY && (*sessions_[standby_]).ready()) {
+      return standby_;
+    }
+    for (size_t i = 0; i < std::size(sessions_); ++i) {
+      if ((*sessions_[i]).ready()) {
+        return i;
+      }
+    }
+    return master_;
+  }();
+  if (candidate == master_) {
+    return;
+  }
+  log::warn("Promoting stream_id={} (previous master stream_id={})"sv, (*sessions_[candidate]).get_stream_id(), master.get_stream_id());
+  master.set_master(false);
+  // note! the standby is swapped with the previous master so the promoted session is included by find()
+  if (candidate == standby_) {
+    standby_ = master_;
+  }
+  master_ = candidate;
+  (*sessions_[master_]).set_master(true);
+}
+
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,85 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "roq/utils/metrics/counter.hpp"
+
+#include "roq/io/context.hpp"
+
+#include "roq/binance_futures/order_entry.hpp"
+
+#include "roq/binance_futures/account.hpp"
+#include "roq/binance_futures/order_entry_classic.hpp"
+#include "roq/binance_futures/request.hpp"
+#include "roq/binance_futures/shared.hpp"
+#include "roq/binance_futures/web_socket.hpp"
+
+namespace roq {
+namespace binance_futures {
+
+// routes order actions to the ready path having the lowest round-trip latency
+// note! paths are the ws-api sessions and (optionally) classic rest order entry
+// note! only one session (the master) runs downloads and owns the user stream
+// note! the master role is moved to another ready session the moment the master disconnects
+// note! the optional hot standby session is logged on but only used when no other session is ready
+// note! cancel requests can optionally be raced over two paths
+
+struct OrderRouter final : public OrderEntry, public WebSocket::Handler, public OrderEntryClassic::Handler {
+  OrderRouter(WebSocket::Handler &, io::Context &, uint16_t &stream_id, Account &, Shared &, Request &);
+
+  void operator()(Event<Start> const &) override;
+  void operator()(Event<Stop> const &) override;
+
+  void operator()(metrics::Writer &) const override;
+
+  uint16_t operator()(Event<CreateOrder> const &, server::oms::Order const &, std::string_view const &request_id) override;
+  uint16_t operator()(
+      Event<ModifyOrder> const &, server::oms::Order const &, std::string_view const &request_id, std::string_view const &previous_request_id) override;
+  uint16_t operator()(
+      Event<CancelOrder> const &, server::oms::Order const &, std::string_view const &request_id, std::string_view const &previous_request_id) override;
+  uint16_t operator()(Event<CancelAllOrders> const &, std::string_view const &request_id) override;
+
+  uint16_t operator()(Event<MassQuote> const &) override;
+  uint16_t operator()(Event<CancelQuotes> const &) override;
+
+ protected:
+  // WebSocket::Handler + OrderEntryClassic::Handler
+
+  void operator()(Trace<StreamStatus> const &) override;
+  void operator()(Trace<ExternalLatency> const &) override;
+  void operator()(Trace<RateLimitsUpdate> const &) override;
+  void operator()(Trace<TradeUpdate> const &, bool is_last, uint8_t user_id, std::string_view const &request_id) override;
+  void operator()(Trace<FundsUpdate> const &, bool is_last) override;
+  void operator()(Trace<PositionUpdate> const &, bool is_last) override;
+  void operator()(WebSocket::ListenKeyUpdate const &) override;
+  void operator()(WebSocket::UserStreamUpdate const &) override;
+  void operator()(WebSocket::UserStreamEvent const &) override;
+  void operator()(OrderEntryClassic::ListenKeyUpdate const &) override;
+
+  OrderEntry &select();
+  OrderEntry *find(OrderEntry const *exclude);
+
+  void failover();
+
+ private:
+  WebSocket::Handler &handler_;
+  Shared &shared_;
+  std::string const name_;
+  std::vector<std::unique_ptr<WebSocket>> sessions_;
+  std::unique_ptr<OrderEntryClassic> rest_;
+  size_t master_ = {};
+  size_t standby_;  // note! the previous master becomes the standby when the standby is promoted
+  bool const race_cancel_;
+  // metrics
+  struct {
+    utils::metrics::Counter ws_api, rest;
+  } counter_;
+};
+
+}  // namespace binance_futures
+}  // namespace roq
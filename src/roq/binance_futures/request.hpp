@@ -4,6 +4,11 @@
 
 #include <chrono>
 
+#include "roq/binance_futures/tools/account_cache.hpp"
+#include "roq/binance_futures/tools/position_keeper.hpp"
+#include "roq/binance_futures/tools/quote_legs.hpp"
+#include "roq/binance_futures/tools/trade_cursor.hpp"
+
 namespace roq {
 namespace binance_futures {
 
@@ -11,6 +16,7 @@ struct Request final {
   // balance
   std::chrono::nanoseconds request_balance = {};
   std::chrono::nanoseconds respond_balance = {};
+  std::chrono::nanoseconds balance_changed = {};  // note! first user stream event since balances were last refreshed (zero if none)
   // account
   std::chrono::nanoseconds request_account = {};
   std::chrono::nanoseconds respond_account = {};
@@ -23,6 +29,12 @@ struct Request final {
   // trades
   std::chrono::nanoseconds request_trades = {};
   std::chrono::nanoseconds respond_trades = {};
+  tools::TradeCursor trade_cursor;  // note! last seen trade id per symbol
+  // cache
+  tools::AccountCache account_cache;      // note! last published balances and positions
+  tools::PositionKeeper position_keeper;  // note! positions updated directly from fills
+  // quotes
+  tools::QuoteLegs quote_legs;  // note! mass-quote legs are shared with the drop-copy (fills)
 };
 
 }  // namespace binance_futures
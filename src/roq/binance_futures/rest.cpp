@@ -3,6 +3,7 @@
 #include "roq/binance_futures/rest.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "roq/mask.hpp"
@@ -38,6 +39,12 @@ auto const SUPPORTS = Mask{
 auto const X_MBX_USED_WEIGHT_1M = "x-mbx-used-weight-1m"sv;
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 2;
+
+uint32_t const TIMER_REFRESH = 1;
+uint32_t const TIMER_DEPTH_REQUEST = 2;
+uint32_t const TIMER_TIME_SERIES_REQUEST = 3;
+
+int32_t const MAX_PRECISION_DIGITS = 12;
 }  // namespace
 
 // === HELPERS ===
@@ -96,6 +103,21 @@ auto get_retry_after(auto &response) {
   });
   return result;
 }
+
+// note! number of decimals needed to represent a multiple of the increment, e.g. 0.01 => _2
+Precision compute_precision(double increment) {
+  if (!(increment > 0.0)) {
+    return {};
+  }
+  auto value = increment;
+  for (int32_t digits = 0; digits <= MAX_PRECISION_DIGITS; ++digits) {
+    if (value >= 0.5 && std::fabs(value - std::round(value)) < 1.0e-6) {
+      return static_cast<Precision>(static_cast<int32_t>(Precision::_0) + digits);
+    }
+    value *= 10.0;
+  }
+  return {};
+}
 }  // namespace
 
 // === IMPLEMENTATION ===
@@ -120,22 +142,46 @@ Rest::Rest(Handler &handler, io::Context &context, uint16_t stream_id, Shared &s
       rate_limiter_{
           .request_weight_1m = create_metrics(shared.settings, name_, "requests"sv, "1m"sv),
       },
-      shared_{shared}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }} {
+      shared_{shared}, download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+          .depth_request = {shared.timer_wheel, *this, TIMER_DEPTH_REQUEST},
+          .time_series_request = {shared.timer_wheel, *this, TIMER_TIME_SERIES_REQUEST},
+      } {
 }
 
 void Rest::operator()(Event<Start> const &) {
   (*connection_).start();
+  timer_.refresh.start(clock::get_system());
+  shared_.depth_request_queue.attach(&timer_.depth_request);
+  shared_.time_series_request_queue.attach(&timer_.time_series_request);
 }
 
 void Rest::operator()(Event<Stop> const &) {
+  shared_.depth_request_queue.attach(nullptr);
+  shared_.time_series_request_queue.attach(nullptr);
+  timer_.time_series_request.cancel();
+  timer_.depth_request.cancel();
+  timer_.refresh.stop();
   (*connection_).stop();
 }
 
-void Rest::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
-  (*connection_).refresh(now);
-  if (ready()) {
-    check_request_queue(now);
+// tools::TimerWheel::Handler
+
+void Rest::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      (*connection_).refresh(now);
+      break;
+    case TIMER_DEPTH_REQUEST:
+      check_request_queue(shared_.depth_request_queue, timer_.depth_request, [&](auto &symbol) { get_depth(symbol); }, now);
+      break;
+    case TIMER_TIME_SERIES_REQUEST:
+      check_request_queue(shared_.time_series_request_queue, timer_.time_series_request, [&](auto &symbol) { get_kline(symbol); }, now);
+      break;
+    default:
+      assert(false);
   }
 }
 
@@ -202,6 +248,7 @@ void Rest::operator()(Trace<web::rest::Client::Header> const &event) {
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.request_weight_1m.set(value);
+      shared_.download_governor.sync(1min, shared_.limits.request_weight_1m, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -276,16 +323,17 @@ void Rest::get_exchange_info() {
         .body = {},
         .quality_of_service = {},
     };
-    auto callback = [this, sequence = download_.sequence()]([[maybe_unused]] auto &request_id, auto &response) {
+    auto callback = [this, sequence = download_.sequence(), start = clock::get_realtime<std::chrono::nanoseconds>()](
+                        [[maybe_unused]] auto &request_id, auto &response) {
       TraceInfo trace_info;
       Trace event{trace_info, response};
-      get_exchange_info_ack(event, sequence);
+      get_exchange_info_ack(event, sequence, start);
     };
     (*connection_)("exchange-info"sv, request, callback);
   });
 }
 
-void Rest::get_exchange_info_ack(Trace<web::rest::Response> const &event, uint32_t sequence) {
+void Rest::get_exchange_info_ack(Trace<web::rest::Response> const &event, uint32_t sequence, std::chrono::nanoseconds start) {
   auto const STATE = RestState::EXCHANGE_INFO;
   profile_.exchange_info_ack([&]() {
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
@@ -299,6 +347,7 @@ void Rest::get_exchange_info_ack(Trace<web::rest::Response> const &event, uint32
         log::info("Download state={} has already been processed"sv, STATE);
       } else {
         json::ExchangeInfoAck exchange_info_ack{body, decode_buffer_};
+        shared_.clock_offset.update(start, clock::get_realtime<std::chrono::nanoseconds>(), exchange_info_ack.server_time);
         Trace event_2{event, exchange_info_ack};
         (*this)(event_2);
         download_.check(STATE);
@@ -340,6 +389,7 @@ void Rest::operator()(Trace<json::ExchangeInfoAck> const &event) {
     auto min_trade_vol = std::pow(10.0, -static_cast<double>(item.base_asset_precision));
     auto max_trade_vol = NaN;
     auto trade_vol_step_size = min_trade_vol;
+    tools::PreTrade::Limits pre_trade_limits;
     for (auto &filter : item.filters) {
       switch (filter.filter_type) {
         using enum json::FilterType::type_t;
@@ -350,20 +400,26 @@ void Rest::operator()(Trace<json::ExchangeInfoAck> const &event) {
           tick_size = filter.tick_size;
           break;
         case PERCENT_PRICE:
+          pre_trade_limits.multiplier_up = filter.multiplier_up;
+          pre_trade_limits.multiplier_down = filter.multiplier_down;
           break;
         case LOT_SIZE:
           min_trade_vol = filter.min_qty;
           max_trade_vol = filter.max_qty;
           trade_vol_step_size = filter.step_size;
+          pre_trade_limits.max_quantity = filter.max_qty;
           break;
         case MIN_NOTIONAL:
           // min_notional = filter.min_notional;
+          pre_trade_limits.min_notional = filter.notional;
           break;
         case ICEBERG_PARTS:
           break;
         case MARKET_LOT_SIZE:
+          pre_trade_limits.max_market_quantity = filter.max_qty;
           break;
         case MAX_NUM_ORDERS:
+          pre_trade_limits.max_open_orders = std::max(filter.limit, 0);
           break;
         case MAX_NUM_ALGO_ORDERS:
           break;
@@ -423,6 +479,10 @@ void Rest::operator()(Trace<json::ExchangeInfoAck> const &event) {
       log::info<1>(R"(Drop symbol="{}")"sv, item.symbol);
       continue;
     }
+    auto &instrument = shared_.get_instrument(item.symbol);
+    instrument.pre_trade.set_limits(pre_trade_limits);
+    instrument.price_precision = compute_precision(tick_size);
+    instrument.quantity_precision = compute_precision(trade_vol_step_size);
     auto create_symbol = [](auto const &value) {
       std::string tmp{value};
       std::ranges::transform(tmp, std::begin(tmp), [](auto item) { return std::tolower(item); });
@@ -547,14 +607,14 @@ void Rest::operator()(Trace<json::DepthAck> const &event, std::string_view const
       if (shared_.settings.ws.mbp_request_max_retries && shared_.settings.ws.mbp_request_max_retries < retries) {
         log::fatal(R"(Unexpected: symbol="{}", retries={})"sv, symbol, retries);
       }
-      shared_.depth_request_queue.emplace_back(symbol);
+      shared_.depth_request_queue.emplace_back(symbol, clock::get_system());
     };
     sequencer(mbp.bids, mbp.asks, sequence, false, publish_snapshot, request_snapshot);
   } catch (BadState &) {
     log::warn(R"(RESUBSCRIBE symbol="{}")"sv, symbol);
     // XXX HANS publish stale
     sequencer.clear();
-    shared_.depth_request_queue.emplace_back(symbol);
+    shared_.depth_request_queue.emplace_back(symbol, clock::get_system());
   }
 }
 
@@ -637,9 +697,14 @@ void Rest::operator()(Trace<json::KlineAck> const &event, std::string_view const
 
 // request
 
-void Rest::check_request_queue(std::chrono::nanoseconds now) {
-  shared_.depth_request_queue.dispatch([&](auto now) { return shared_.rate_limiter.can_request(now); }, [&](auto &symbol) { get_depth(symbol); }, now);
-  shared_.time_series_request_queue.dispatch([&](auto now) { return shared_.rate_limiter.can_request(now); }, [&](auto &symbol) { get_kline(symbol); }, now);
+// note! the timer is scheduled for when the next request is due (or when the connection could be ready)
+template <typename Callback>
+void Rest::check_request_queue(tools::RequestQueue<std::string> &queue, tools::TimerWheel::Timer &timer, Callback callback, std::chrono::nanoseconds now) {
+  if (!ready()) {
+    timer.schedule(now + shared_.settings.misc.connection_refresh_freq);
+    return;
+  }
+  queue.dispatch([&](auto now) { return shared_.rate_limiter.can_request(now); }, callback, now);
 }
 
 // helpers
@@ -30,6 +30,10 @@
 
 // #include "roq/binance_futures/json/listen_key.hpp"
 
+#include "roq/binance_futures/tools/request_queue.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 #include "roq/binance_futures/json/depth_ack.hpp"
 #include "roq/binance_futures/json/exchange_info_ack.hpp"
 #include "roq/binance_futures/json/kline_ack.hpp"
@@ -40,7 +44,7 @@
 namespace roq {
 namespace binance_futures {
 
-struct Rest final : public web::rest::Client::Handler {
+struct Rest final : public web::rest::Client::Handler, public tools::TimerWheel::Handler {
   struct SymbolsUpdate final {
     std::vector<Symbol> &symbols;
   };
@@ -64,7 +68,6 @@ struct Rest final : public web::rest::Client::Handler {
 
   void operator()(Event<Start> const &);
   void operator()(Event<Stop> const &);
-  void operator()(Event<Timer> const &);
 
   void operator()(metrics::Writer &) const;
 
@@ -78,6 +81,10 @@ struct Rest final : public web::rest::Client::Handler {
   void operator()(Trace<web::rest::Client::Header> const &) override;
   void operator()(Trace<web::rest::Client::MessageEnd> const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
   void operator()(ConnectionStatus);
 
   uint32_t download(RestState state);
@@ -85,7 +92,7 @@ struct Rest final : public web::rest::Client::Handler {
   // exchange-info
 
   void get_exchange_info();
-  void get_exchange_info_ack(Trace<web::rest::Response> const &, uint32_t sequence);
+  void get_exchange_info_ack(Trace<web::rest::Response> const &, uint32_t sequence, std::chrono::nanoseconds start);
   void operator()(Trace<json::ExchangeInfoAck> const &);
 
   // depth
@@ -102,7 +109,8 @@ struct Rest final : public web::rest::Client::Handler {
 
   // helpers
 
-  void check_request_queue(std::chrono::nanoseconds now);
+  template <typename Callback>
+  void check_request_queue(tools::RequestQueue<std::string> &, tools::TimerWheel::Timer &, Callback, std::chrono::nanoseconds now);
 
   void process_response(web::rest::Response const &, auto error_handler, auto success_handler);
 
@@ -136,6 +144,12 @@ struct Rest final : public web::rest::Client::Handler {
   // state
   ConnectionStatus status_ = {};
   core::Download<RestState> download_;
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+    tools::TimerWheel::Timer depth_request;
+    tools::TimerWheel::Timer time_series_request;
+  } timer_;
 };
 
 }  // namespace binance_futures
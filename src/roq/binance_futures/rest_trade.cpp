@@ -12,6 +12,7 @@
 #include "roq/utils/update.hpp"
 
 #include "roq/utils/charconv/from_chars.hpp"
+#include "roq/utils/charconv/to_string.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
 
@@ -41,6 +42,9 @@ auto const X_MBX_ORDER_COUNT_1M = "x-mbx-order-count-1m"sv;
 size_t const MAX_DECODE_BUFFER_DEPTH = 1;
 
 size_t const DOWNLOAD_TRADES_LIMIT = 1000;
+uint32_t const USER_TRADES_WEIGHT = 5;
+
+uint32_t const TIMER_REFRESH = 1;
 }  // namespace
 
 // === HELPERS ===
@@ -137,20 +141,40 @@ RestTrade::RestTrade(Handler &handler, io::Context &context, uint16_t stream_id,
           .request_weight_1m = create_metrics(shared.settings, name_, "request_weight"sv, "1m"sv),
           .create_order_1m = create_metrics(shared.settings, name_, "create_order"sv, "1m"sv),
       },
-      account_{account}, shared_{shared}, request_{request} {
+      account_{account}, shared_{shared}, request_{request},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+      } {
 }
 
 void RestTrade::operator()(Event<Start> const &) {
   (*connection_).start();
+  timer_.refresh.start(clock::get_system());
 }
 
 void RestTrade::operator()(Event<Stop> const &) {
+  timer_.refresh.stop();
   (*connection_).stop();
 }
 
-void RestTrade::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
+// tools::TimerWheel::Handler
+
+void RestTrade::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      refresh(now);
+      break;
+    default:
+      assert(false);
+  }
+}
+
+void RestTrade::refresh(std::chrono::nanoseconds now) {
   (*connection_).refresh(now);
+  if (ready() && download_trades_ && !download_trades_in_flight_) {
+    get_trades_next();  // note! resume when the request weight budget allows
+  }
   if (ready() && !downloading()) {
     /* XXX FIXME TODO DEPRECATED
     if (!downloading() && request_.respond_balance < request_.request_balance) {
@@ -171,8 +195,8 @@ void RestTrade::operator()(Event<Timer> const &event) {
     }
     if (!downloading() && request_.respond_trades < request_.request_trades) {
       log::info<1>("Download trades..."sv);
-      get_trades();
       download_trades_ = true;
+      get_trades();
     }
   }
 }
@@ -217,6 +241,8 @@ void RestTrade::operator()(Trace<web::rest::Client::Disconnected> const &) {
   download_account_ = false;
   download_orders_ = false;
   download_trades_ = false;
+  download_trades_in_flight_ = false;
+  trade_download_.reset();
 }
 
 void RestTrade::operator()(Trace<web::rest::Client::Latency> const &event) {
@@ -248,6 +274,7 @@ void RestTrade::operator()(Trace<web::rest::Client::Header> const &event) {
       };
       shared_.rate_limits.emplace_back(rate_limit);
       rate_limiter_.request_weight_1m.set(value);
+      shared_.download_governor.sync(1min, shared_.limits.request_weight_1m, value, clock::get_system());
     } catch (RuntimeError &) {
       log::warn<5>(R"(Failed to parse text="{}")"sv, header.value);
     }
@@ -372,6 +399,7 @@ void RestTrade::operator()(Trace<json::AccountBalanceAck> const &event) {
         .exchange_time_utc = item.update_time,
         .sending_time_utc = {},
     };
+    request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
     create_trace_and_dispatch(handler_, trace_info, funds_update, true);
     if (!std::isnan(item.cross_wallet_balance)) {
       auto funds_update = FundsUpdate{
@@ -386,6 +414,7 @@ void RestTrade::operator()(Trace<json::AccountBalanceAck> const &event) {
           .exchange_time_utc = item.update_time,
           .sending_time_utc = {},
       };
+      request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
       create_trace_and_dispatch(handler_, trace_info, funds_update, true);
     }
   }
@@ -462,6 +491,13 @@ void RestTrade::operator()(Trace<json::AccountStatusAck> const &event) {
         .exchange_time_utc = account_status_ack.update_time,
         .sending_time_utc = {},
     };
+    auto hedged = !std::empty(item.position_side) && item.position_side != "BOTH"sv;
+    // note! older than the last fill (the position published from fills is more recent)
+    if (!request_.position_keeper.reconcile(item.symbol, margin_mode, item.position_amt, item.update_time, hedged) && shared_.settings.ws.position_from_fills) {
+      log::info<3>(R"(Drop position update (older than the last fill): symbol="{}")"sv, item.symbol);
+      continue;
+    }
+    request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity);
     create_trace_and_dispatch(handler_, trace_info, position_update, true);
   }
 }
@@ -521,7 +557,8 @@ void RestTrade::operator()(Trace<json::OpenOrdersAck> const &event) {
       continue;
     }
     open_orders_symbols_.emplace(item.symbol);
-    auto external_order_id = fmt::format("{}"sv, item.order_id);  // alloc
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), item.order_id);
     auto order_update = server::oms::OrderUpdate{
         .account = account_.name,
         .exchange = shared_.settings.exchange,
@@ -559,71 +596,91 @@ void RestTrade::operator()(Trace<json::OpenOrdersAck> const &event) {
     Trace event_2{trace_info, order_update};
     (*this)(event_2, item.client_order_id);
   }
+  shared_.reconcile_order_state(account_.name, open_orders_ack.data);
 }
 
 // trades
 
-// XXX FIXME download_trades_count
+// note! one symbol (and one page) at a time, resuming from the last seen trade id
 void RestTrade::get_trades() {
-  // XXX disable for now
-  log::warn("!!! TRADES DOWNLOAD HAS BEEN **DISABLED** !!!"sv);
-  request_.respond_trades = clock::get_system();  // completion
-  download_trades_ = false;
-  download_trades_is_first_ = false;
-  return;
-  // XXX
+  trade_download_.begin(shared_.settings.download.symbols, clock::get_system());
+  get_trades_next();
+}
+
+void RestTrade::get_trades_next() {
+  auto &trade_cursor = request_.trade_cursor;
+  if (!trade_download_.downloading()) {
+    log::info<1>("Download user-trades has COMPLETED!"sv);
+    trade_cursor.downloaded(trade_download_.start());
+    trade_cursor.save();
+    request_.respond_trades = clock::get_system();  // completion
+    download_trades_ = false;
+    download_trades_is_first_ = false;
+    return;
+  }
+  if (!shared_.download_governor(clock::get_system(), USER_TRADES_WEIGHT)) {
+    log::info<3>("Download user-trades is waiting for request weight budget..."sv);
+    return;  // note! retried from refresh
+  }
   profile_.trades([&]() {
-    auto &symbols = shared_.settings.download.symbols;
-    for (auto &symbol : symbols) {
+    auto symbol = trade_download_.current();
+    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
+    auto limit = shared_.settings.download.trades_limit ? shared_.settings.download.trades_limit : DOWNLOAD_TRADES_LIMIT;
+    std::string_view body;
+    if (auto trade_id = trade_cursor.get(symbol); trade_id) {
+      log::info<1>(R"(Download trades: symbol="{}", from_id={})"sv, symbol, trade_id + 1);
+      body = json::Encoder::user_trades_from_id_url(encode_buffer_, symbol, trade_id + 1, limit, recv_window);
+    } else {
+      // note! fall back to the lookback window if we haven't seen any trades for this symbol
       auto lookback = get_download_trades_lookback(shared_.settings, download_trades_is_first_);
-      log::info<1>("Download trades: lookback={}"sv, lookback);
-      auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
+      log::info<1>(R"(Download trades: symbol="{}", lookback={})"sv, symbol, lookback);
       auto end_time = clock::get_realtime<std::chrono::milliseconds>();
       auto start_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - lookback);
-      auto limit = shared_.settings.download.trades_limit ? shared_.settings.download.trades_limit : DOWNLOAD_TRADES_LIMIT;
-      auto body = json::Encoder::user_trades_url(encode_buffer_, symbol, start_time, end_time, limit, recv_window);
-      auto query = account_.create_rest_signature_query(body);
-      auto headers = account_.get_rest_headers();
-      auto request = web::rest::Request{
-          .method = web::http::Method::GET,
-          .path = shared_.api.simple.user_trades,
-          .query = query,
-          .accept = web::http::Accept::APPLICATION_JSON,
-          .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
-          .headers = headers,
-          .body = {},  // body,
-          .quality_of_service = {},
-      };
-      auto callback = [this]([[maybe_unused]] auto &request_id, auto &response) {
-        TraceInfo trace_info;
-        Trace event{trace_info, response};
-        get_trades_ack(event);
-      };
-      log::info<1>("Download user-trades..."sv);
-      (*connection_)("user-trades"sv, request, callback);
+      body = json::Encoder::user_trades_url(encode_buffer_, symbol, start_time, end_time, limit, recv_window);
     }
+    auto query = account_.create_rest_signature_query(body);
+    auto headers = account_.get_rest_headers();
+    auto request = web::rest::Request{
+        .method = web::http::Method::GET,
+        .path = shared_.api.simple.user_trades,
+        .query = query,
+        .accept = web::http::Accept::APPLICATION_JSON,
+        .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
+        .headers = headers,
+        .body = {},  // body,
+        .quality_of_service = {},
+    };
+    auto callback = [this, limit]([[maybe_unused]] auto &request_id, auto &response) {
+      TraceInfo trace_info;
+      Trace event{trace_info, response};
+      get_trades_ack(event, limit);
+    };
+    (*connection_)("user-trades"sv, request, callback);
+    download_trades_in_flight_ = true;
   });
 }
 
-void RestTrade::get_trades_ack(Trace<web::rest::Response> const &event) {
+void RestTrade::get_trades_ack(Trace<web::rest::Response> const &event, uint32_t limit) {
+  download_trades_in_flight_ = false;
   profile_.trades_ack([&]() {
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
       log::warn(R"(Download user-trades has FAILED: origin={}, error={}, status={}, text="{}")"sv, origin, error, status, text);
       request_.respond_trades = clock::get_system();
+      trade_download_.reset();
       download_trades_ = false;
     };
     auto handle_success = [&](auto &body) {
       json::TradesAck trades_ack{body, decode_buffer_};
       Trace event_2{event, trades_ack};
       (*this)(event_2);
-      // completion
-      log::info<1>("Download user-trades has COMPLETED!"sv);
-      request_.respond_trades = clock::get_system();
-      download_trades_ = false;
-      download_trades_is_first_ = false;
+      auto more = std::size(trades_ack.data) >= limit;  // note! a full page means there could be more
+      trade_download_.next(more);
     };
     process_response(event, handle_error, handle_success);
   });
+  if (download_trades_) {
+    get_trades_next();
+  }
 }
 
 // note! always external because we don't get ClOrdID
@@ -632,6 +689,7 @@ void RestTrade::operator()(Trace<json::TradesAck> const &event) {
   log::info<2>("trades_ack={}"sv, trades_ack);
   for (auto &item : trades_ack.data) {
     log::info<2>("item={}"sv, item);
+    request_.trade_cursor.update(item.symbol, item.id);
     auto liquidity = item.maker ? Liquidity::MAKER : Liquidity::TAKER;
     auto side = map(item.side).template get<Side>();
     auto ref_data = shared_.get_ref_data(shared_.settings.exchange, item.symbol);
@@ -687,13 +745,13 @@ void RestTrade::open_orders_cancel_all(Event<CancelAllOrders> const &event, std:
       if (!std::empty(cancel_all_orders.symbol) && symbol != cancel_all_orders.symbol) {
         continue;
       }
-      auto body = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
-      auto query = account_.create_rest_signature_body(body);
+      auto params = json::Encoder::all_open_orders_url(encode_buffer_, symbol, recv_window);
+      auto body = account_.sign_rest_body(encode_buffer_, params);
       auto headers = account_.get_rest_headers();
       auto request = web::rest::Request{
           .method = web::http::Method::DELETE,
           .path = shared_.api.simple.all_open_orders,
-          .query = query,
+          .query = {},
           .accept = web::http::Accept::APPLICATION_JSON,
           .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
           .headers = headers,
@@ -836,14 +894,32 @@ void RestTrade::process_response(web::rest::Response const &response, auto error
 template <typename... Args>
 void RestTrade::operator()(Trace<server::oms::Response> const &event, uint8_t user_id, uint64_t order_id, Args &&...args) {
   auto &[trace_info, response] = event;
-  if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<Args>(args)..., []([[maybe_unused]] auto &order) {})) {
-  } else {
-    log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+  auto update_order = [&](auto &&...args_2) {
+    if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<decltype(args_2)>(args_2)..., [](auto &) {})) {
+    } else {
+      log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+    }
+  };
+  if constexpr (sizeof...(Args) == 1) {
+    // note! the response must always be delivered
+    if (!shared_.check_order_update(args...)) {
+      log::info<3>("Drop order update (redundant or out of order): user_id={}, order_id={}"sv, user_id, order_id);
+      update_order();
+      return;
+    }
   }
+  update_order(std::forward<Args>(args)...);
 }
 
 void RestTrade::operator()(Trace<server::oms::OrderUpdate> const &event, std::string_view const &client_order_id) {
   auto &[trace_info, order_update] = event;
+  if (!shared_.check_order_update(order_update)) {
+    log::info<3>(R"(Drop order update (redundant or out of order): client_order_id="{}")"sv, client_order_id);
+    return;
+  }
+  if (shared_.update_quote_leg(request_.quote_legs, order_update) != SOURCE_NONE) {
+    return;  // note! quote legs are not known to the order management system
+  }
   if (shared_.update_order(client_order_id, stream_id_, trace_info, order_update, [&]([[maybe_unused]] auto &order) {})) {
   } else {
     log::warn("*** EXTERNAL ORDER ***"sv);
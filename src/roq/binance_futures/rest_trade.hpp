@@ -26,6 +26,10 @@
 #include "roq/binance_futures/request.hpp"
 #include "roq/binance_futures/shared.hpp"
 
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+#include "roq/binance_futures/tools/trade_download.hpp"
+
 #include "roq/binance_futures/json/account_balance_ack.hpp"
 #include "roq/binance_futures/json/account_status_ack.hpp"
 #include "roq/binance_futures/json/open_orders_ack.hpp"
@@ -36,7 +40,7 @@
 namespace roq {
 namespace binance_futures {
 
-struct RestTrade final : public web::rest::Client::Handler {
+struct RestTrade final : public web::rest::Client::Handler, public tools::TimerWheel::Handler {
   struct ListenKeyUpdate final {
     std::string_view account;
     std::string_view listen_key;
@@ -61,7 +65,6 @@ struct RestTrade final : public web::rest::Client::Handler {
 
   void operator()(Event<Start> const &);
   void operator()(Event<Stop> const &);
-  void operator()(Event<Timer> const &);
 
   void operator()(metrics::Writer &);
 
@@ -77,6 +80,12 @@ struct RestTrade final : public web::rest::Client::Handler {
   void operator()(Trace<web::rest::Client::Header> const &) override;
   void operator()(Trace<web::rest::Client::MessageEnd> const &) override;
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
+  void refresh(std::chrono::nanoseconds now);
+
   void operator()(ConnectionStatus);
 
   // account-balance
@@ -100,7 +109,8 @@ struct RestTrade final : public web::rest::Client::Handler {
   // trades
 
   void get_trades();
-  void get_trades_ack(Trace<web::rest::Response> const &);
+  void get_trades_next();
+  void get_trades_ack(Trace<web::rest::Response> const &, uint32_t limit);
   void operator()(Trace<json::TradesAck> const &);
 
   // open-orders-cancel-all
@@ -161,8 +171,14 @@ struct RestTrade final : public web::rest::Client::Handler {
   bool download_account_ = false;
   bool download_orders_ = false;
   bool download_trades_ = false;
+  bool download_trades_in_flight_ = false;
   std::vector<char> encode_buffer_;
   bool download_trades_is_first_ = true;
+  tools::TradeDownload trade_download_;  // note! never shared (the trade cursor is)
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+  } timer_;
 };
 
 }  // namespace binance_futures
@@ -11,6 +11,7 @@
 #include "roq/binance_futures/flags/misc.hpp"
 #include "roq/binance_futures/flags/request.hpp"
 #include "roq/binance_futures/flags/rest.hpp"
+#include "roq/binance_futures/flags/risk.hpp"
 #include "roq/binance_futures/flags/ws.hpp"
 #include "roq/binance_futures/flags/ws_api.hpp"
 
@@ -25,6 +26,7 @@ struct Settings final : public server::flags::Settings, public flags::Flags {
   flags::WS ws;
   flags::MBP mbp;
   flags::Request request;
+  flags::Risk risk;
   flags::WS_API ws_api_2;  // note! overlapping with flags::Flags
 
  private:
@@ -48,6 +50,7 @@ struct fmt::formatter<roq::binance_futures::Settings> {
         R"(ws={}, )"
         R"(mbp={}, )"
         R"(request={}, )"
+        R"(risk={}, )"
         R"(ws_api={}, )"
         R"(server={})"
         R"(}})"sv,
@@ -57,6 +60,7 @@ struct fmt::formatter<roq::binance_futures::Settings> {
         value.ws,
         value.mbp,
         value.request,
+        value.risk,
         value.ws_api_2,
         static_cast<roq::server::Settings const &>(value));
   }
@@ -2,9 +2,25 @@
 
 #include "roq/binance_futures/shared.hpp"
 
+#include <algorithm>
+#include <charconv>
+
+#include "roq/logging.hpp"
+
+using namespace std::literals;
+
 namespace roq {
 namespace binance_futures {
 
+// === CONSTANTS ===
+
+namespace {
+auto const ORDER_LATENCY_HORIZON = 1min;
+
+size_t const MAX_COMPLETED_ORDERS = 1024;  // note! per symbol
+size_t const MAX_ORDERS = 4096;            // note! per symbol
+}  // namespace
+
 // === HELPERS ===
 
 namespace {
@@ -15,14 +31,168 @@ auto create_sequencer(auto &settings) {
   };
   return market::mbp::Sequencer{options};
 }
+
+// note! userDataStream.subscribe is only available on the ws-api end-points (the ws-fapi end-points only support listen keys)
+bool supports_user_data_stream_subscribe(auto &settings) {
+  if (!settings.ws_api_2.user_stream) {
+    return false;
+  }
+  auto uri = fmt::format("{}"sv, settings.ws_api_2.uri);
+  if (uri.find("/ws-api/"sv) != std::string::npos) {
+    return true;
+  }
+  log::warn(R"(User data stream subscription is not supported (falling back to listen key): uri="{}")"sv, uri);
+  return false;
+}
+
+// note! the average spacing allowed by the rate-limiter
+std::chrono::nanoseconds create_request_retry(auto &settings) {
+  return settings.request.limit_interval / std::max<uint32_t>(settings.request.limit, 1);
+}
+
+// note! exchange filters are applied later (when reference data has been downloaded)
+auto create_pre_trade_limits(auto &settings) {
+  auto price_band = settings.risk.price_band / 10000.0;
+  return tools::PreTrade::Limits{
+      .max_notional = settings.risk.max_notional > 0 ? static_cast<double>(settings.risk.max_notional) : NaN,
+      .multiplier_up = settings.risk.price_band > 0 ? 1.0 + price_band : NaN,
+      .multiplier_down = settings.risk.price_band > 0 ? 1.0 - price_band : NaN,
+      .max_open_orders = settings.risk.max_open_orders,
+  };
+}
+
+// note! status ordering (updates must never move an order backwards)
+uint8_t get_rank(OrderStatus order_status) {
+  switch (order_status) {
+    using enum OrderStatus;
+    case UNDEFINED:
+      break;
+    case SENT:
+      return 1;
+    case ACCEPTED:
+      return 2;
+    case SUSPENDED:
+    case WORKING:
+      return 3;
+    case STOPPED:
+    case COMPLETED:
+    case EXPIRED:
+    case CANCELED:
+    case REJECTED:
+      return 4;
+  }
+  return 0;
+}
 }  // namespace
 
 // === IMPLEMENTATION ===
 
-Shared::Shared(server::Dispatcher &dispatcher, Settings const &settings)
+Shared::Shared(server::Dispatcher &dispatcher, Settings const &settings, tools::ClockOffset &clock_offset)
     : settings{settings}, api{API::create(settings)}, dispatcher_{dispatcher}, rate_limiter{settings.request.limit, settings.request.limit_interval},
-      symbols{settings.ws.max_subscriptions_per_stream}, depth_request_queue{settings.ws.mbp_request_delay},
-      allow_unknown_event_types{settings.experimental.allow_unknown_event_types || settings.misc.continue_with_unknown_event_type} {
+      symbols{settings.ws.max_subscriptions_per_stream},
+      depth_request_queue{settings.ws.mbp_request_delay, create_request_retry(settings)}, time_series_request_queue{{}, create_request_retry(settings)},
+      timer_wheel{settings.misc.timer_wheel_resolution},
+      refresh_ticker{timer_wheel, settings.misc.connection_refresh_freq}, cancel_race{settings.rest.request_timeout}, order_latency{ORDER_LATENCY_HORIZON},
+      clock_offset{clock_offset}, download_governor{settings.rest.download_weight_utilization},
+      allow_unknown_event_types{settings.experimental.allow_unknown_event_types || settings.misc.continue_with_unknown_event_type},
+      ws_api_user_stream{supports_user_data_stream_subscribe(settings)} {
+}
+
+std::chrono::nanoseconds Shared::get_request_retry() const {
+  return create_request_retry(settings);
+}
+
+std::chrono::milliseconds Shared::get_order_recv_window() const {
+  if (!settings.rest.order_recv_window_dynamic) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(settings.rest.order_recv_window);
+  }
+  return clock_offset.recv_window(settings.rest.order_recv_window_min, settings.rest.order_recv_window);
+}
+
+// note! logging only (the caller decides what to do with an unknown order)
+void Shared::order_not_found(std::string_view const &client_order_id) const {
+  if (is_external_order(client_order_id)) {
+    log::info<1>(R"(Client order id does not match the format used by the order management system: client_order_id="{}")"sv, client_order_id);
+  }
+}
+
+bool Shared::check_order_update(server::oms::OrderUpdate const &order_update) {
+  std::string_view external_order_id = order_update.external_order_id;
+  int64_t order_id = {};
+  auto [_, ec] = std::from_chars(std::data(external_order_id), std::data(external_order_id) + std::size(external_order_id), order_id);
+  if (ec != std::errc{}) [[unlikely]] {
+    return true;
+  }
+  return check_order_update(order_update, order_id);
+}
+
+bool Shared::check_order_update(server::oms::OrderUpdate const &order_update, int64_t external_order_id) {
+  auto rank = get_rank(order_update.order_status);
+  if (rank == 0) {
+    return true;
+  }
+  auto instrument = find_instrument(order_update.symbol);
+  if (!instrument) [[unlikely]] {
+    return true;
+  }
+  auto update = tools::OrderState::Update{
+      .update_time = order_update.update_time_utc,
+      .rank = rank,
+      .traded_quantity = order_update.traded_quantity,
+      .quantity = order_update.quantity,
+      .price = order_update.price,
+      .completed = rank == 4,
+  };
+  return (*instrument).get_order_state(order_update.account)(external_order_id, update);
+}
+
+void Shared::set_order_route(server::oms::OrderUpdate const &order_update, int64_t external_order_id, tools::OrderState::Route const &route) {
+  auto instrument = find_instrument(order_update.symbol);
+  if (!instrument) [[unlikely]] {
+    return;
+  }
+  (*instrument).get_order_state(order_update.account).set_route(external_order_id, route);
+}
+
+tools::OrderState::Route const *Shared::find_order_route(server::oms::OrderUpdate const &order_update, int64_t external_order_id) {
+  auto instrument = find_instrument(order_update.symbol);
+  if (!instrument) [[unlikely]] {
+    return nullptr;
+  }
+  auto iter = (*instrument).order_state.find(order_update.account);
+  if (iter == std::end((*instrument).order_state)) {
+    return nullptr;
+  }
+  return (*iter).second.find_route(external_order_id);
+}
+
+void Shared::reconcile_order_state(std::string_view const &account, std::span<json::Order const> const &open_orders) {
+  utils::unordered_set<uint64_t> order_ids;
+  for (auto &item : open_orders) {
+    order_ids.emplace(static_cast<uint64_t>(item.order_id));
+  }
+  for (auto &[symbol, instrument] : instruments_) {
+    auto iter = instrument.order_state.find(account);
+    if (iter == std::end(instrument.order_state)) {
+      continue;
+    }
+    auto count = (*iter).second.reconcile([&](auto order_id) { return order_ids.contains(order_id); });
+    if (count) {
+      log::warn(R"(Removed {} working order(s) not reported as open (account="{}", symbol="{}"))"sv, count, account, symbol);
+    }
+  }
+}
+
+uint8_t Shared::update_quote_leg(tools::QuoteLegs &quote_legs, server::oms::OrderUpdate const &order_update) {
+  auto leg = quote_legs.find(order_update.symbol, order_update.client_order_id);
+  if (!leg) {
+    return SOURCE_NONE;
+  }
+  auto user_id = (*leg).user_id;
+  if (get_rank(order_update.order_status) == 4) {
+    quote_legs.remove(order_update.symbol, order_update.client_order_id);
+  }
+  return user_id;
 }
 
 Shared::Instrument &Shared::get_instrument(std::string_view const &symbol) {
@@ -35,9 +205,26 @@ Shared::Instrument &Shared::get_instrument(std::string_view const &symbol) {
   return (*iter).second;
 }
 
+Shared::Instrument *Shared::find_instrument(std::string_view const &symbol) {
+  auto iter = instruments_.find(symbol);
+  if (iter == std::end(instruments_)) [[unlikely]] {
+    return nullptr;
+  }
+  return &(*iter).second;
+}
+
 // instrument
 
-Shared::Instrument::Instrument(Settings const &settings) : sequencer{create_sequencer(settings)} {
+Shared::Instrument::Instrument(Settings const &settings)
+    : sequencer{create_sequencer(settings)}, pre_trade{create_pre_trade_limits(settings)} {
+}
+
+tools::OrderState &Shared::Instrument::get_order_state(std::string_view const &account) {
+  auto iter = order_state.find(account);
+  if (iter == std::end(order_state)) [[unlikely]] {
+    iter = order_state.try_emplace(std::string{account}, MAX_COMPLETED_ORDERS, MAX_ORDERS).first;
+  }
+  return (*iter).second;
 }
 
 }  // namespace binance_futures
@@ -3,7 +3,12 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
+#include <map>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,7 +18,6 @@
 #include "roq/utils/container.hpp"
 
 #include "roq/core/symbols.hpp"
-#include "roq/core/timer_queue.hpp"
 
 #include "roq/core/limit/rate_limiter.hpp"
 
@@ -22,21 +26,69 @@
 #include "roq/binance_futures/api.hpp"
 #include "roq/binance_futures/settings.hpp"
 
+#include "roq/binance_futures/json/order.hpp"
+#include "roq/binance_futures/json/order_templates.hpp"
+
+#include "roq/binance_futures/tools/client_order_id_filter.hpp"
+#include "roq/binance_futures/tools/clock_offset.hpp"
+#include "roq/binance_futures/tools/governor.hpp"
+#include "roq/binance_futures/tools/order_latency.hpp"
+#include "roq/binance_futures/tools/order_state.hpp"
+#include "roq/binance_futures/tools/pre_trade.hpp"
+#include "roq/binance_futures/tools/quote_legs.hpp"
+#include "roq/binance_futures/tools/race.hpp"
+#include "roq/binance_futures/tools/request_queue.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 namespace roq {
 namespace binance_futures {
 
 struct Shared final {
-  Shared(server::Dispatcher &, Settings const &);
+  Shared(server::Dispatcher &, Settings const &, tools::ClockOffset &);
 
   Shared(Shared const &) = delete;
 
+  // note! dynamic (if enabled) and bounded by --rest_order_recv_window
+  std::chrono::milliseconds get_order_recv_window() const;
+
+  // note! retry delay for requests blocked by the rate-limiter
+  std::chrono::nanoseconds get_request_retry() const;
+
   auto discard_symbol(std::string_view const &name) const { return dispatcher_.discard_symbol(name); }
 
-  template <typename... Args>
-  auto update_order(Args &&...args) {
-    return dispatcher_.update_order(std::forward<Args>(args)...);
+  // note! the lookup is never skipped, the client order id filter is only used to classify orders not found (e.g. from the web ui)
+  template <typename T, typename... Args>
+  bool update_order(T const &key, Args &&...args) {
+    auto result = dispatcher_.update_order(key, std::forward<Args>(args)...);
+    if constexpr (std::is_convertible_v<T, std::string_view>) {
+      if (!result) {
+        order_not_found(key);
+      }
+    }
+    return result;
   }
 
+  bool is_external_order(std::string_view const &client_order_id) const { return client_order_id_filter.is_external(client_order_id); }
+
+  void order_not_found(std::string_view const &client_order_id) const;
+
+  // returns false if the update is redundant or out of order (note! the state is recorded otherwise)
+  // note! updates for unknown symbols are always passed through
+  bool check_order_update(server::oms::OrderUpdate const &);
+  bool check_order_update(server::oms::OrderUpdate const &, int64_t external_order_id);
+
+  // note! routing as found by the order management system (used to publish fills when the order update is dropped)
+  void set_order_route(server::oms::OrderUpdate const &, int64_t external_order_id, tools::OrderState::Route const &);
+  tools::OrderState::Route const *find_order_route(server::oms::OrderUpdate const &, int64_t external_order_id);
+
+  // note! working orders not included in the download are forgotten (the terminal update must have been missed)
+  void reconcile_order_state(std::string_view const &account, std::span<json::Order const> const &open_orders);
+
+  // returns SOURCE_NONE if not a quote leg (otherwise the user who created the quote)
+  // note! completed legs are removed
+  uint8_t update_quote_leg(tools::QuoteLegs &, server::oms::OrderUpdate const &);
+
   template <typename... Args>
   auto operator()(Args &&...args) {
     return dispatcher_(std::forward<Args>(args)...);
@@ -71,6 +123,17 @@ struct Shared final {
     int64_t tob_last_update_id = {};
     int64_t mbp_last_update_id = {};
     market::mbp::Sequencer sequencer;
+    std::map<std::string, tools::OrderState, std::less<>> order_state;  // note! per account
+    tools::PreTrade pre_trade;
+    Precision price_precision = {};     // note! from tick size
+    Precision quantity_precision = {};  // note! from lot size
+
+    tools::OrderState &get_order_state(std::string_view const &account);
+
+    size_t get_working_orders(std::string_view const &account) const {
+      auto iter = order_state.find(account);
+      return iter == std::end(order_state) ? size_t{} : (*iter).second.working();
+    }
 
     bool tob_update(int64_t update_id) {
       if (update_id < tob_last_update_id) {
@@ -91,6 +154,9 @@ struct Shared final {
 
   Instrument &get_instrument(std::string_view const &symbol);
 
+  // note! never creates the instrument (nullptr if unknown)
+  Instrument *find_instrument(std::string_view const &symbol);
+
  private:
   utils::unordered_map<std::string, Instrument> instruments_;
 
@@ -99,9 +165,17 @@ struct Shared final {
  public:
   core::limit::RateLimiter rate_limiter;
   core::Symbols symbols;
-  core::TimerQueue<std::string> depth_request_queue;
-  core::TimerQueue<std::string> time_series_request_queue;
+  tools::RequestQueue<std::string> depth_request_queue;        // note! dispatched by rest
+  tools::RequestQueue<std::string> time_series_request_queue;  // note! dispatched by rest
   std::vector<RateLimit> rate_limits;
+  tools::TimerWheel timer_wheel;
+  tools::Ticker refresh_ticker;  // note! connection refresh is shared by all components
+  json::OrderTemplates order_templates;
+  tools::Race cancel_race;
+  tools::OrderLatency order_latency;
+  tools::ClockOffset &clock_offset;
+  tools::Governor download_governor;  // note! request weight budget for (background) downloads
+  tools::ClientOrderIdFilter client_order_id_filter;
 
   struct {
     uint32_t request_weight_1m = {};
@@ -112,6 +186,7 @@ struct Shared final {
   std::vector<Bar> bars;
 
   bool const allow_unknown_event_types;
+  bool const ws_api_user_stream;  // note! --ws_api_user_stream (if supported by the end-point)
 };
 
 }  // namespace binance_futures
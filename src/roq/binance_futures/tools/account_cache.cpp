@@ -0,0 +1,51 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/account_cache.hpp"
+
+#include <cmath>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === HELPERS ===
+
+namespace {
+// note! NaN means "unknown" and should compare equal to itself
+bool is_equal(double lhs, double rhs) {
+  return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+bool AccountCache::balance(MarginMode margin_mode, std::string_view const &currency, double balance, double hold) {
+  return update(balances_, margin_mode, currency, {.first = balance, .second = hold});
+}
+
+bool AccountCache::position(MarginMode margin_mode, std::string_view const &symbol, double long_quantity, double short_quantity) {
+  return update(positions_, margin_mode, symbol, {.first = long_quantity, .second = short_quantity});
+}
+
+void AccountCache::clear() {
+  balances_.clear();
+  positions_.clear();
+}
+
+bool AccountCache::update(std::map<Key, Value, Compare> &values, MarginMode margin_mode, std::string_view const &name, Value const &value) {
+  auto iter = values.find(KeyView{.margin_mode = margin_mode, .name = name});
+  if (iter == std::end(values)) {
+    values.emplace(Key{.margin_mode = margin_mode, .name = std::string{name}}, value);
+    return true;
+  }
+  auto &current = (*iter).second;
+  if (is_equal(current.first, value.first) && is_equal(current.second, value.second)) {
+    return false;
+  }
+  current = value;
+  return true;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
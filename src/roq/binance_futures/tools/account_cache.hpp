@@ -0,0 +1,69 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "roq/margin_mode.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// last published balances and positions (keyed by margin mode and currency or symbol)
+// note! used to skip incremental updates when nothing has changed (snapshots should always be published, but must also update the cache)
+
+struct AccountCache final {
+  AccountCache() = default;
+
+  AccountCache(AccountCache &&) = default;
+  AccountCache(AccountCache const &) = delete;
+
+  size_t size() const { return std::size(balances_) + std::size(positions_); }
+
+  // returns false if nothing has changed
+  bool balance(MarginMode, std::string_view const &currency, double balance, double hold);
+  bool position(MarginMode, std::string_view const &symbol, double long_quantity, double short_quantity);
+
+  void clear();
+
+ protected:
+  struct Key final {
+    MarginMode margin_mode = {};
+    std::string name;
+  };
+
+  struct KeyView final {
+    MarginMode margin_mode = {};
+    std::string_view name;
+  };
+
+  struct Compare final {
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    bool operator()(L const &lhs, R const &rhs) const {
+      if (lhs.margin_mode != rhs.margin_mode) {
+        return lhs.margin_mode < rhs.margin_mode;
+      }
+      return std::string_view{lhs.name} < std::string_view{rhs.name};
+    }
+  };
+
+  struct Value final {
+    double first = {};
+    double second = {};
+  };
+
+  static bool update(std::map<Key, Value, Compare> &, MarginMode, std::string_view const &name, Value const &);
+
+ private:
+  std::map<Key, Value, Compare> balances_;
+  std::map<Key, Value, Compare> positions_;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,45 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <unordered_set>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// set of recently seen keys (the oldest key is forgotten when capacity has been reached)
+
+template <typename Key, typename Hash = std::hash<Key>>
+struct BoundedSet final {
+  explicit BoundedSet(size_t capacity) : capacity_{capacity} {}
+
+  BoundedSet(BoundedSet &&) = delete;
+  BoundedSet(BoundedSet const &) = delete;
+
+  size_t size() const { return std::size(keys_); }
+
+  // returns false if the key has already been seen (otherwise it is remembered)
+  bool operator()(Key const &key) {
+    if (!keys_.emplace(key).second) {
+      return false;
+    }
+    queue_.emplace_back(key);
+    if (std::size(queue_) > capacity_) {
+      keys_.erase(queue_.front());
+      queue_.pop_front();
+    }
+    return true;
+  }
+
+ private:
+  size_t const capacity_;
+  std::unordered_set<Key, Hash> keys_;
+  std::deque<Key> queue_;  // note! insertion order
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,29 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/client_order_id_filter.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+bool ClientOrderIdFilter::operator()(std::string_view const &client_order_id) {
+  if (disabled_ || std::empty(client_order_id)) {
+    return true;
+  }
+  if (length_ == 0) {
+    length_ = std::size(client_order_id);
+    return true;
+  }
+  if (std::size(client_order_id) == length_) {
+    return true;
+  }
+  length_ = {};
+  disabled_ = true;
+  return false;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
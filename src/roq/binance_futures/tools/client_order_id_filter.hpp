@@ -0,0 +1,35 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// classifies client order ids which could not have been created by the order management system (e.g. orders from the web ui)
+// note! the format is learned from the client order ids we send, nothing is classified before the first order
+// note! the filter is permanently disabled if the order management system is seen to use variable length ids
+// note! only used for logging, orders are always looked up
+
+struct ClientOrderIdFilter final {
+  ClientOrderIdFilter() = default;
+
+  ClientOrderIdFilter(ClientOrderIdFilter &&) = delete;
+  ClientOrderIdFilter(ClientOrderIdFilter const &) = delete;
+
+  // returns false if the filter had to be disabled
+  bool operator()(std::string_view const &client_order_id);
+
+  bool is_external(std::string_view const &client_order_id) const { return length_ > 0 && std::size(client_order_id) != length_; }
+
+ private:
+  size_t length_ = {};
+  bool disabled_ = false;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
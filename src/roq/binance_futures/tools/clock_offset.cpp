@@ -0,0 +1,65 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/clock_offset.hpp"
+
+#include <algorithm>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === CONSTANTS ===
+
+namespace {
+// note! same smoothing as TCP round-trip estimation (RFC 6298)
+int64_t const OFFSET_SHIFT = 3;
+int64_t const JITTER_SHIFT = 2;
+int64_t const JITTER_MULTIPLIER = 4;
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+ClockOffset::ClockOffset(bool enabled) : enabled_{enabled} {
+}
+
+std::chrono::milliseconds ClockOffset::recv_window(std::chrono::nanoseconds min, std::chrono::nanoseconds max) const {
+  if (samples_ == 0 || min.count() <= 0) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(max);
+  }
+  auto result = round_trip_ + JITTER_MULTIPLIER * jitter_;
+  result = std::clamp(result, min, std::max(min, max));
+  return std::chrono::ceil<std::chrono::milliseconds>(result);
+}
+
+void ClockOffset::update(std::chrono::nanoseconds send, std::chrono::nanoseconds receive, std::chrono::nanoseconds server) {
+  auto round_trip = receive - send;
+  if (round_trip.count() < 0 || server.count() <= 0) [[unlikely]] {
+    return;
+  }
+  auto sample = server - (send + round_trip / 2);
+  if (samples_++ == 0) {
+    offset_ = sample;
+    jitter_ = round_trip / 2;
+    round_trip_ = round_trip;
+    return;
+  }
+  auto error = sample - offset_;
+  offset_ += error / (1 << OFFSET_SHIFT);
+  jitter_ += (std::chrono::abs(error) - jitter_) / (1 << JITTER_SHIFT);
+  round_trip_ += (round_trip - round_trip_) / (1 << OFFSET_SHIFT);
+}
+
+void ClockOffset::update_lower_bound(std::chrono::nanoseconds receive, std::chrono::nanoseconds server) {
+  if (samples_ == 0 || server.count() <= 0) {
+    return;
+  }
+  auto lower_bound = server - receive;
+  if (offset_ < lower_bound) {
+    jitter_ += (lower_bound - offset_ - jitter_) / (1 << JITTER_SHIFT);
+    offset_ = lower_bound;
+  }
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,59 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// estimates the offset between the exchange clock and our (realtime) clock
+// note! request/response samples assume the server time was captured half-way through the round-trip
+// note! event times can only bound the offset from below (the event must have happened before we received it)
+// note! drift is tracked by continuously smoothing new samples
+
+struct ClockOffset final {
+  explicit ClockOffset(bool enabled);
+
+  ClockOffset(ClockOffset &&) = delete;
+  ClockOffset(ClockOffset const &) = delete;
+
+  // note! server time minus local time (zero until the first sample)
+  std::chrono::nanoseconds get() const { return offset_; }
+
+  // note! smoothed absolute deviation of samples from the estimate
+  std::chrono::nanoseconds jitter() const { return jitter_; }
+
+  std::chrono::nanoseconds round_trip() const { return round_trip_; }
+
+  size_t samples() const { return samples_; }
+
+  // returns the estimated server time (local time if disabled)
+  template <typename T>
+  T adjust(T now) const {
+    if (!enabled_) {
+      return now;
+    }
+    return now + std::chrono::duration_cast<T>(offset_);
+  }
+
+  // returns a window large enough to cover latency and uncertainty (bounded by min and max)
+  std::chrono::milliseconds recv_window(std::chrono::nanoseconds min, std::chrono::nanoseconds max) const;
+
+  void update(std::chrono::nanoseconds send, std::chrono::nanoseconds receive, std::chrono::nanoseconds server);
+
+  void update_lower_bound(std::chrono::nanoseconds receive, std::chrono::nanoseconds server);
+
+ private:
+  bool const enabled_;
+  std::chrono::nanoseconds offset_ = {};
+  std::chrono::nanoseconds jitter_ = {};
+  std::chrono::nanoseconds round_trip_ = {};
+  size_t samples_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -4,6 +4,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 
@@ -12,7 +13,6 @@
 #include "roq/utils/safe_cast.hpp"
 
 #include "roq/utils/codec/base64.hpp"
-#include "roq/utils/codec/hex.hpp"
 
 #include "roq/utils/text/writer.hpp"
 
@@ -31,6 +31,20 @@ auto create_headers(auto &key) {
   return fmt::format("X-MBX-APIKEY: {}\r\n"sv, key);
 }
 
+// note! lower-case hex, avoids the intermediate string
+template <typename OutputIt>
+OutputIt format_signature(OutputIt iter, auto const &digest) {
+  auto const HEX = "0123456789abcdef"sv;
+  auto const SIGNATURE = "&signature="sv;
+  iter = std::copy(std::begin(SIGNATURE), std::end(SIGNATURE), iter);
+  for (auto value : digest) {
+    auto tmp = static_cast<uint8_t>(value);
+    *iter++ = HEX[tmp >> 4];
+    *iter++ = HEX[tmp & 0xf];
+  }
+  return iter;
+}
+
 template <typename R>
 auto create_ed25519(auto &secret, auto margin_mode) {
   using result_type = std::remove_cvref_t<R>;
@@ -64,47 +78,51 @@ Crypto::Crypto(
   }
 }
 
-std::string Crypto::create_rest_signature(std::chrono::milliseconds now_utc) {
+std::string_view Crypto::create_rest_signature(std::vector<char> &buffer, std::chrono::milliseconds now_utc) {
   assert(!std::empty(mac_));
-  auto timestamp = fmt::format("timestamp={}"sv, now_utc.count());
+  buffer.clear();
+  fmt::format_to(std::back_inserter(buffer), "?timestamp={}"sv, now_utc.count());
   mac_.clear();
-  mac_.update(timestamp);
+  mac_.update(std::string_view{std::data(buffer) + 1, std::size(buffer) - 1});
   auto digest = mac_.final(digest_2_);
-  std::string signature;
-  utils::codec::Hex::encode(signature, digest);
-  return fmt::format("?{}&signature={}"sv, timestamp, signature);
+  format_signature(std::back_inserter(buffer), digest);
+  return {std::data(buffer), std::size(buffer)};
 }
 
-std::string Crypto::create_rest_signature_body(std::chrono::milliseconds now_utc, std::string_view const &body) {
+std::string_view Crypto::create_rest_signature_query(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &query) {
   assert(!std::empty(mac_));
-  auto timestamp = fmt::format("timestamp={}"sv, now_utc.count());
+  buffer.clear();
+  fmt::format_to(std::back_inserter(buffer), "?{}&timestamp={}"sv, query, now_utc.count());
   mac_.clear();
-  mac_.update(timestamp);
-  assert(!std::empty(body));
-  mac_.update(body);
+  mac_.update(std::string_view{std::data(buffer) + 1, std::size(buffer) - 1});
   auto digest = mac_.final(digest_2_);
-  std::string signature;
-  utils::codec::Hex::encode(signature, digest);
-  return fmt::format("?{}&signature={}"sv, timestamp, signature);
+  format_signature(std::back_inserter(buffer), digest);
+  return {std::data(buffer), std::size(buffer)};
 }
 
-std::string Crypto::create_rest_signature_query(std::chrono::milliseconds now_utc, std::string_view const &query) {
+std::string_view Crypto::sign_rest_body(std::span<char> buffer, size_t length, std::chrono::milliseconds now_utc) {
   assert(!std::empty(mac_));
-  auto tmp = fmt::format("{}&timestamp={}"sv, query, now_utc.count());
+  assert(length > 0);
+  if (std::size(buffer) < (length + QUERY_BUFFER_LENGTH)) [[unlikely]] {
+    log::fatal("Unexpected: buffer too small (size={}, length={})"sv, std::size(buffer), length);
+  }
+  auto first = std::data(buffer);
+  auto last = fmt::format_to(first + length, "&timestamp={}"sv, now_utc.count());
   mac_.clear();
-  mac_.update(tmp);
+  mac_.update(std::string_view{first, static_cast<size_t>(last - first)});
   auto digest = mac_.final(digest_2_);
-  std::string signature;
-  utils::codec::Hex::encode(signature, digest);
-  return fmt::format("?{}&signature={}"sv, tmp, signature);
+  last = format_signature(last, digest);
+  return {first, static_cast<size_t>(last - first)};
 }
 
 std::string_view Crypto::create_session_logon_signature(std::string &buffer, std::chrono::milliseconds now_utc) {
   assert(!std::empty(pkey_));
-  auto payload = fmt::format("apiKey={}&timestamp={}"sv, key_, now_utc.count());
+  fmt::memory_buffer payload;  // note! inline storage
+  fmt::format_to(std::back_inserter(payload), "apiKey={}&timestamp={}"sv, key_, now_utc.count());
   digest_.clear();
   context_.reset();
-  pkey_.sign(digest_, payload, context_);
+  pkey_.sign(digest_, std::string_view{std::data(payload), std::size(payload)}, context_);
+  buffer.clear();
   utils::codec::Base64::encode(buffer, digest_, false, false);
   return buffer;
 }
@@ -7,6 +7,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "roq/margin_mode.hpp"
 
@@ -31,9 +32,12 @@ struct Crypto final {
 
   std::string_view get_rest_headers() const { return headers_; }
 
-  std::string create_rest_signature(std::chrono::milliseconds now_utc);
-  std::string create_rest_signature_body(std::chrono::milliseconds now_utc, std::string_view const &body);
-  std::string create_rest_signature_query(std::chrono::milliseconds now_utc, std::string_view const &query);
+  // note! the result is a view of the buffer
+  std::string_view create_rest_signature(std::vector<char> &buffer, std::chrono::milliseconds now_utc);
+  std::string_view create_rest_signature_query(std::vector<char> &buffer, std::chrono::milliseconds now_utc, std::string_view const &query);
+
+  // note! appends timestamp and signature to the body already encoded at the front of the buffer
+  std::string_view sign_rest_body(std::span<char> buffer, size_t length, std::chrono::milliseconds now_utc);
 
   std::string_view create_session_logon_signature(std::string &buffer, std::chrono::milliseconds now_utc);
 
@@ -0,0 +1,55 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include "roq/binance_futures/tools/bounded_set.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// identifies a user stream event (the same event is received by each redundant connection)
+
+struct UserStreamEvent final {
+  enum class Type : uint8_t {
+    UNDEFINED,
+    ORDER_TRADE_UPDATE,
+    TRADE_LITE,
+    ACCOUNT_UPDATE,
+    EXECUTION_REPORT,
+    OUTBOUND_ACCOUNT_POSITION,
+    TRADE,  // note! published trades (the same trade is reported by both TRADE_LITE and ORDER_TRADE_UPDATE)
+  };
+
+  struct Hash final {
+    size_t operator()(UserStreamEvent const &value) const {
+      auto result = std::hash<int64_t>{}(value.order_id);
+      result ^= std::hash<int64_t>{}(value.update_time.count()) + 0x9e3779b9 + (result << 6) + (result >> 2);
+      result ^= std::hash<int64_t>{}(value.trade_id) + 0x9e3779b9 + (result << 6) + (result >> 2);
+      result ^= (static_cast<size_t>(value.type) << 8) | value.status;
+      return result;
+    }
+  };
+
+  Type type = {};
+  uint8_t status = {};  // note! e.g. execution type (an order can have several events with the same update time)
+  int64_t order_id = {};
+  std::chrono::milliseconds update_time = {};
+  int64_t trade_id = {};  // note! or a fingerprint of the content (events without identifiers)
+
+  bool operator==(UserStreamEvent const &) const = default;
+};
+
+// recently processed user stream events (shared by redundant connections for the same account)
+// note! only the first copy of each event is processed, later copies (from slower connections) are dropped
+// note! also used to publish each trade once (keyed by TRADE)
+
+using FirstArrival = BoundedSet<UserStreamEvent, UserStreamEvent::Hash>;
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,68 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/governor.hpp"
+
+#include <algorithm>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+Governor::Governor(uint32_t utilization) : utilization_{std::min(utilization, 100u) / 100.0} {
+}
+
+void Governor::sync(std::chrono::nanoseconds period, uint32_t limit, uint32_t count, std::chrono::nanoseconds now) {
+  if (utilization_ == 0.0 || period.count() <= 0 || limit == 0) {
+    return;
+  }
+  auto capacity = limit * utilization_;
+  // note! the exchange count includes orders sent by other sessions using the same account
+  auto tokens = std::clamp(capacity - count, 0.0, capacity);
+  auto iter = std::find_if(std::begin(buckets_), std::end(buckets_), [&](auto &item) { return item.period == period; });
+  if (iter == std::end(buckets_)) {
+    buckets_.emplace_back(Bucket{
+        .period = period,
+        .capacity = capacity,
+        .tokens = tokens,
+        .last = now,
+    });
+    return;
+  }
+  auto &bucket = *iter;
+  refill(bucket, now);
+  bucket.capacity = capacity;
+  // note! never refund tokens consumed by requests the exchange has not yet counted
+  bucket.tokens = std::min(bucket.tokens, tokens);
+}
+
+bool Governor::check(std::chrono::nanoseconds now, uint32_t count) {
+  for (auto &bucket : buckets_) {
+    refill(bucket, now);
+    if (bucket.tokens < count) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Governor::consume(uint32_t count) {
+  for (auto &bucket : buckets_) {
+    bucket.tokens = std::max(bucket.tokens - count, 0.0);
+  }
+}
+
+void Governor::refill(Bucket &bucket, std::chrono::nanoseconds now) const {
+  auto elapsed = now - bucket.last;
+  if (elapsed.count() <= 0) {
+    return;
+  }
+  auto rate = bucket.capacity / static_cast<double>(bucket.period.count());
+  bucket.tokens = std::min(bucket.capacity, bucket.tokens + rate * static_cast<double>(elapsed.count()));
+  bucket.last = now;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
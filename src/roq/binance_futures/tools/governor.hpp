@@ -0,0 +1,61 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// client-side order rate governor (token buckets, one per exchange reported interval)
+// note! buckets are created and re-synchronized from the order counts reported by the exchange
+// note! utilization is the percentage of the exchange limit we allow ourselves to use (zero disables)
+
+struct Governor final {
+  explicit Governor(uint32_t utilization);
+
+  Governor(Governor &&) = delete;
+  Governor(Governor const &) = delete;
+
+  size_t size() const { return std::size(buckets_); }
+
+  // note! limit is the exchange limit for the interval and count is the number of orders already used
+  // note! tokens are only ever lowered (the exchange count does not include requests still in flight)
+  void sync(std::chrono::nanoseconds period, uint32_t limit, uint32_t count, std::chrono::nanoseconds now);
+
+  // returns true if the order can be sent (note! tokens are not consumed)
+  bool check(std::chrono::nanoseconds now, uint32_t count = 1);
+
+  // note! should only be used after check() (the request may otherwise never have been sent)
+  void consume(uint32_t count = 1);
+
+  // returns true if the order can be sent (tokens are then consumed from all buckets)
+  bool operator()(std::chrono::nanoseconds now, uint32_t count = 1) {
+    if (!check(now, count)) {
+      return false;
+    }
+    consume(count);
+    return true;
+  }
+
+ protected:
+  struct Bucket final {
+    std::chrono::nanoseconds period = {};
+    double capacity = {};
+    double tokens = {};
+    std::chrono::nanoseconds last = {};
+  };
+
+  void refill(Bucket &, std::chrono::nanoseconds now) const;
+
+ private:
+  double const utilization_;
+  std::vector<Bucket> buckets_;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
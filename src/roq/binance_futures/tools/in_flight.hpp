@@ -0,0 +1,131 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "roq/logging.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// fixed-capacity table of outstanding requests indexed by (monotonic) sequence number
+// note! all requests share the same timeout and therefore expire in sequence order
+
+template <typename T>
+struct InFlight final {
+  struct Entry final {
+    uint32_t sequence = {};
+    std::chrono::nanoseconds start = {};
+    T value = {};
+    bool active = false;
+  };
+
+  explicit InFlight(size_t capacity) : mask_{validate_capacity(capacity)}, entries_(capacity) {}
+
+  InFlight(InFlight &&) = delete;
+  InFlight(InFlight const &) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // returns false if the slot is occupied by an older outstanding request
+  bool add(uint32_t sequence, std::chrono::nanoseconds now, T const &value) {
+    auto &entry = entries_[sequence & mask_];
+    if (entry.active) [[unlikely]] {
+      return false;
+    }
+    entry = {
+        .sequence = sequence,
+        .start = now,
+        .value = value,
+        .active = true,
+    };
+    if (size_++ == 0) {
+      head_ = sequence;
+    }
+    return true;
+  }
+
+  // note! callback is only invoked if the request is outstanding
+  template <typename Callback>
+  bool remove(uint32_t sequence, Callback callback) {
+    auto &entry = entries_[sequence & mask_];
+    if (!entry.active || entry.sequence != sequence) {
+      return false;
+    }
+    entry.active = false;
+    --size_;
+    callback(entry);
+    return true;
+  }
+
+  // returns the start time of the oldest outstanding request (zero if empty)
+  std::chrono::nanoseconds oldest() {
+    advance();
+    return empty() ? std::chrono::nanoseconds{} : entries_[head_ & mask_].start;
+  }
+
+  // removes all requests started at or before the deadline
+  template <typename Callback>
+  size_t expire(std::chrono::nanoseconds deadline, Callback callback) {
+    size_t result = 0;
+    while (!empty()) {
+      advance();
+      auto &entry = entries_[head_ & mask_];
+      assert(entry.active);
+      if (deadline < entry.start) {
+        break;
+      }
+      entry.active = false;
+      --size_;
+      ++result;
+      callback(entry);
+    }
+    return result;
+  }
+
+  // removes all requests
+  template <typename Callback>
+  void clear(Callback callback) {
+    expire(std::chrono::nanoseconds::max(), callback);
+  }
+
+ protected:
+  static size_t validate_capacity(size_t capacity) {
+    using namespace std::literals;
+    if (capacity == 0 || !std::has_single_bit(capacity)) {
+      log::fatal("Unexpected: capacity must be a power of two"sv);
+    }
+    return capacity - 1;
+  }
+
+  // note! skips completed requests (and unused sequence numbers)
+  void advance() {
+    if (empty()) {
+      return;
+    }
+    for (;;) {
+      auto &entry = entries_[head_ & mask_];
+      if (entry.active && entry.sequence == head_) {
+        return;
+      }
+      ++head_;
+    }
+  }
+
+ private:
+  size_t const mask_;
+  std::vector<Entry> entries_;
+  size_t size_ = {};
+  uint32_t head_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
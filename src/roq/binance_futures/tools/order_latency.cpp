@@ -0,0 +1,63 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/order_latency.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+OrderLatency::OrderLatency(std::chrono::nanoseconds horizon) : horizon_{horizon} {
+}
+
+void OrderLatency::begin(Key const &key, std::chrono::nanoseconds now) {
+  expire(now);
+  entries_[key] = {
+      .start = now,
+      .new_order = false,
+  };
+  queue_.emplace_back(key, now);
+}
+
+std::chrono::nanoseconds OrderLatency::new_order(Key const &key, std::chrono::nanoseconds now) {
+  auto iter = entries_.find(key);
+  if (iter == std::end(entries_)) {
+    return {};
+  }
+  auto &entry = (*iter).second;
+  if (entry.new_order) {
+    return {};
+  }
+  entry.new_order = true;
+  return now - entry.start;
+}
+
+std::chrono::nanoseconds OrderLatency::first_fill(Key const &key, std::chrono::nanoseconds now) {
+  auto iter = entries_.find(key);
+  if (iter == std::end(entries_)) {
+    return {};
+  }
+  auto result = now - (*iter).second.start;
+  entries_.erase(iter);
+  return result;
+}
+
+void OrderLatency::expire(std::chrono::nanoseconds now) {
+  while (!std::empty(queue_)) {
+    auto &[key, start] = queue_.front();
+    if (now < start + horizon_) {
+      break;
+    }
+    // note! the order may have been filled (removed) or been re-used (later start)
+    auto iter = entries_.find(key);
+    if (iter != std::end(entries_) && (*iter).second.start == start) {
+      entries_.erase(iter);
+    }
+    queue_.pop_front();
+  }
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,59 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// wall-clock latency from sending an order request to the user stream reporting the order as new and to the first fill
+// note! orders are forgotten after the horizon (e.g. resting orders never filled)
+
+struct OrderLatency final {
+  struct Key final {
+    uint8_t user_id = {};
+    uint64_t order_id = {};
+
+    bool operator==(Key const &) const = default;
+  };
+
+  explicit OrderLatency(std::chrono::nanoseconds horizon);
+
+  OrderLatency(OrderLatency &&) = delete;
+  OrderLatency(OrderLatency const &) = delete;
+
+  size_t size() const { return std::size(entries_); }
+
+  void begin(Key const &, std::chrono::nanoseconds now);
+
+  // returns the sample (zero if the order is unknown or has already been reported)
+  std::chrono::nanoseconds new_order(Key const &, std::chrono::nanoseconds now);
+  std::chrono::nanoseconds first_fill(Key const &, std::chrono::nanoseconds now);
+
+ protected:
+  struct Hash final {
+    size_t operator()(Key const &key) const { return std::hash<uint64_t>{}(key.order_id) ^ (static_cast<size_t>(key.user_id) << 56); }
+  };
+
+  struct Entry final {
+    std::chrono::nanoseconds start = {};
+    bool new_order = false;
+  };
+
+  void expire(std::chrono::nanoseconds now);
+
+ private:
+  std::chrono::nanoseconds const horizon_;
+  std::unordered_map<Key, Entry, Hash> entries_;
+  std::deque<std::pair<Key, std::chrono::nanoseconds>> queue_;  // note! insertion order
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
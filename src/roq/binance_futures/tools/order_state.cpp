@@ -0,0 +1,123 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/order_state.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === HELPERS ===
+
+namespace {
+// note! NaN means unknown
+bool is_same(double lhs, double rhs) {
+  return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+OrderState::OrderState(size_t max_completed, size_t max_orders) : max_completed_{max_completed}, max_orders_{max_orders} {
+}
+
+bool OrderState::operator()(uint64_t order_id, Update const &update) {
+  auto entry = Entry{
+      .update = update,
+      .route = {},
+      .routed = false,
+  };
+  auto [iter, inserted] = orders_.try_emplace(order_id, entry);
+  if (inserted) {
+    if (!update.completed) {
+      ++working_;
+    }
+    history_.emplace_back(order_id);
+  } else {
+    auto &current = (*iter).second.update;
+    if (is_stale(current, update) || is_equal(current, update)) {
+      return false;
+    }
+    auto completed = current.completed;
+    current = update;
+    current.completed |= completed;  // note! never resurrect
+    if (completed) {
+      return true;
+    }
+    if (update.completed) {
+      --working_;
+    }
+  }
+  if (update.completed) {
+    completed_.emplace_back(order_id);
+    if (std::size(completed_) > max_completed_) {
+      orders_.erase(completed_.front());
+      completed_.pop_front();
+    }
+  }
+  if (inserted) {
+    evict();
+  }
+  return true;
+}
+
+void OrderState::set_route(uint64_t order_id, Route const &route) {
+  auto iter = orders_.find(order_id);
+  if (iter == std::end(orders_)) {
+    return;
+  }
+  auto &entry = (*iter).second;
+  entry.route = route;
+  entry.routed = true;
+}
+
+OrderState::Route const *OrderState::find_route(uint64_t order_id) const {
+  auto iter = orders_.find(order_id);
+  if (iter == std::end(orders_) || !(*iter).second.routed) {
+    return nullptr;
+  }
+  return &(*iter).second.route;
+}
+
+bool OrderState::is_stale(Update const &current, Update const &update) {
+  if (update.update_time.count() && current.update_time.count() && update.update_time < current.update_time) {
+    return true;
+  }
+  if (update.rank < current.rank) {
+    return true;
+  }
+  if (update.traded_quantity < current.traded_quantity) {  // note! false if either is NaN
+    return true;
+  }
+  return false;
+}
+
+void OrderState::evict() {
+  while (std::size(orders_) > max_orders_) {
+    auto order_id = history_.front();
+    history_.pop_front();
+    auto iter = orders_.find(order_id);
+    if (iter == std::end(orders_)) {
+      continue;
+    }
+    if (!(*iter).second.update.completed) {
+      --working_;
+    }
+    orders_.erase(iter);
+  }
+  // note! completed orders and reconciliation also remove orders
+  if (std::size(history_) > 2 * max_orders_) {
+    std::erase_if(history_, [&](auto order_id) { return !orders_.contains(order_id); });
+  }
+}
+
+bool OrderState::is_equal(Update const &current, Update const &update) {
+  return update.update_time == current.update_time && update.rank == current.rank && is_same(update.traded_quantity, current.traded_quantity) &&
+         is_same(update.quantity, current.quantity) && is_same(update.price, current.price);
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
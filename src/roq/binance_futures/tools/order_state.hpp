@@ -0,0 +1,99 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// last known state of each order (keyed by exchange order id)
+// note! used to drop redundant or out-of-order updates before they reach the order management system
+// note! completed orders are remembered (up to a limit) so late updates can still be dropped
+// note! the total number of orders is bounded (the oldest are removed first)
+// note! working orders are counted separately and re-counted when open orders are downloaded (terminal updates could have been missed)
+// note! routing (as found by the order management system) is remembered so fills can be published without the (redundant) order update
+
+struct OrderState final {
+  struct Update final {
+    std::chrono::nanoseconds update_time = {};  // note! zero if unknown
+    uint8_t rank = {};                          // note! status ordering, e.g. working < completed
+    double traded_quantity = {};
+    double quantity = {};
+    double price = {};
+    bool completed = false;
+  };
+
+  struct Route final {
+    uint8_t user_id = {};
+    uint64_t order_id = {};
+    uint32_t strategy_id = {};
+  };
+
+  OrderState(size_t max_completed, size_t max_orders);
+
+  OrderState(OrderState &&) = delete;
+  OrderState(OrderState const &) = delete;
+
+  size_t size() const { return std::size(orders_); }
+
+  size_t working() const { return working_; }
+
+  // returns false if the update is redundant or out of order (otherwise the state is updated)
+  bool operator()(uint64_t order_id, Update const &);
+
+  // note! ignored if the order is not known
+  void set_route(uint64_t order_id, Route const &);
+
+  // returns nullptr if the order or its routing is not known
+  Route const *find_route(uint64_t order_id) const;
+
+  // removes working orders not reported as open by the exchange (returns the number of orders removed)
+  template <typename Callback>
+  size_t reconcile(Callback is_open) {
+    size_t result = 0;
+    working_ = 0;
+    for (auto iter = std::begin(orders_); iter != std::end(orders_);) {
+      auto &[order_id, entry] = *iter;
+      if (entry.update.completed) {
+        ++iter;
+      } else if (is_open(order_id)) {
+        ++working_;
+        ++iter;
+      } else {
+        iter = orders_.erase(iter);
+        ++result;
+      }
+    }
+    return result;
+  }
+
+ protected:
+  static bool is_stale(Update const &current, Update const &update);
+  static bool is_equal(Update const &current, Update const &update);
+
+  void evict();
+
+ private:
+  struct Entry final {
+    Update update;
+    Route route;
+    bool routed = false;
+  };
+
+
+  size_t const max_completed_;
+  size_t const max_orders_;
+  std::unordered_map<uint64_t, Entry> orders_;
+  std::deque<uint64_t> completed_;
+  std::deque<uint64_t> history_;  // note! insertion order, may reference removed orders
+  size_t working_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,50 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/position_keeper.hpp"
+
+#include <algorithm>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+bool PositionKeeper::reconcile(std::string_view const &symbol, MarginMode margin_mode, double quantity, std::chrono::milliseconds update_time, bool hedged) {
+  auto iter = positions_.find(symbol);
+  if (iter == std::end(positions_)) {
+    iter = positions_.emplace(symbol, State{}).first;
+  }
+  auto &state = (*iter).second;
+  if (update_time < state.filled) {
+    return false;
+  }
+  state.margin_mode = margin_mode;
+  state.quantity = quantity;
+  state.reconciled = std::max(state.reconciled, update_time);
+  state.hedged = hedged;
+  return true;
+}
+
+bool PositionKeeper::fill(std::string_view const &symbol, double quantity, std::chrono::milliseconds transaction_time, Position &position) {
+  auto iter = positions_.find(symbol);
+  if (iter == std::end(positions_)) {
+    return false;
+  }
+  auto &state = (*iter).second;
+  if (state.hedged || transaction_time <= state.reconciled) {
+    return false;
+  }
+  state.quantity += quantity;
+  state.filled = std::max(state.filled, transaction_time);
+  position = {
+      .margin_mode = state.margin_mode,
+      .long_quantity = std::max(0.0, state.quantity),
+      .short_quantity = std::max(0.0, -state.quantity),
+  };
+  return true;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
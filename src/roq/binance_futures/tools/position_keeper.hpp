@@ -0,0 +1,60 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "roq/margin_mode.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// net position per symbol updated directly from fills and reconciled with the exchange (ACCOUNT_UPDATE and downloads)
+// note! fills are only applied once a symbol has been reconciled (the margin mode is otherwise unknown)
+// note! fills at or before the last reconciliation are assumed to already be included
+// note! symbols reported with a position side (hedge mode) are never updated from fills
+
+struct PositionKeeper final {
+  struct Position final {
+    MarginMode margin_mode = {};
+    double long_quantity = {};
+    double short_quantity = {};
+  };
+
+  PositionKeeper() = default;
+
+  PositionKeeper(PositionKeeper &&) = default;
+  PositionKeeper(PositionKeeper const &) = delete;
+
+  size_t size() const { return std::size(positions_); }
+
+  // returns false if older than the last fill
+  bool reconcile(std::string_view const &symbol, MarginMode, double quantity, std::chrono::milliseconds update_time, bool hedged = false);
+
+  // note! quantity is signed (negative when selling)
+  // returns false if the fill was not applied
+  bool fill(std::string_view const &symbol, double quantity, std::chrono::milliseconds transaction_time, Position &);
+
+  void clear() { positions_.clear(); }
+
+ protected:
+  struct State final {
+    MarginMode margin_mode = {};
+    double quantity = {};
+    std::chrono::milliseconds reconciled = {};
+    std::chrono::milliseconds filled = {};
+    bool hedged = false;
+  };
+
+ private:
+  std::map<std::string, State, std::less<>> positions_;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,97 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/pre_trade.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === HELPERS ===
+
+namespace {
+// note! comparisons against NaN are false, i.e. unknown limits (or prices) never reject
+bool is_above(double value, double limit) {
+  return limit > 0.0 && value > limit;
+}
+
+bool is_below(double value, double limit) {
+  return limit > 0.0 && value < limit;
+}
+
+// note! zero and NaN mean "no limit"
+double tighter(double lhs, double rhs, bool upper) {
+  auto valid = [](auto value) { return std::isfinite(value) && value > 0.0; };
+  if (!valid(lhs)) {
+    return rhs;
+  }
+  if (!valid(rhs)) {
+    return lhs;
+  }
+  return upper ? std::min(lhs, rhs) : std::max(lhs, rhs);
+}
+
+bool is_valid(double price) {
+  return std::isfinite(price) && price > 0.0;
+}
+
+uint32_t tighter(uint32_t lhs, uint32_t rhs) {
+  if (lhs == 0 || rhs == 0) {
+    return std::max(lhs, rhs);
+  }
+  return std::min(lhs, rhs);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+PreTrade::PreTrade(Limits const &config) : config_{config}, limits_{config} {
+}
+
+void PreTrade::set_limits(Limits const &limits) {
+  limits_ = {
+      .max_quantity = limits.max_quantity,
+      .max_market_quantity = limits.max_market_quantity,
+      .min_notional = limits.min_notional,
+      .max_notional = tighter(limits.max_notional, config_.max_notional, true),
+      .multiplier_up = tighter(limits.multiplier_up, config_.multiplier_up, true),
+      .multiplier_down = tighter(limits.multiplier_down, config_.multiplier_down, false),
+      .max_open_orders = tighter(limits.max_open_orders, config_.max_open_orders),
+  };
+}
+
+PreTrade::Result PreTrade::check(Order const &order, size_t open_orders) const {
+  if (is_above(order.quantity, order.market ? limits_.max_market_quantity : limits_.max_quantity)) {
+    return Result::MAX_QUANTITY;
+  }
+  if (limits_.max_open_orders > 0 && open_orders >= limits_.max_open_orders) {
+    return Result::MAX_OPEN_ORDERS;
+  }
+  // note! market orders are assumed to execute at the opposite side of the book
+  auto price = order.market ? (order.buy ? ask_price_ : bid_price_) : order.price;
+  // note! notional checks can not be skipped just because the top of book is missing
+  auto notional_checks = (!order.reduce_only && limits_.min_notional > 0.0) || limits_.max_notional > 0.0;
+  if (order.market && notional_checks && !is_valid(price)) {
+    return Result::NO_REFERENCE_PRICE;
+  }
+  auto notional = order.quantity * price;
+  if (!order.reduce_only && is_below(notional, limits_.min_notional)) {
+    return Result::MIN_NOTIONAL;
+  }
+  if (is_above(notional, limits_.max_notional)) {
+    return Result::MAX_NOTIONAL;
+  }
+  if (!order.market) {
+    auto mid_price = 0.5 * (bid_price_ + ask_price_);
+    if (order.buy ? is_above(price, mid_price * limits_.multiplier_up) : is_below(price, mid_price * limits_.multiplier_down)) {
+      return Result::PRICE_BAND;
+    }
+  }
+  return Result::OK;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
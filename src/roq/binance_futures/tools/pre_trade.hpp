@@ -0,0 +1,87 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "roq/numbers.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// pre-trade risk checks for a single instrument
+// note! limits are from the exchange filters (LOT_SIZE, MARKET_LOT_SIZE, MIN_NOTIONAL, PERCENT_PRICE, MAX_NUM_ORDERS), optionally tightened by config
+// note! NaN (or zero) disables a check
+// note! each check is a handful of comparisons (no allocation, no lookup)
+
+struct PreTrade final {
+  enum class Result : uint8_t {
+    OK,
+    MAX_QUANTITY,
+    MIN_NOTIONAL,
+    MAX_NOTIONAL,
+    PRICE_BAND,
+    MAX_OPEN_ORDERS,
+    NO_REFERENCE_PRICE,
+  };
+
+  struct Limits final {
+    double max_quantity = NaN;         // LOT_SIZE
+    double max_market_quantity = NaN;  // MARKET_LOT_SIZE
+    double min_notional = NaN;         // MIN_NOTIONAL
+    double max_notional = NaN;
+    double multiplier_up = NaN;  // PERCENT_PRICE
+    double multiplier_down = NaN;
+    uint32_t max_open_orders = {};  // MAX_NUM_ORDERS
+  };
+
+  struct Order final {
+    bool buy = false;
+    bool market = false;
+    bool reduce_only = false;  // note! exempt from MIN_NOTIONAL
+    double quantity = NaN;
+    double price = NaN;  // note! ignored for market orders
+  };
+
+  // note! config limits (max_notional, multipliers, max_open_orders) always apply, the tighter limit wins
+  explicit PreTrade(Limits const &config);
+
+  PreTrade(PreTrade &&) = delete;
+  PreTrade(PreTrade const &) = delete;
+
+  Limits const &get_limits() const { return limits_; }
+
+  // note! called with exchange filters, e.g. when reference data is (re-)downloaded
+  void set_limits(Limits const &);
+
+  // note! reference prices are from the top of book (book ticker or depth), older updates are ignored
+  void update(double bid_price, double ask_price, uint64_t update_id) {
+    if (update_id < update_id_) {
+      return;
+    }
+    update_id_ = update_id;
+    bid_price_ = bid_price;
+    ask_price_ = ask_price;
+  }
+
+  // note! e.g. when market data has been disconnected
+  void clear() {
+    bid_price_ = NaN;
+    ask_price_ = NaN;
+  }
+
+  Result check(Order const &, size_t open_orders) const;
+
+ private:
+  Limits const config_;
+  Limits limits_;
+  double bid_price_ = NaN;
+  double ask_price_ = NaN;
+  uint64_t update_id_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/quote_legs.hpp"
+
+#include <algorithm>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+size_t QuoteLegs::size() const {
+  size_t result = {};
+  for (auto &[_, legs] : symbols_) {
+    result += std::size(legs);
+  }
+  return result;
+}
+
+void QuoteLegs::add(std::string_view const &symbol, std::string_view const &client_order_id, uint8_t user_id) {
+  auto iter = symbols_.find(symbol);
+  if (iter == std::end(symbols_)) {
+    iter = symbols_.emplace(symbol, std::vector<Leg>{}).first;
+  }
+  (*iter).second.emplace_back(Leg{
+      .client_order_id = std::string{client_order_id},
+      .user_id = user_id,
+      .cancel_time = {},
+  });
+}
+
+QuoteLegs::Leg const *QuoteLegs::find(std::string_view const &symbol, std::string_view const &client_order_id) const {
+  auto iter = symbols_.find(symbol);
+  if (iter == std::end(symbols_)) {
+    return nullptr;
+  }
+  auto &legs = (*iter).second;
+  auto iter_2 = std::ranges::find_if(legs, [&](auto &leg) { return leg.client_order_id == client_order_id; });
+  if (iter_2 == std::end(legs)) {
+    return nullptr;
+  }
+  return &(*iter_2);
+}
+
+// note! the symbol is kept (avoids re-allocating when the next quote arrives)
+bool QuoteLegs::remove(std::string_view const &symbol, std::string_view const &client_order_id) {
+  auto iter = symbols_.find(symbol);
+  if (iter == std::end(symbols_)) {
+    return false;
+  }
+  auto &legs = (*iter).second;
+  auto iter_2 = std::ranges::find_if(legs, [&](auto &leg) { return leg.client_order_id == client_order_id; });
+  if (iter_2 == std::end(legs)) {
+    return false;
+  }
+  legs.erase(iter_2);
+  return true;
+}
+
+bool QuoteLegs::cancelling(std::string_view const &symbol) const {
+  auto iter = symbols_.find(symbol);
+  if (iter == std::end(symbols_)) {
+    return false;
+  }
+  return std::ranges::any_of((*iter).second, [](auto &leg) { return leg.cancel_time.count() != 0; });
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
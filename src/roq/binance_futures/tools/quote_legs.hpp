@@ -0,0 +1,89 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// quote legs (created by mass-quote) per symbol
+// note! legs are not known to the order management system, updates are resolved here (by client order id)
+// note! a leg is only removed when the exchange has reported it as done, e.g. a cancel must be acknowledged
+
+struct QuoteLegs final {
+  struct Leg final {
+    std::string client_order_id;
+    uint8_t user_id = {};
+    std::chrono::nanoseconds cancel_time = {};  // note! zero if a cancel has not been sent
+  };
+
+  QuoteLegs() = default;
+
+  QuoteLegs(QuoteLegs &&) = default;
+  QuoteLegs(QuoteLegs const &) = delete;
+
+  size_t size() const;
+
+  void add(std::string_view const &symbol, std::string_view const &client_order_id, uint8_t user_id);
+
+  // returns nullptr if not a quote leg
+  Leg const *find(std::string_view const &symbol, std::string_view const &client_order_id) const;
+
+  // returns false if not a quote leg
+  bool remove(std::string_view const &symbol, std::string_view const &client_order_id);
+
+  // returns true if a cancel has been sent for any leg (and not yet acknowledged)
+  bool cancelling(std::string_view const &symbol) const;
+
+  // note! includes legs where the previous cancel has not been acknowledged within timeout
+  template <typename Callback>
+  void cancel(std::string_view const &symbol, std::chrono::nanoseconds now, std::chrono::nanoseconds timeout, Callback callback) {
+    dispatch(symbol, now, callback, [&](auto &leg) { return leg.cancel_time.count() == 0 || now >= (leg.cancel_time + timeout); });
+  }
+
+  // note! only legs where the previous cancel has not been acknowledged within timeout
+  template <typename Callback>
+  void retry(std::string_view const &symbol, std::chrono::nanoseconds now, std::chrono::nanoseconds timeout, Callback callback) {
+    dispatch(symbol, now, callback, [&](auto &leg) { return leg.cancel_time.count() != 0 && now >= (leg.cancel_time + timeout); });
+  }
+
+  template <typename Callback>
+  void get_symbols(Callback callback) const {
+    for (auto &[symbol, legs] : symbols_) {
+      if (!std::empty(legs)) {
+        callback(symbol);
+      }
+    }
+  }
+
+ protected:
+  template <typename Callback, typename Filter>
+  void dispatch(std::string_view const &symbol, std::chrono::nanoseconds now, Callback &callback, Filter filter) {
+    auto iter = symbols_.find(symbol);
+    if (iter == std::end(symbols_)) {
+      return;
+    }
+    for (auto &leg : (*iter).second) {
+      if (filter(leg)) {
+        leg.cancel_time = now;
+        auto const &client_order_id = leg.client_order_id;
+        callback(client_order_id);
+      }
+    }
+  }
+
+ private:
+  std::map<std::string, std::vector<Leg>, std::less<>> symbols_;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,50 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/race.hpp"
+
+#include <algorithm>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+Race::Race(std::chrono::nanoseconds timeout) : timeout_{timeout} {
+}
+
+void Race::begin(Key const &key, uint32_t legs, std::chrono::nanoseconds now) {
+  // note! drop requests where some leg never responded (e.g. disconnect)
+  std::erase_if(entries_, [&](auto &item) { return item.expires <= now || item.key == key; });
+  if (legs < 2) {
+    return;
+  }
+  auto entry = Entry{
+      .key = key,
+      .remaining = legs,
+      .resolved = false,
+      .expires = now + timeout_,
+  };
+  entries_.emplace_back(entry);
+}
+
+bool Race::operator()(Key const &key, bool accepted) {
+  auto iter = std::find_if(std::begin(entries_), std::end(entries_), [&](auto &item) { return item.key == key; });
+  if (iter == std::end(entries_)) {
+    return true;
+  }
+  auto &entry = *iter;
+  auto result = false;
+  if (!entry.resolved && (accepted || entry.remaining == 1)) {
+    entry.resolved = true;
+    result = true;
+  }
+  if (--entry.remaining == 0) {
+    entries_.erase(iter);
+  }
+  return result;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
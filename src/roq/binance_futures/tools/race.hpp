@@ -0,0 +1,54 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// tracks the same request sent over several paths ("legs")
+// note! the first accepted response wins, a rejection is only forwarded once all legs have rejected
+// note! few requests are in flight at any time and linear search is therefore used
+
+struct Race final {
+  struct Key final {
+    uint8_t user_id = {};
+    uint64_t order_id = {};
+    uint32_t version = {};
+
+    bool operator==(Key const &) const = default;
+  };
+
+  explicit Race(std::chrono::nanoseconds timeout);
+
+  Race(Race &&) = delete;
+  Race(Race const &) = delete;
+
+  size_t size() const { return std::size(entries_); }
+
+  void begin(Key const &, uint32_t legs, std::chrono::nanoseconds now);
+
+  // returns true if the response should be forwarded
+  // note! responses for unknown requests are always forwarded
+  bool operator()(Key const &, bool accepted);
+
+ protected:
+  struct Entry final {
+    Key key;
+    uint32_t remaining = {};
+    bool resolved = false;
+    std::chrono::nanoseconds expires = {};
+  };
+
+ private:
+  std::chrono::nanoseconds const timeout_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,90 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <utility>
+
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// fifo of requests, each delayed from when it was queued and paced by a (shared) rate-limiter
+// note! the attached timer is scheduled for when the first request is due (there is no polling)
+// note! requests blocked by the rate-limiter are retried after a fixed delay
+
+template <typename T>
+struct RequestQueue final {
+  RequestQueue(std::chrono::nanoseconds delay, std::chrono::nanoseconds retry) : delay_{delay}, retry_{retry} {}
+
+  RequestQueue(RequestQueue &&) = delete;
+  RequestQueue(RequestQueue const &) = delete;
+
+  bool empty() const { return std::empty(queue_); }
+  size_t size() const { return std::size(queue_); }
+
+  // note! nullptr detaches
+  void attach(TimerWheel::Timer *timer) {
+    timer_ = timer;
+    if (!empty()) {
+      schedule(queue_.front().due);
+    }
+  }
+
+  void emplace_back(T const &value, std::chrono::nanoseconds now) {
+    queue_.emplace_back(Item{
+        .due = now + delay_,
+        .value = value,
+    });
+    if (std::size(queue_) == 1) {
+      schedule(queue_.front().due);
+    }
+  }
+
+  void clear() { queue_.clear(); }
+
+  // returns zero if empty
+  std::chrono::nanoseconds next() const { return empty() ? std::chrono::nanoseconds{} : queue_.front().due; }
+
+  // note! the callback may queue new requests
+  template <typename CanRequest, typename Callback>
+  void dispatch(CanRequest can_request, Callback callback, std::chrono::nanoseconds now) {
+    while (!empty() && queue_.front().due <= now) {
+      if (!can_request(now)) {
+        schedule(now + retry_);
+        return;
+      }
+      auto value = std::move(queue_.front().value);
+      queue_.pop_front();
+      callback(value);
+    }
+    if (!empty()) {
+      schedule(queue_.front().due);
+    }
+  }
+
+ protected:
+  struct Item final {
+    std::chrono::nanoseconds due = {};
+    T value = {};
+  };
+
+  void schedule(std::chrono::nanoseconds deadline) {
+    if (timer_) {
+      (*timer_).schedule(deadline);
+    }
+  }
+
+ private:
+  std::chrono::nanoseconds const delay_;
+  std::chrono::nanoseconds const retry_;
+  std::deque<Item> queue_;
+  TimerWheel::Timer *timer_ = nullptr;
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,28 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/round_trip.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === CONSTANTS ===
+
+namespace {
+// note! same weight as the smoothed round-trip time used by tcp (rfc 6298)
+auto const SHIFT = 3;
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+void RoundTrip::update(std::chrono::nanoseconds sample) {
+  if (samples_++ == 0) {
+    value_ = sample;
+  } else {
+    value_ += (sample - value_) / (1 << SHIFT);
+  }
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
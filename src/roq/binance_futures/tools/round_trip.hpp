@@ -0,0 +1,35 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// smoothed round-trip latency
+// note! samples are measured by the caller (e.g. using the in-flight request table)
+
+struct RoundTrip final {
+  RoundTrip() = default;
+
+  RoundTrip(RoundTrip &&) = delete;
+  RoundTrip(RoundTrip const &) = delete;
+
+  // note! zero until the first sample
+  std::chrono::nanoseconds get() const { return value_; }
+
+  size_t samples() const { return samples_; }
+
+  void update(std::chrono::nanoseconds sample);
+
+ private:
+  std::chrono::nanoseconds value_ = {};
+  size_t samples_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
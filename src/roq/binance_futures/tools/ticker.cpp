@@ -0,0 +1,93 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/ticker.hpp"
+
+#include <cassert>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+// subscription
+
+Ticker::Subscription::Subscription(Ticker &ticker, TimerWheel::Handler &handler, uint32_t type) : ticker_{ticker}, id_{ticker_.create(handler, type)} {
+}
+
+Ticker::Subscription::~Subscription() {
+  ticker_.release(id_);
+}
+
+// ticker
+
+Ticker::Ticker(TimerWheel &timer_wheel, std::chrono::nanoseconds interval) : interval_{interval}, timer_{timer_wheel, *this, 0} {
+}
+
+uint32_t Ticker::create(TimerWheel::Handler &handler, uint32_t type) {
+  uint32_t id = {};
+  if (std::empty(free_)) {
+    id = static_cast<uint32_t>(std::size(entries_));
+    entries_.emplace_back();
+  } else {
+    id = free_.back();
+    free_.pop_back();
+  }
+  entries_[id] = {
+      .handler = &handler,
+      .type = type,
+      .active = false,
+  };
+  return id;
+}
+
+void Ticker::release(uint32_t id) {
+  stop(id);
+  entries_[id].handler = nullptr;
+  free_.emplace_back(id);
+}
+
+bool Ticker::active(uint32_t id) const {
+  assert(id < std::size(entries_));
+  return entries_[id].active;
+}
+
+void Ticker::start(uint32_t id, std::chrono::nanoseconds now) {
+  auto &entry = entries_[id];
+  if (entry.active) {
+    return;
+  }
+  entry.active = true;
+  if (++active_ == 1) {
+    timer_.schedule(now + interval_);
+  }
+}
+
+void Ticker::stop(uint32_t id) {
+  auto &entry = entries_[id];
+  if (!entry.active) {
+    return;
+  }
+  entry.active = false;
+  if (--active_ == 0) {
+    timer_.cancel();
+  }
+}
+
+// note! handlers may start or stop (themselves or others) while being dispatched
+void Ticker::operator()(TimerWheel::Timeout const &timeout) {
+  timer_.schedule(timeout.now + interval_);
+  for (size_t i = 0; i < std::size(entries_); ++i) {
+    auto entry = entries_[i];  // note! copy (the vector may grow)
+    if (entry.active) {
+      (*entry.handler)(TimerWheel::Timeout{.type = entry.type, .now = timeout.now});
+    }
+  }
+  if (active_ == 0) {
+    timer_.cancel();
+  }
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,73 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// periodic tick shared by many handlers
+// note! only one timer is registered with the timer wheel (and only while at least one handler is active)
+
+struct Ticker final : public TimerWheel::Handler {
+  // raii registration
+  struct Subscription final {
+    Subscription(Ticker &, TimerWheel::Handler &, uint32_t type);
+
+    Subscription(Subscription &&) = delete;
+    Subscription(Subscription const &) = delete;
+
+    ~Subscription();
+
+    bool active() const { return ticker_.active(id_); }
+
+    void start(std::chrono::nanoseconds now) { ticker_.start(id_, now); }
+    void stop() { ticker_.stop(id_); }
+
+   private:
+    Ticker &ticker_;
+    uint32_t const id_;
+  };
+
+  Ticker(TimerWheel &, std::chrono::nanoseconds interval);
+
+  Ticker(Ticker &&) = delete;
+  Ticker(Ticker const &) = delete;
+
+  size_t size() const { return active_; }
+
+  uint32_t create(TimerWheel::Handler &, uint32_t type);
+  void release(uint32_t id);
+
+  bool active(uint32_t id) const;
+
+  // note! the first tick is at most one interval away
+  void start(uint32_t id, std::chrono::nanoseconds now);
+  void stop(uint32_t id);
+
+ protected:
+  void operator()(TimerWheel::Timeout const &) override;
+
+  struct Entry final {
+    TimerWheel::Handler *handler = nullptr;
+    uint32_t type = {};
+    bool active = false;
+  };
+
+ private:
+  std::chrono::nanoseconds const interval_;
+  TimerWheel::Timer timer_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> free_;
+  size_t active_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,245 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "roq/logging.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === CONSTANTS ===
+
+namespace {
+auto const MASK = TimerWheel::SLOTS - 1;
+
+// note! larger gaps (typically only the first refresh) are handled by re-inserting all pending timers
+auto const MAX_CATCH_UP = TimerWheel::SLOTS * TimerWheel::SLOTS;
+}  // namespace
+
+// === HELPERS ===
+
+namespace {
+constexpr uint64_t span(size_t level) {
+  return uint64_t{1} << ((level + 1) * TimerWheel::LEVEL_BITS);
+}
+
+constexpr uint32_t to_slot(size_t level, uint64_t expires) {
+  return static_cast<uint32_t>(level * TimerWheel::SLOTS + ((expires >> (level * TimerWheel::LEVEL_BITS)) & MASK));
+}
+
+auto validate_resolution(auto resolution) {
+  if (resolution.count() <= 0) {
+    log::fatal("Unexpected: resolution must be positive"sv);
+  }
+  return resolution.count();
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// timer
+
+TimerWheel::Timer::Timer(TimerWheel &timer_wheel, Handler &handler, uint32_t type) : timer_wheel_{timer_wheel}, id_{timer_wheel_.create(handler, type)} {
+}
+
+TimerWheel::Timer::~Timer() {
+  timer_wheel_.release(id_);
+}
+
+// timer-wheel
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds resolution) : resolution_{validate_resolution(resolution)} {
+  heads_.fill(NIL);
+}
+
+uint32_t TimerWheel::create(Handler &handler, uint32_t type) {
+  uint32_t id = {};
+  if (std::empty(free_)) {
+    id = static_cast<uint32_t>(std::size(entries_));
+    entries_.emplace_back();
+  } else {
+    id = free_.back();
+    free_.pop_back();
+  }
+  entries_[id] = {
+      .handler = &handler,
+      .type = type,
+  };
+  return id;
+}
+
+void TimerWheel::release(uint32_t id) {
+  cancel(id);
+  entries_[id].handler = nullptr;
+  free_.emplace_back(id);
+}
+
+bool TimerWheel::pending(uint32_t id) const {
+  return entries_[id].slot != NIL;
+}
+
+void TimerWheel::schedule(uint32_t id, std::chrono::nanoseconds deadline) {
+  auto &entry = entries_[id];
+  assert(entry.handler);
+  if (entry.slot != NIL) {
+    unlink(id);
+  } else {
+    ++size_;
+  }
+  entry.expires = to_ticks(deadline);
+  if (!initialized_) [[unlikely]] {
+    current_ = entry.expires;
+    initialized_ = true;
+  }
+  insert(id);
+}
+
+void TimerWheel::cancel(uint32_t id) {
+  if (entries_[id].slot == NIL) {
+    return;
+  }
+  unlink(id);
+  --size_;
+}
+
+size_t TimerWheel::refresh(std::chrono::nanoseconds now) {
+  auto target = static_cast<uint64_t>(std::max<int64_t>(now.count(), 0) / resolution_);
+  if (size_ == 0 || !initialized_) {
+    current_ = target + 1;
+    initialized_ = true;
+    return 0;
+  }
+  if (current_ <= target && (target - current_) >= MAX_CATCH_UP) [[unlikely]] {
+    rebuild(target);
+  }
+  size_t result = 0;
+  while (current_ <= target) {
+    if (size_ == 0) {
+      current_ = target + 1;
+      break;
+    }
+    auto index = current_ & MASK;
+    if (index == 0) {
+      for (size_t level = 1; level < LEVELS; ++level) {
+        cascade(level);
+        if (((current_ >> (level * LEVEL_BITS)) & MASK) != 0) {
+          break;
+        }
+      }
+    }
+    // note! move to a pseudo slot so handlers are free to (re-)schedule and cancel
+    auto slot = to_slot(0, current_);
+    while (heads_[slot] != NIL) {
+      auto id = heads_[slot];
+      unlink(id);
+      link(id, EXPIRED);
+    }
+    ++current_;
+    while (heads_[EXPIRED] != NIL) {
+      auto id = heads_[EXPIRED];
+      unlink(id);
+      --size_;
+      auto &entry = entries_[id];
+      auto timeout = Timeout{
+          .type = entry.type,
+          .now = now,
+      };
+      (*entry.handler)(timeout);
+      ++result;
+    }
+  }
+  return result;
+}
+
+uint64_t TimerWheel::to_ticks(std::chrono::nanoseconds deadline) const {
+  auto value = deadline.count();
+  if (value <= 0) {
+    return 0;
+  }
+  // note! round up so we never fire early
+  return static_cast<uint64_t>((value + resolution_ - 1) / resolution_);
+}
+
+void TimerWheel::insert(uint32_t id) {
+  auto expires = entries_[id].expires;
+  if (expires <= current_) {
+    link(id, to_slot(0, current_));
+    return;
+  }
+  auto delta = expires - current_;
+  for (size_t level = 0; level < LEVELS; ++level) {
+    if (delta < span(level)) {
+      link(id, to_slot(level, expires));
+      return;
+    }
+  }
+  // note! beyond the horizon: park in the outermost level and re-insert when cascaded
+  link(id, to_slot(LEVELS - 1, current_ + span(LEVELS - 1) - 1));
+}
+
+void TimerWheel::link(uint32_t id, uint32_t slot) {
+  auto &entry = entries_[id];
+  assert(entry.slot == NIL);
+  entry.slot = slot;
+  entry.prev = NIL;
+  entry.next = heads_[slot];
+  if (entry.next != NIL) {
+    entries_[entry.next].prev = id;
+  }
+  heads_[slot] = id;
+}
+
+void TimerWheel::unlink(uint32_t id) {
+  auto &entry = entries_[id];
+  assert(entry.slot != NIL);
+  if (entry.prev != NIL) {
+    entries_[entry.prev].next = entry.next;
+  } else {
+    heads_[entry.slot] = entry.next;
+  }
+  if (entry.next != NIL) {
+    entries_[entry.next].prev = entry.prev;
+  }
+  entry.slot = NIL;
+  entry.prev = NIL;
+  entry.next = NIL;
+}
+
+void TimerWheel::cascade(size_t level) {
+  auto slot = to_slot(level, current_);
+  auto id = heads_[slot];
+  heads_[slot] = NIL;
+  while (id != NIL) {
+    auto &entry = entries_[id];
+    auto next = entry.next;
+    entry.slot = NIL;
+    entry.prev = NIL;
+    entry.next = NIL;
+    insert(id);
+    id = next;
+  }
+}
+
+void TimerWheel::rebuild(uint64_t current) {
+  std::vector<uint32_t> pending;
+  for (uint32_t id = 0; id < std::size(entries_); ++id) {
+    if (entries_[id].slot != NIL) {
+      unlink(id);
+      pending.emplace_back(id);
+    }
+  }
+  current_ = current;
+  for (auto id : pending) {
+    insert(id);
+  }
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,106 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// hierarchical timer wheel
+// note! components register the deadlines they need and refresh only visits timers which are due
+
+struct TimerWheel final {
+  struct Timeout final {
+    uint32_t type = {};
+    std::chrono::nanoseconds now = {};
+  };
+
+  struct Handler {
+    virtual ~Handler() = default;
+
+    virtual void operator()(Timeout const &) = 0;
+  };
+
+  // raii registration
+  struct Timer final {
+    Timer(TimerWheel &, Handler &, uint32_t type);
+
+    Timer(Timer &&) = delete;
+    Timer(Timer const &) = delete;
+
+    ~Timer();
+
+    bool pending() const { return timer_wheel_.pending(id_); }
+
+    void schedule(std::chrono::nanoseconds deadline) { timer_wheel_.schedule(id_, deadline); }
+    void cancel() { timer_wheel_.cancel(id_); }
+
+   private:
+    TimerWheel &timer_wheel_;
+    uint32_t const id_;
+  };
+
+  explicit TimerWheel(std::chrono::nanoseconds resolution);
+
+  TimerWheel(TimerWheel &&) = delete;
+  TimerWheel(TimerWheel const &) = delete;
+
+  size_t size() const { return size_; }
+
+  uint32_t create(Handler &, uint32_t type);
+  void release(uint32_t id);
+
+  bool pending(uint32_t id) const;
+
+  // note! deadlines already expired will fire on the next refresh
+  void schedule(uint32_t id, std::chrono::nanoseconds deadline);
+  void cancel(uint32_t id);
+
+  // returns number of timers fired
+  size_t refresh(std::chrono::nanoseconds now);
+
+  static constexpr size_t const LEVEL_BITS = 6;
+  static constexpr size_t const SLOTS = size_t{1} << LEVEL_BITS;
+  static constexpr size_t const LEVELS = 4;
+
+ protected:
+  static constexpr uint32_t const NIL = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t const EXPIRED = LEVELS * SLOTS;  // note! pseudo slot used while firing
+
+  struct Entry final {
+    Handler *handler = nullptr;
+    uint32_t type = {};
+    uint64_t expires = {};
+    uint32_t slot = NIL;
+    uint32_t prev = NIL;
+    uint32_t next = NIL;
+  };
+
+  uint64_t to_ticks(std::chrono::nanoseconds) const;
+
+  void insert(uint32_t id);
+  void link(uint32_t id, uint32_t slot);
+  void unlink(uint32_t id);
+
+  void cascade(size_t level);
+  void rebuild(uint64_t current);
+
+ private:
+  int64_t const resolution_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> free_;
+  std::array<uint32_t, LEVELS * SLOTS + 1> heads_;
+  uint64_t current_ = {};  // note! next tick to process
+  bool initialized_ = false;
+  size_t size_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
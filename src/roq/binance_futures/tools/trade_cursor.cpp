@@ -0,0 +1,90 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include "roq/binance_futures/tools/trade_cursor.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "roq/logging.hpp"
+
+using namespace std::literals;
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// === IMPLEMENTATION ===
+
+void TradeCursor::load(std::string_view const &path) {
+  path_ = path;
+  trade_ids_.clear();
+  dirty_ = false;
+  if (std::empty(path_)) {
+    return;
+  }
+  std::ifstream file{path_};
+  if (!file) {
+    log::info(R"(Trade cursor not found (path="{}"))"sv, path_);
+    return;
+  }
+  std::string symbol;
+  int64_t trade_id = {};
+  while (file >> symbol >> trade_id) {
+    update(symbol, trade_id);
+  }
+  dirty_ = false;
+  log::info(R"(Trade cursor has been loaded (path="{}", size={}))"sv, path_, std::size(trade_ids_));
+}
+
+// note! writes a temporary file which is then renamed (the previous state is kept if we crash while writing)
+bool TradeCursor::save() {
+  if (std::empty(path_) || !dirty_) {
+    return true;
+  }
+  auto tmp = path_ + ".tmp";
+  {
+    std::ofstream file{tmp, std::ios::trunc};
+    for (auto &[symbol, trade_id] : trade_ids_) {
+      file << symbol << ' ' << trade_id << '\n';
+    }
+    file.flush();
+    if (!file) {
+      log::warn(R"(Failed to write trade cursor (path="{}"))"sv, tmp);
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, path_, ec);
+  if (ec) {
+    log::warn(R"(Failed to rename trade cursor (path="{}", error="{}"))"sv, path_, ec.message());
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+int64_t TradeCursor::get(std::string_view const &symbol) const {
+  auto iter = trade_ids_.find(symbol);
+  if (iter == std::end(trade_ids_)) {
+    return 0;
+  }
+  return (*iter).second;
+}
+
+bool TradeCursor::update(std::string_view const &symbol, int64_t trade_id) {
+  auto iter = trade_ids_.find(symbol);
+  if (iter == std::end(trade_ids_)) {
+    trade_ids_.emplace(symbol, trade_id);
+  } else if ((*iter).second < trade_id) {
+    (*iter).second = trade_id;
+  } else {
+    return false;
+  }
+  dirty_ = true;
+  return true;
+}
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,65 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// last seen trade id per symbol (used to only download trades we have missed)
+// note! optionally persisted to a small text file (one "symbol trade_id" pair per line) so restarts can resume from the cursor
+
+struct TradeCursor final {
+  TradeCursor() = default;
+
+  TradeCursor(TradeCursor &&) = default;
+  TradeCursor(TradeCursor const &) = delete;
+
+  // note! persistence is disabled if path is empty
+  void load(std::string_view const &path);
+
+  // returns false if the file could not be written
+  // note! only writes if something has changed
+  bool save();
+
+  size_t size() const { return std::size(trade_ids_); }
+
+  // returns zero if unknown
+  int64_t get(std::string_view const &symbol) const;
+
+  // returns false if the trade id does not advance the cursor
+  bool update(std::string_view const &symbol, int64_t trade_id);
+
+  // note! live updates must not advance a stale cursor (trades may have been missed, e.g. while disconnected)
+  bool stale() const { return stale_; }
+
+  void set_stale(std::chrono::nanoseconds now) {
+    stale_ = true;
+    stale_time_ = now;
+  }
+
+  // note! only a download started after the cursor became stale can clear it
+  void downloaded(std::chrono::nanoseconds start) {
+    if (start >= stale_time_) {
+      stale_ = false;
+    }
+  }
+
+ private:
+  std::string path_;
+  std::map<std::string, int64_t, std::less<>> trade_ids_;
+  bool dirty_ = false;
+  bool stale_ = true;  // note! until the first download has completed
+  std::chrono::nanoseconds stale_time_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
@@ -0,0 +1,60 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <string_view>
+
+namespace roq {
+namespace binance_futures {
+namespace tools {
+
+// trades download state (owned by the downloader, never shared)
+// note! walks the symbols one page at a time (a symbol is only completed when a page is not full)
+
+struct TradeDownload final {
+  TradeDownload() = default;
+
+  TradeDownload(TradeDownload &&) = delete;
+  TradeDownload(TradeDownload const &) = delete;
+
+  template <typename T>
+  void begin(T const &symbols, std::chrono::nanoseconds now) {
+    pending_.clear();
+    for (auto &symbol : symbols) {
+      pending_.emplace_back(symbol);
+    }
+    start_ = now;
+  }
+
+  bool downloading() const { return !std::empty(pending_); }
+
+  // note! when the download was started (used to decide if it covers a disconnect)
+  std::chrono::nanoseconds start() const { return start_; }
+
+  std::string_view current() const {
+    assert(downloading());
+    return pending_.front();
+  }
+
+  // note! stays with the current symbol if more pages are required
+  void next(bool more) {
+    assert(downloading());
+    if (!more) {
+      pending_.pop_front();
+    }
+  }
+
+  void reset() { pending_.clear(); }
+
+ private:
+  std::deque<std::string> pending_;
+  std::chrono::nanoseconds start_ = {};
+};
+
+}  // namespace tools
+}  // namespace binance_futures
+}  // namespace roq
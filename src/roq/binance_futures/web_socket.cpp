@@ -11,6 +11,8 @@
 #include "roq/utils/safe_cast.hpp"
 #include "roq/utils/update.hpp"
 
+#include "roq/utils/charconv/to_string.hpp"
+
 #include "roq/utils/exceptions/unhandled.hpp"
 
 #include "roq/utils/metrics/factory.hpp"
@@ -45,6 +47,12 @@ auto const SUPPORTS = Mask{
 uint32_t const REQUEST_ID = 1'000'000;
 
 size_t const MAX_DECODE_BUFFER_DEPTH = 1;
+
+uint32_t const TIMER_REFRESH = 1;
+uint32_t const TIMER_LISTEN_KEY = 2;
+uint32_t const TIMER_TIMEOUT = 3;
+
+size_t const MAX_IN_FLIGHT = 1024;  // note! must be a power of two
 }  // namespace
 
 // === HELPERS ===
@@ -111,6 +119,7 @@ WebSocket::WebSocket(
       decode_buffer_{shared.settings.misc.decode_buffer_size, MAX_DECODE_BUFFER_DEPTH},
       counter_{
           .disconnect = create_metrics(shared.settings, name_, "disconnect"sv),
+          .timeout = create_metrics(shared.settings, name_, "timeout"sv),
       },
       profile_{
           .parse = create_metrics(shared.settings, name_, "parse"sv),
@@ -121,6 +130,9 @@ WebSocket::WebSocket(
           .user_data_stream_start_ack = create_metrics(shared.settings, name_, "user_data_stream_start_ack"sv),
           .user_data_stream_ping = create_metrics(shared.settings, name_, "user_data_stream_ping"sv),
           .user_data_stream_ping_ack = create_metrics(shared.settings, name_, "user_data_stream_ping_ack"sv),
+          .user_data_stream_subscribe = create_metrics(shared.settings, name_, "user_data_stream_subscribe"sv),
+          .user_data_stream_subscribe_ack = create_metrics(shared.settings, name_, "user_data_stream_subscribe_ack"sv),
+          .user_data_event = create_metrics(shared.settings, name_, "user_data_event"sv),
           .account_balance = create_metrics(shared.settings, name_, "account_balance"sv),
           .account_balance_ack = create_metrics(shared.settings, name_, "account_balance_ack"sv),
           .account_status = create_metrics(shared.settings, name_, "account_status"sv),
@@ -141,6 +153,9 @@ WebSocket::WebSocket(
       latency_{
           .ping = create_metrics(shared.settings, name_, "ping"sv),
           .heartbeat = create_metrics(shared.settings, name_, "heartbeat"sv),
+          .order_place_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_place"sv),
+          .order_modify_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_modify"sv),
+          .order_cancel_round_trip = create_metrics(shared.settings, name_, "order_round_trip"sv, "order_cancel"sv),
       },
       rate_limiter_{
           .request_weight_1m = create_metrics(shared.settings, name_, "request_weight"sv, "1m"sv),
@@ -148,22 +163,82 @@ WebSocket::WebSocket(
           .create_order_1d = create_metrics(shared.settings, name_, "create_order"sv, "1d"sv),
       },
       account_{account}, shared_{shared}, request_{request}, request_id_{REQUEST_ID * stream_id},
-      download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }} {
+      download_{shared.settings.rest.request_timeout, [this](auto state) { return download(state); }}, in_flight_{MAX_IN_FLIGHT},
+      timer_{
+          .refresh = {shared.refresh_ticker, *this, TIMER_REFRESH},
+          .listen_key = {shared.timer_wheel, *this, TIMER_LISTEN_KEY},
+          .timeout = {shared.timer_wheel, *this, TIMER_TIMEOUT},
+      } {
   log::info<5>(R"(stream_id={}, account="{}", master={})"sv, stream_id_, account_.name, master_);
 }
 
+void WebSocket::set_master(bool master) {
+  if (!utils::update(master_, master)) {
+    return;
+  }
+  log::info(R"(stream_id={}, account="{}", master={})"sv, stream_id_, account_.name, master_);
+  if (!master_) {
+    timer_.listen_key.cancel();
+    return;
+  }
+  if (!ready()) {
+    return;
+  }
+  if (shared_.ws_api_user_stream) {
+    // note! all sessions are subscribed, only the master forwards events
+    if (user_stream_) {
+      TraceInfo trace_info;
+      auto user_stream_update = UserStreamUpdate{
+          .account = account_.name,
+          .ready = true,
+      };
+      create_trace_and_dispatch(handler_, trace_info, user_stream_update);
+    } else {
+      user_data_stream_subscribe();
+    }
+    return;
+  }
+  // note! the listen key should have been pre-acquired while logging on
+  if (std::empty(listen_key_)) {
+    user_data_stream_start();
+  } else {
+    timer_.listen_key.schedule(listen_key_refresh_);
+  }
+}
+
 void WebSocket::operator()(Event<Start> const &) {
   (*connection_).start();
+  timer_.refresh.start(clock::get_system());
 }
 
 void WebSocket::operator()(Event<Stop> const &) {
+  timer_.refresh.stop();
+  timer_.listen_key.cancel();
+  timer_.timeout.cancel();
   (*connection_).stop();
 }
 
-void WebSocket::operator()(Event<Timer> const &event) {
-  auto now = event.value.now;
+// tools::TimerWheel::Handler
+
+void WebSocket::operator()(tools::TimerWheel::Timeout const &timeout) {
+  auto now = timeout.now;
+  switch (timeout.type) {
+    case TIMER_REFRESH:
+      refresh(now);
+      break;
+    case TIMER_LISTEN_KEY:
+      user_data_stream_ping(now);
+      break;
+    case TIMER_TIMEOUT:
+      check_timeouts(now);
+      break;
+    default:
+      assert(false);
+  }
+}
+
+void WebSocket::refresh(std::chrono::nanoseconds now) {
   (*connection_).refresh(now);
-  user_data_stream_ping(now);
   if (master_ && ready() && !downloading()) {
     if (!downloading() && request_.respond_balance < request_.request_balance) {
       log::info("Download balance..."sv);
@@ -175,15 +250,6 @@ void WebSocket::operator()(Event<Timer> const &event) {
       account_status();
       download_account_ = true;
     }
-    /* XXX FIXME this is wrong -- we can only download a single order
-    if (!downloading() && request_.respond_orders < request_.request_orders) {
-      log::info("Download orders..."sv);
-      if (order_status()) {
-        download_orders_ = true;
-      } else {
-      }
-    }
-    */
   }
 }
 
@@ -191,6 +257,7 @@ void WebSocket::operator()(metrics::Writer &writer) const {
   writer
       // counter
       .write(counter_.disconnect, metrics::Type::COUNTER)
+      .write(counter_.timeout, metrics::Type::COUNTER)
       // profile
       .write(profile_.parse, metrics::Type::PROFILE)
       .write(profile_.error, metrics::Type::PROFILE)
@@ -200,6 +267,9 @@ void WebSocket::operator()(metrics::Writer &writer) const {
       .write(profile_.user_data_stream_start_ack, metrics::Type::PROFILE)
       .write(profile_.user_data_stream_ping, metrics::Type::PROFILE)
       .write(profile_.user_data_stream_ping_ack, metrics::Type::PROFILE)
+      .write(profile_.user_data_stream_subscribe, metrics::Type::PROFILE)
+      .write(profile_.user_data_stream_subscribe_ack, metrics::Type::PROFILE)
+      .write(profile_.user_data_event, metrics::Type::PROFILE)
       .write(profile_.account_balance, metrics::Type::PROFILE)
       .write(profile_.account_balance_ack, metrics::Type::PROFILE)
       .write(profile_.account_status, metrics::Type::PROFILE)
@@ -219,6 +289,9 @@ void WebSocket::operator()(metrics::Writer &writer) const {
       // latency
       .write(latency_.ping, metrics::Type::LATENCY)
       .write(latency_.heartbeat, metrics::Type::LATENCY)
+      .write(latency_.order_place_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_modify_round_trip, metrics::Type::LATENCY)
+      .write(latency_.order_cancel_round_trip, metrics::Type::LATENCY)
       // rate limiter
       .write(rate_limiter_.request_weight_1m, metrics::Type::RATE_LIMITER)
       .write(rate_limiter_.create_order_10s, metrics::Type::RATE_LIMITER)
@@ -249,11 +322,20 @@ uint16_t WebSocket::operator()(Event<CancelAllOrders> const &event, std::string_
   // return stream_id_;
 }
 
+// note! the ws-api does not support batch orders
+uint16_t WebSocket::operator()(Event<MassQuote> const &) {
+  throw server::oms::NotSupported{"not supported"sv};
+}
+
+uint16_t WebSocket::operator()(Event<CancelQuotes> const &) {
+  throw server::oms::NotSupported{"not supported"sv};
+}
+
 // session-logon
 
 void WebSocket::session_logon() {
   profile_.session_logon([&]() {
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::SESSION_LOGON,
@@ -266,6 +348,7 @@ void WebSocket::session_logon() {
     auto signature = account_.create_session_logon_signature(now_utc);
     auto message = json::Encoder::session_logon_json(encode_buffer_, account_.get_key(), now_utc, signature, request_id);
     (*connection_).send_text(message);
+    session_logon_start_ = clock::get_realtime<std::chrono::nanoseconds>();
     (*this)(ConnectionStatus::LOGIN_SENT);
   });
 }
@@ -291,7 +374,7 @@ void WebSocket::user_data_stream_start() {
 
 void WebSocket::user_data_stream_ping(std::chrono::nanoseconds now) {
   profile_.user_data_stream_ping([&]() {
-    if (!ready()) {
+    if (!ready() || !master_) {
       return;
     }
     if (std::empty(listen_key_)) {
@@ -302,6 +385,7 @@ void WebSocket::user_data_stream_ping(std::chrono::nanoseconds now) {
     }
     log::info<1>("Refreshing listen key..."sv);
     listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+    timer_.listen_key.schedule(listen_key_refresh_);
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::USER_DATA_STREAM_PING,
@@ -317,11 +401,30 @@ void WebSocket::user_data_stream_ping(std::chrono::nanoseconds now) {
   });
 }
 
+// user-data-stream-subscribe
+
+void WebSocket::user_data_stream_subscribe() {
+  profile_.user_data_stream_subscribe([&]() {
+    auto request = json::WSAPIRequest{
+        .sequence = ++request_id_,
+        .type = json::WSAPIType::USER_DATA_STREAM_SUBSCRIBE,
+        .user_id = {},
+        .order_id = {},
+        .version = {},
+        .order_id_2 = {},
+    };
+    auto request_id = json::WSAPIRequest::encode(request_encode_buffer_, request);
+    auto message = json::Encoder::user_data_stream_subscribe_json(encode_buffer_, request_id);
+    log::info<5>(R"(message="{}")"sv, message);
+    (*connection_).send_text(message);
+  });
+}
+
 // account-balance
 
 void WebSocket::account_balance() {
   profile_.account_balance([&]() {
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ACCOUNT_BALANCE,
@@ -341,7 +444,7 @@ void WebSocket::account_balance() {
 
 void WebSocket::account_status() {
   profile_.account_status([&]() {
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ACCOUNT_STATUS,
@@ -361,7 +464,7 @@ void WebSocket::account_status() {
 
 void WebSocket::account_position() {
   profile_.account_position([&]() {
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ACCOUNT_POSITION,
@@ -378,30 +481,23 @@ void WebSocket::account_position() {
 }
 
 // order-status
-// XXX FIXME following is wrong -- we can only request a single order
-
-bool WebSocket::order_status() {
-  auto &symbols = shared_.settings.download.symbols;
-  for (auto &item : symbols) {
-    order_status(item);
-  }
-  return !std::empty(symbols);
-}
 
-void WebSocket::order_status(std::string_view const &symbol) {
+// note! only a single order can be queried => used to re-sync an order after a request timeout
+void WebSocket::order_status(InFlightRequest const &in_flight_request) {
   profile_.order_status([&]() {
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
-    auto request = json::WSAPIRequest{
+    auto &[request, symbol, client_order_id] = in_flight_request;
+    auto now_utc = account_.now_utc();
+    auto request_2 = json::WSAPIRequest{
         .sequence = ++request_id_,
-        .type = json::WSAPIType::ORDERS_STATUS,
-        .user_id = {},
-        .order_id = {},
-        .version = {},
+        .type = json::WSAPIType::ORDER_STATUS,
+        .user_id = request.user_id,
+        .order_id = request.order_id,
+        .version = request.version,
         .order_id_2 = {},
     };
-    auto request_id = json::WSAPIRequest::encode(request_encode_buffer_, request);
-    auto message = json::Encoder::order_status_json(encode_buffer_, symbol, now_utc, request_id);
-    log::warn(R"(DEBUG {})"sv, message);
+    auto request_id = json::WSAPIRequest::encode(request_encode_buffer_, request_2);
+    auto message = json::Encoder::order_status_json(encode_buffer_, symbol, client_order_id, now_utc, request_id);
+    log::info<5>(R"(message="{}")"sv, message);
     (*connection_).send_text(message);
   });
 }
@@ -445,7 +541,7 @@ void WebSocket::open_orders_cancel_all(Event<CancelAllOrders> const &event, std:
       if (!std::empty(cancel_all_orders.symbol) && symbol != cancel_all_orders.symbol) {
         continue;
       }
-      auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+      auto now_utc = account_.now_utc();
       auto request = json::WSAPIRequest{
           .sequence = ++request_id_,
           .type = json::WSAPIType::OPEN_ORDERS_CANCEL_ALL,
@@ -455,18 +551,7 @@ void WebSocket::open_orders_cancel_all(Event<CancelAllOrders> const &event, std:
           .order_id_2 = {},
       };
       auto request_id_2 = json::WSAPIRequest::encode(request_encode_buffer_, request);  // XXX FIXME here we lose request_id
-      auto message = fmt::format(
-          R"({{)"
-          R"("id":"{}",)"
-          R"("method":"openOrders.cancelAll",)"
-          R"("params":{{)"
-          R"("symbol":"{}",)"
-          R"("timestamp":"{}")"
-          R"(}})"
-          R"(}})"sv,
-          request_id_2,
-          symbol,
-          now_utc.count());
+      auto message = json::Encoder::open_orders_cancel_all_json(encode_buffer_, symbol, now_utc, request_id_2);
       (*connection_).send_text(message);
       send_ack(symbol);
     }
@@ -482,8 +567,8 @@ void WebSocket::order_place(Event<CreateOrder> const &event, server::oms::Order
     }
     auto &[message_info, create_order] = event;
     open_orders_symbols_.emplace(create_order.symbol);
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto recv_window = shared_.get_order_recv_window();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ORDER_PLACE,
@@ -493,10 +578,13 @@ void WebSocket::order_place(Event<CreateOrder> const &event, server::oms::Order
         .order_id_2 = {},
     };
     auto request_id_2 = json::WSAPIRequest::encode(request_encode_buffer_, request);
-    auto message = json::Encoder::order_place_json(encode_buffer_, create_order, order, request_id, recv_window, now_utc, request_id_2);
+    auto message =
+        json::Encoder::order_place_json(encode_buffer_, shared_.order_templates, create_order, order, request_id, recv_window, now_utc, request_id_2);
     log::info<5>(R"(message="{}")"sv, message);
     log::warn(R"(DEBUG {})"sv, message);
+    add_in_flight(request, create_order.symbol, request_id);
     (*connection_).send_text(message);
+    shared_.order_latency.begin({.user_id = request.user_id, .order_id = request.order_id}, clock::get_system());
   });
 }
 
@@ -509,8 +597,8 @@ void WebSocket::order_modify(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, modify_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto recv_window = shared_.get_order_recv_window();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ORDER_MODIFY,
@@ -523,6 +611,7 @@ void WebSocket::order_modify(
     auto message = json::Encoder::order_modify_json(encode_buffer_, modify_order, order, request_id, previous_request_id, recv_window, now_utc, request_id_2);
     log::info<5>(R"(message="{}")"sv, message);
     log::warn(R"(DEBUG {})"sv, message);
+    add_in_flight(request, order.symbol, order.client_order_id);
     (*connection_).send_text(message);
   });
 }
@@ -536,8 +625,8 @@ void WebSocket::order_cancel(
       throw server::oms::NotReady{"not ready"sv};
     }
     auto &[message_info, cancel_order] = event;
-    auto recv_window = std::chrono::duration_cast<std::chrono::milliseconds>(shared_.settings.rest.order_recv_window);
-    auto now_utc = clock::get_realtime<std::chrono::milliseconds>();
+    auto recv_window = shared_.get_order_recv_window();
+    auto now_utc = account_.now_utc();
     auto request = json::WSAPIRequest{
         .sequence = ++request_id_,
         .type = json::WSAPIType::ORDER_CANCEL,
@@ -550,6 +639,7 @@ void WebSocket::order_cancel(
     auto message = json::Encoder::order_cancel_json(encode_buffer_, cancel_order, order, request_id, previous_request_id, recv_window, now_utc, request_id_2);
     log::info<5>(R"(message="{}")"sv, message);
     log::warn(R"(DEBUG {})"sv, message);
+    add_in_flight(request, order.symbol, order.client_order_id);
     (*connection_).send_text(message);
   });
 }
@@ -562,6 +652,21 @@ void WebSocket::operator()(web::socket::Client::Disconnected const &) {
   ready_ = false;
   (*this)(ConnectionStatus::DISCONNECTED);
   download_.reset();
+  // note! the subscription does not survive the session
+  if (utils::update(user_stream_, false) && master_) {
+    TraceInfo trace_info;
+    auto user_stream_update = UserStreamUpdate{
+        .account = account_.name,
+        .ready = false,
+    };
+    create_trace_and_dispatch(handler_, trace_info, user_stream_update);
+  }
+  // note! responses will never arrive
+  timer_.timeout.cancel();
+  if (!std::empty(in_flight_)) {
+    in_flight_.clear([&](auto &entry) { fail_in_flight(entry.value.request, RequestStatus::DISCONNECTED); });
+    request_.request_orders = clock::get_system();
+  }
   // XXX FIXME also reset the download_* latches?
 }
 
@@ -582,6 +687,7 @@ void WebSocket::operator()(web::socket::Client::Latency const &latency) {
   };
   create_trace_and_dispatch(handler_, trace_info, external_latency);
   latency_.ping.update(latency.sample);
+  round_trip_.update(latency.sample);
 }
 
 void WebSocket::operator()(web::socket::Client::Text const &text) {
@@ -624,7 +730,12 @@ uint32_t WebSocket::download(WebSocketState state) {
       session_logon();
       return 1;
     case USER_DATA_STREAM_START:
-      user_data_stream_start();
+      // note! all sessions acquire the (same) listen key so any session can be promoted without delay
+      if (shared_.ws_api_user_stream) {
+        user_data_stream_subscribe();
+      } else {
+        user_data_stream_start();
+      }
       return 1;
     case ACCOUNT_POSITION:
       account_position();  // just testing -- not used
@@ -671,7 +782,10 @@ void WebSocket::operator()(Trace<json::WSAPISessionLogon> const &event) {
         download_.retry(STATE);
       }
     };
-    auto handle_success = [&]([[maybe_unused]] auto &result) { download_.check_relaxed(STATE); };
+    auto handle_success = [&](auto &result) {
+      shared_.clock_offset.update(session_logon_start_, clock::get_realtime<std::chrono::nanoseconds>(), result.server_time);
+      download_.check_relaxed(STATE);
+    };
     if (session_logon.status == 200) {
       handle_success(session_logon.result);
     } else {
@@ -703,6 +817,9 @@ void WebSocket::operator()(Trace<json::WSAPIListenKey> const &event) {
       download_.check_relaxed(STATE);
       auto now = clock::get_system();
       listen_key_refresh_ = now + shared_.settings.rest.listen_key_refresh;
+      if (master_) {
+        timer_.listen_key.schedule(listen_key_refresh_);
+      }
     };
     if (listen_key.status == 200) {
       handle_success(listen_key.result);
@@ -713,6 +830,55 @@ void WebSocket::operator()(Trace<json::WSAPIListenKey> const &event) {
   });
 }
 
+void WebSocket::operator()(Trace<json::WSAPISubscribe> const &event) {
+  auto const STATE = WebSocketState::USER_DATA_STREAM_START;
+  profile_.user_data_stream_subscribe_ack([&]() {
+    auto &[trace_info, subscribe] = event;
+    log::info<2>("subscribe={}"sv, subscribe);
+    auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
+      log::warn(R"(account="{}", origin={}, error={}, status={}, text="{}")"sv, account_.name, origin, error, status, text);
+      if (download_.downloading()) {
+        download_.retry(STATE);
+      }
+    };
+    auto handle_success = [&](auto &result) {
+      log::info<1>(R"(User data stream has been subscribed (subscription_id={}))"sv, result.subscription_id);
+      user_stream_ = true;
+      if (master_) {
+        auto user_stream_update = UserStreamUpdate{
+            .account = account_.name,
+            .ready = true,
+        };
+        create_trace_and_dispatch(handler_, trace_info, user_stream_update);
+      }
+      if (download_.downloading()) {
+        download_.check_relaxed(STATE);
+      }
+    };
+    if (subscribe.status == 200) {
+      handle_success(subscribe.result);
+    } else {
+      handle_error(Origin::EXCHANGE, RequestStatus::REJECTED, json::guess_error(subscribe.error.code), subscribe.error.msg);
+    }
+    update_rate_limits(event);
+  });
+}
+
+void WebSocket::operator()(Trace<json::WSAPIParser::UserDataEvent> const &event) {
+  profile_.user_data_event([&]() {
+    auto &[trace_info, user_data_event] = event;
+    // note! standby sessions are subscribed (for fast promotion) but events are only forwarded by the master
+    if (!master_ || !user_stream_) {
+      return;
+    }
+    auto user_stream_event = UserStreamEvent{
+        .account = account_.name,
+        .message = user_data_event.message,
+    };
+    create_trace_and_dispatch(handler_, trace_info, user_stream_event);
+  });
+}
+
 void WebSocket::operator()(Trace<json::WSAPIAccountBalance> const &event) {
   profile_.account_balance_ack([&]() {
     auto &[trace_info, account_balance] = event;
@@ -735,6 +901,7 @@ void WebSocket::operator()(Trace<json::WSAPIAccountBalance> const &event) {
             .exchange_time_utc = item.update_time,
             .sending_time_utc = item.update_time,
         };
+        request_.account_cache.balance(funds_update.margin_mode, funds_update.currency, funds_update.balance, funds_update.hold);
         create_trace_and_dispatch(handler_, trace_info, funds_update, true);
       }
     };
@@ -779,6 +946,14 @@ void WebSocket::operator()(Trace<json::WSAPIAccountStatus> const &event) {
             .exchange_time_utc = result.update_time,
             .sending_time_utc = {},
         };
+        auto hedged = !std::empty(item.position_side) && item.position_side != "BOTH"sv;
+        // note! older than the last fill (the position published from fills is more recent)
+        if (!request_.position_keeper.reconcile(item.symbol, margin_mode, item.position_amt, item.update_time, hedged) &&
+            shared_.settings.ws.position_from_fills) {
+          log::info<3>(R"(Drop position update (older than the last fill): symbol="{}")"sv, item.symbol);
+          continue;
+        }
+        request_.account_cache.position(position_update.margin_mode, position_update.symbol, position_update.long_quantity, position_update.short_quantity);
         create_trace_and_dispatch(handler_, trace_info, position_update, true);
       }
     };
@@ -839,7 +1014,8 @@ void WebSocket::operator()(Trace<json::WSAPIOpenOrdersCancelAll> const &event, j
         if (std::empty(item.client_order_id)) {
           continue;
         }
-        auto external_order_id = fmt::format("{}"sv, item.order_id);  // alloc
+        ExternalOrderId external_order_id;
+        utils::charconv::to_string(std::back_inserter(external_order_id), item.order_id);
         auto order_update = server::oms::OrderUpdate{
             .account = account_.name,
             .exchange = shared_.settings.exchange,
@@ -890,8 +1066,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderPlace> const &event, json::WSAP
   profile_.order_place_ack([&]() {
     auto &[trace_info, order_place] = event;
     log::info<2>("order_place={}, request={}"sv, order_place, request);
+    auto in_flight = update_round_trip(request);
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
       log::warn(R"(account="{}", origin={}, error={}, status={}, text="{}")"sv, account_.name, origin, error, status, text);
+      if (!in_flight) {
+        return;  // note! late response => the request has already failed (timeout)
+      }
       auto response = server::oms::Response{
           .request_type = RequestType::CREATE_ORDER,
           .origin = Origin::EXCHANGE,
@@ -907,7 +1087,8 @@ void WebSocket::operator()(Trace<json::WSAPIOrderPlace> const &event, json::WSAP
       (*this)(event_2, request.user_id, request.order_id);
     };
     auto handle_success = [&]([[maybe_unused]] auto &result) {
-      auto external_order_id = fmt::format("{}"sv, result.order_id);  // alloc
+      ExternalOrderId external_order_id;
+      utils::charconv::to_string(std::back_inserter(external_order_id), result.order_id);
       auto order_status = map(result.status).template get<OrderStatus>();
       // LIMIT_MAKER orders do not return any order state + we only end up here if we receive HTTP status OK
       if (order_status == OrderStatus{}) {
@@ -976,6 +1157,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderPlace> const &event, json::WSAP
           .update_type = UpdateType::INCREMENTAL,
           .sending_time_utc = {},
       };
+      if (!in_flight) {
+        // note! late response => the request has already failed (timeout)
+        Trace event_2{trace_info, order_update};
+        (*this)(event_2, result.client_order_id);
+        return;
+      }
       Trace event_2{trace_info, response};
       (*this)(event_2, request.user_id, request.order_id, order_update);
     };
@@ -992,8 +1179,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderModify> const &event, json::WSA
   profile_.order_modify_ack([&]() {
     auto &[trace_info, order_modify] = event;
     log::info<2>("order_modify={}, request={}"sv, order_modify, request);
+    auto in_flight = update_round_trip(request);
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
       log::warn(R"(account="{}", origin={}, error={}, status={}, text="{}")"sv, account_.name, origin, error, status, text);
+      if (!in_flight) {
+        return;  // note! late response => the request has already failed (timeout)
+      }
       auto response = server::oms::Response{
           .request_type = RequestType::MODIFY_ORDER,
           .origin = Origin::EXCHANGE,
@@ -1009,7 +1200,8 @@ void WebSocket::operator()(Trace<json::WSAPIOrderModify> const &event, json::WSA
       (*this)(event_2, request.user_id, request.order_id);
     };
     auto handle_success = [&](auto &result) {
-      auto external_order_id = fmt::format("{}"sv, result.order_id);  // alloc
+      ExternalOrderId external_order_id;
+      utils::charconv::to_string(std::back_inserter(external_order_id), result.order_id);
       auto response = server::oms::Response{
           .request_type = RequestType::MODIFY_ORDER,
           .origin = Origin::EXCHANGE,
@@ -1055,6 +1247,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderModify> const &event, json::WSA
           .update_type = UpdateType::INCREMENTAL,
           .sending_time_utc = {},
       };
+      if (!in_flight) {
+        // note! late response => the request has already failed (timeout)
+        Trace event_2{trace_info, order_update};
+        (*this)(event_2, result.client_order_id);
+        return;
+      }
       Trace event_2{trace_info, response};
       (*this)(event_2, request.user_id, request.order_id, order_update);
     };
@@ -1071,8 +1269,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderCancel> const &event, json::WSA
   profile_.order_cancel_ack([&]() {
     auto &[trace_info, order_cancel] = event;
     log::info<2>("order_cancel={}, request={}"sv, order_cancel, request);
+    auto in_flight = update_round_trip(request);
     auto handle_error = [&](auto origin, auto status, auto error, auto const &text) {
       log::warn(R"(account="{}", origin={}, error={}, status={}, text="{}")"sv, account_.name, origin, error, status, text);
+      if (!in_flight) {
+        return;  // note! late response => the request has already failed (timeout)
+      }
       auto response = server::oms::Response{
           .request_type = RequestType::CANCEL_ORDER,
           .origin = Origin::EXCHANGE,
@@ -1088,7 +1290,8 @@ void WebSocket::operator()(Trace<json::WSAPIOrderCancel> const &event, json::WSA
       (*this)(event_2, request.user_id, request.order_id);
     };
     auto handle_success = [&](auto &result) {
-      auto external_order_id = fmt::format("{}"sv, result.order_id);  // alloc
+      ExternalOrderId external_order_id;
+      utils::charconv::to_string(std::back_inserter(external_order_id), result.order_id);
       auto response = server::oms::Response{
           .request_type = RequestType::CANCEL_ORDER,
           .origin = Origin::EXCHANGE,
@@ -1134,6 +1337,12 @@ void WebSocket::operator()(Trace<json::WSAPIOrderCancel> const &event, json::WSA
           .update_type = UpdateType::INCREMENTAL,
           .sending_time_utc = {},
       };
+      if (!in_flight) {
+        // note! late response => the request has already failed (timeout)
+        Trace event_2{trace_info, order_update};
+        (*this)(event_2, result.client_order_id);
+        return;
+      }
       Trace event_2{trace_info, response};
       (*this)(event_2, request.user_id, request.order_id, order_update);
     };
@@ -1148,6 +1357,63 @@ void WebSocket::operator()(Trace<json::WSAPIOrderCancel> const &event, json::WSA
 
 // helpers
 
+void WebSocket::operator()(Trace<json::WSAPIOrderStatus> const &event, json::WSAPIRequest const &request) {
+  profile_.order_status_ack([&]() {
+    auto &[trace_info, order_status] = event;
+    log::info<2>("order_status={}, request={}"sv, order_status, request);
+    auto handle_error = [&](auto error, auto const &text) {
+      // note! the request may never have reached the exchange
+      log::warn(R"(Unable to re-sync order: account="{}", request={}, error={}, text="{}")"sv, account_.name, request, error, text);
+    };
+    auto handle_success = [&](auto &result) {
+      ExternalOrderId external_order_id;
+      utils::charconv::to_string(std::back_inserter(external_order_id), result.order_id);
+      auto order_update = server::oms::OrderUpdate{
+          .account = account_.name,
+          .exchange = shared_.settings.exchange,
+          .symbol = result.symbol,
+          .side = map(result.side),
+          .position_effect = {},
+          .margin_mode = {},
+          .max_show_quantity = NaN,
+          .order_type = map(result.type),
+          .time_in_force = map(result.time_in_force),
+          .execution_instructions = {},
+          .create_time_utc = result.time,
+          .update_time_utc = result.update_time,
+          .external_account = {},
+          .external_order_id = external_order_id,
+          .client_order_id = {},
+          .order_status = map(result.status),
+          .quantity = result.orig_qty,
+          .price = result.price,
+          .stop_price = result.stop_price,
+          .leverage = NaN,
+          .remaining_quantity = result.orig_qty - result.executed_qty,
+          .traded_quantity = result.executed_qty,
+          .average_traded_price = NaN,
+          .last_traded_quantity = NaN,
+          .last_traded_price = NaN,
+          .last_liquidity = {},
+          .routing_id = {},
+          .max_request_version = {},
+          .max_response_version = {},
+          .max_accepted_version = {},
+          .update_type = UpdateType::INCREMENTAL,
+          .sending_time_utc = {},
+      };
+      Trace event_2{trace_info, order_update};
+      (*this)(event_2, result.client_order_id);
+    };
+    if (order_status.status == 200) {
+      handle_success(order_status.result);
+    } else {
+      handle_error(json::guess_error(order_status.error.code), order_status.error.msg);
+    }
+    update_rate_limits(event);
+  });
+}
+
 void WebSocket::update_rate_limits(auto &event) {
   auto &[trace_info, message] = event;
   shared_.rate_limits.clear();
@@ -1203,9 +1469,13 @@ void WebSocket::update_rate_limits(auto &event) {
       case REQUEST_WEIGHT:
         if (period == 1min) {
           rate_limiter_.request_weight_1m.set(item.count);
+          shared_.download_governor.sync(period, item.limit, item.count, clock::get_system());
         }
         break;
     }
+    if (type == RateLimitType::CREATE_ORDER) {
+      account_.governor.sync(period, item.limit, item.count, clock::get_system());
+    }
     auto rate_limit = RateLimit{
         .type = type,
         .period = period,
@@ -1228,17 +1498,135 @@ void WebSocket::update_rate_limits(auto &event) {
   shared_.rate_limits.clear();
 }
 
+void WebSocket::add_in_flight(json::WSAPIRequest const &request, std::string_view const &symbol, std::string_view const &client_order_id) {
+  auto now = clock::get_system();
+  auto in_flight_request = InFlightRequest{
+      .request = request,
+      .symbol = symbol,
+      .client_order_id = client_order_id,
+  };
+  // note! the response to an untracked request would be dropped as late
+  if (!in_flight_.add(request.sequence, now, in_flight_request)) [[unlikely]] {
+    throw server::oms::Rejected{Origin::GATEWAY, Error::REQUEST_RATE_LIMIT_REACHED, "Too many requests in flight"sv};
+  }
+  if (!timer_.timeout.pending()) {
+    timer_.timeout.schedule(now + shared_.settings.ws_api_2.request_timeout);
+  }
+}
+
+// note! returns false if the request is no longer in flight (timeout or disconnect)
+bool WebSocket::update_round_trip(json::WSAPIRequest const &request) {
+  return in_flight_.remove(request.sequence, [&](auto &entry) {
+    auto sample = clock::get_system() - entry.start;
+    switch (request.type) {
+      using enum json::WSAPIType::type_t;
+      case ORDER_PLACE:
+        latency_.order_place_round_trip.update(sample);
+        break;
+      case ORDER_MODIFY:
+        latency_.order_modify_round_trip.update(sample);
+        break;
+      case ORDER_CANCEL:
+        latency_.order_cancel_round_trip.update(sample);
+        break;
+      default:
+        break;
+    }
+    round_trip_.update(sample);
+  });
+}
+
+void WebSocket::check_timeouts(std::chrono::nanoseconds now) {
+  auto request_timeout = shared_.settings.ws_api_2.request_timeout;
+  auto count = in_flight_.expire(now - request_timeout, [&](auto &entry) {
+    ++counter_.timeout;
+    fail_in_flight(entry.value.request, RequestStatus::TIMEOUT);
+    // note! we don't know if the exchange received the request
+    order_status(entry.value);
+  });
+  if (count) {
+    log::warn(R"(Detected {} request timeout(s) => query order status (account="{}"))"sv, count, account_.name);
+  }
+  if (!std::empty(in_flight_)) {
+    timer_.timeout.schedule(in_flight_.oldest() + request_timeout);
+  }
+}
+
+void WebSocket::fail_in_flight(json::WSAPIRequest const &request, RequestStatus request_status) {
+  auto request_type = [&]() {
+    switch (request.type) {
+      using enum json::WSAPIType::type_t;
+      case ORDER_PLACE:
+        return RequestType::CREATE_ORDER;
+      case ORDER_MODIFY:
+        return RequestType::MODIFY_ORDER;
+      case ORDER_CANCEL:
+        return RequestType::CANCEL_ORDER;
+      default:
+        break;
+    }
+    return RequestType{};
+  }();
+  if (request_type == RequestType{}) [[unlikely]] {
+    return;
+  }
+  log::warn("request={}, request_status={}"sv, request, request_status);
+  TraceInfo trace_info;
+  auto response = server::oms::Response{
+      .request_type = request_type,
+      .origin = Origin::GATEWAY,
+      .request_status = request_status,
+      .error = {},
+      .text = {},
+      .version = request.version,
+      .request_id = {},
+      .quantity = NaN,
+      .price = NaN,
+  };
+  Trace event{trace_info, response};
+  (*this)(event, request.user_id, request.order_id);
+}
+
 template <typename... Args>
 void WebSocket::operator()(Trace<server::oms::Response> const &event, uint8_t user_id, uint64_t order_id, Args &&...args) {
   auto &[trace_info, response] = event;
-  if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<Args>(args)..., []([[maybe_unused]] auto &order) {})) {
-  } else {
-    log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+  if (response.request_type == RequestType::CANCEL_ORDER) {
+    auto key = tools::Race::Key{
+        .user_id = user_id,
+        .order_id = order_id,
+        .version = response.version,
+    };
+    if (!shared_.cancel_race(key, response.request_status == RequestStatus::ACCEPTED)) {
+      log::info<1>("Drop response (cancel race): user_id={}, order_id={}, request_status={}"sv, user_id, order_id, response.request_status);
+      return;
+    }
   }
+  auto update_order = [&](auto &&...args_2) {
+    if (shared_.update_order(user_id, order_id, stream_id_, trace_info, response, std::forward<decltype(args_2)>(args_2)..., [](auto &) {})) {
+    } else {
+      log::warn("Did not find order: user_id={}, order_id={}"sv, user_id, order_id);
+    }
+  };
+  if constexpr (sizeof...(Args) == 1) {
+    // note! the response must always be delivered
+    if (!shared_.check_order_update(args...)) {
+      log::info<3>("Drop order update (redundant or out of order): user_id={}, order_id={}"sv, user_id, order_id);
+      update_order();
+      return;
+    }
+  }
+  update_order(std::forward<Args>(args)...);
 }
 
 void WebSocket::operator()(Trace<server::oms::OrderUpdate> const &event, std::string_view const &client_order_id) {
   auto &[trace_info, order_update] = event;
+  if (!shared_.check_order_update(order_update)) {
+    log::info<3>(R"(Drop order update (redundant or out of order): client_order_id="{}")"sv, client_order_id);
+    return;
+  }
+  if (shared_.update_quote_leg(request_.quote_legs, order_update) != SOURCE_NONE) {
+    return;  // note! quote legs are not known to the order management system
+  }
   if (shared_.update_order(client_order_id, stream_id_, trace_info, order_update, [&]([[maybe_unused]] auto &order) {})) {
   } else {
     log::warn("*** EXTERNAL ORDER ***"sv);
@@ -34,17 +34,32 @@
 #include "roq/binance_futures/shared.hpp"
 #include "roq/binance_futures/web_socket_state.hpp"
 
+#include "roq/binance_futures/tools/in_flight.hpp"
+#include "roq/binance_futures/tools/round_trip.hpp"
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
 #include "roq/binance_futures/json/wsapi_parser.hpp"
 
 namespace roq {
 namespace binance_futures {
 
-struct WebSocket final : public OrderEntry, public web::socket::Client::Handler, public json::WSAPIParser::Handler {
+struct WebSocket final : public OrderEntry, public web::socket::Client::Handler, public json::WSAPIParser::Handler, public tools::TimerWheel::Handler {
   struct ListenKeyUpdate final {
     std::string_view account;
     std::string_view listen_key;
   };
 
+  struct UserStreamUpdate final {
+    std::string_view account;
+    bool ready = false;
+  };
+
+  struct UserStreamEvent final {
+    std::string_view account;
+    std::string_view message;
+  };
+
   struct Handler {
     virtual void operator()(Trace<StreamStatus> const &) = 0;
     virtual void operator()(Trace<ExternalLatency> const &) = 0;
@@ -54,15 +69,26 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
     virtual void operator()(Trace<PositionUpdate> const &, bool is_last) = 0;
     // cross-communication
     virtual void operator()(ListenKeyUpdate const &) = 0;
+    virtual void operator()(UserStreamUpdate const &) = 0;
+    virtual void operator()(UserStreamEvent const &) = 0;
   };
 
   WebSocket(Handler &, io::Context &, uint16_t stream_id, Account &, Shared &, Request &, bool master = true, std::string_view const &interface = {});
 
+  uint16_t get_stream_id() const { return stream_id_; }
+
   bool ready() const { return status_ == ConnectionStatus::READY; }
 
+  bool master() const { return master_; }
+
+  // note! promotion does not repeat downloads (progress is tracked by the shared request state)
+  void set_master(bool master);
+
+  // note! smoothed order round-trip (ping samples keep idle sessions ranked)
+  std::chrono::nanoseconds round_trip() const { return round_trip_.get(); }
+
   void operator()(Event<Start> const &) override;
   void operator()(Event<Stop> const &) override;
-  void operator()(Event<Timer> const &) override;
 
   void operator()(metrics::Writer &) const override;
 
@@ -73,20 +99,36 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
       Event<CancelOrder> const &, server::oms::Order const &, std::string_view const &request_id, std::string_view const &previous_request_id) override;
   uint16_t operator()(Event<CancelAllOrders> const &, std::string_view const &request_id) override;
 
+  uint16_t operator()(Event<MassQuote> const &) override;
+  uint16_t operator()(Event<CancelQuotes> const &) override;
+
  protected:
+  // note! symbol and client order id are needed to query the order status if the request times out
+  struct InFlightRequest final {
+    json::WSAPIRequest request;
+    Symbol symbol;
+    ClientOrderId client_order_id;
+  };
+
   bool downloading() const { return download_balance_ || download_account_ | download_orders_; }
 
+  // tools::TimerWheel::Handler
+
+  void operator()(tools::TimerWheel::Timeout const &) override;
+
+  void refresh(std::chrono::nanoseconds now);
+
   void session_logon();
 
   void user_data_stream_start();
   void user_data_stream_ping(std::chrono::nanoseconds now);
+  void user_data_stream_subscribe();
 
   void account_balance();
   void account_status();
   void account_position();
 
-  bool order_status();
-  void order_status(std::string_view const &symbol);
+  void order_status(InFlightRequest const &);
 
   void open_orders_cancel_all(Event<CancelAllOrders> const &, std::string_view const &request_id);
 
@@ -116,6 +158,8 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
   void operator()(Trace<json::WSAPIError> const &) override;
   void operator()(Trace<json::WSAPISessionLogon> const &) override;
   void operator()(Trace<json::WSAPIListenKey> const &) override;
+  void operator()(Trace<json::WSAPISubscribe> const &) override;
+  void operator()(Trace<json::WSAPIParser::UserDataEvent> const &) override;
   void operator()(Trace<json::WSAPIAccountBalance> const &) override;
   void operator()(Trace<json::WSAPIAccountStatus> const &) override;
   void operator()(Trace<json::WSAPIAccountPosition> const &) override;
@@ -125,11 +169,17 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
   void operator()(Trace<json::WSAPIOrderPlace> const &, json::WSAPIRequest const &) override;
   void operator()(Trace<json::WSAPIOrderModify> const &, json::WSAPIRequest const &) override;
   void operator()(Trace<json::WSAPIOrderCancel> const &, json::WSAPIRequest const &) override;
+  void operator()(Trace<json::WSAPIOrderStatus> const &, json::WSAPIRequest const &) override;
 
   // helpers
 
   void update_rate_limits(auto &event);
 
+  void add_in_flight(json::WSAPIRequest const &, std::string_view const &symbol, std::string_view const &client_order_id);
+  bool update_round_trip(json::WSAPIRequest const &);
+  void check_timeouts(std::chrono::nanoseconds now);
+  void fail_in_flight(json::WSAPIRequest const &, RequestStatus);
+
   template <typename... Args>
   void operator()(Trace<server::oms::Response> const &, uint8_t user_id, uint64_t order_id, Args &&...args);
 
@@ -147,13 +197,15 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
   core::json::BufferStack decode_buffer_;
   // metrics
   struct {
-    utils::metrics::Counter disconnect;
+    utils::metrics::Counter disconnect, timeout;
   } counter_;
   struct {
     utils::metrics::Profile parse, error,                    //
         session_logon, session_logon_ack,                    //
         user_data_stream_start, user_data_stream_start_ack,  //
         user_data_stream_ping, user_data_stream_ping_ack,    //
+        user_data_stream_subscribe,                          //
+        user_data_stream_subscribe_ack, user_data_event,     //
         account_balance, account_balance_ack,                //
         account_status, account_status_ack,                  //
         account_position, account_position_ack,              //
@@ -165,7 +217,8 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
         order_cancel, order_cancel_ack;
   } profile_;
   struct {
-    utils::metrics::Latency ping, heartbeat;
+    utils::metrics::Latency ping, heartbeat,  //
+        order_place_round_trip, order_modify_round_trip, order_cancel_round_trip;
   } latency_;
   struct {
     utils::metrics::Gauge request_weight_1m, create_order_10s, create_order_1d;
@@ -178,7 +231,9 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
   // experimental
   uint32_t request_id_;
   std::string listen_key_;
+  std::chrono::nanoseconds session_logon_start_ = {};
   std::chrono::nanoseconds listen_key_refresh_ = {};
+  bool user_stream_ = false;
   bool download_balance_ = false;
   bool download_account_ = false;
   bool download_orders_ = false;
@@ -189,7 +244,14 @@ struct WebSocket final : public OrderEntry, public web::socket::Client::Handler,
   bool ready_ = false;
   ConnectionStatus status_ = {};
   core::Download<WebSocketState> download_;
+  tools::InFlight<InFlightRequest> in_flight_;
+  tools::RoundTrip round_trip_;
   [[maybe_unused]] bool download_trades_is_first_ = true;
+  // timers
+  struct {
+    tools::Ticker::Subscription refresh;
+    tools::TimerWheel::Timer listen_key, timeout;
+  } timer_;
 };
 
 }  // namespace binance_futures
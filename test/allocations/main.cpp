@@ -0,0 +1,9 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#define CATCH_CONFIG_RUNNER
+
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char **argv) {
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,185 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/utils/charconv/to_string.hpp"
+
+#include "roq/core/json/buffer_stack.hpp"
+
+#include "roq/web/rest/client.hpp"
+
+#include "roq/server.hpp"
+
+#include "roq/binance_futures/json/encoder.hpp"
+#include "roq/binance_futures/json/order_place_ack.hpp"
+#include "roq/binance_futures/json/order_templates.hpp"
+
+#include "roq/binance_futures/tools/crypto.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+// note! counts heap allocations made by this test binary (which is why it's a separate executable)
+
+namespace {
+std::atomic<size_t> ALLOCATIONS;
+
+struct AllocationCounter final {
+  AllocationCounter() : start_{ALLOCATIONS.load()} {}
+  size_t count() const { return ALLOCATIONS.load() - start_; }
+
+ private:
+  size_t const start_;
+};
+}  // namespace
+
+void *operator new(size_t size) {
+  ++ALLOCATIONS;
+  if (auto result = std::malloc(size ? size : 1)) {
+    return result;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+// https://developers.binance.com/docs/derivatives/usds-margined-futures/general-info#signed-trade-and-user_data-endpoint-security
+auto const KEY = "dbefbc809e3e83c283a984c3a1459732ea7db1360ca80c5c2c8867408d28cc83"sv;
+auto const SECRET = "2b5eb11e18796d12d88f13dc27dbbd02c2cc51ff7059765ed9821957d82bb4d9"sv;
+
+auto const REQUEST_ID = "qQAC6QMAAQAAVtg9ctAW"sv;
+
+auto const ORDER_PLACE_ACK = R"({)"
+                             R"("orderId":17759343290,)"
+                             R"("symbol":"BTCUSDT",)"
+                             R"("status":"NEW",)"
+                             R"("clientOrderId":"qQAC6QMAAQAAVtg9ctAW",)"
+                             R"("price":"9000",)"
+                             R"("avgPrice":"0.00000",)"
+                             R"("origQty":"1",)"
+                             R"("executedQty":"0",)"
+                             R"("cumQty":"0",)"
+                             R"("cumQuote":"0",)"
+                             R"("timeInForce":"GTC",)"
+                             R"("type":"LIMIT",)"
+                             R"("reduceOnly":false,)"
+                             R"("closePosition":false,)"
+                             R"("side":"BUY",)"
+                             R"("positionSide":"BOTH",)"
+                             R"("stopPrice":"0",)"
+                             R"("workingType":"CONTRACT_PRICE",)"
+                             R"("priceProtect":false,)"
+                             R"("origType":"LIMIT",)"
+                             R"("updateTime":1634543725791)"
+                             R"(})"sv;
+
+auto create_crypto() {
+  // note! PORTFOLIO uses the secret as-is (HMAC-SHA256)
+  return std::make_unique<tools::Crypto>(KEY, SECRET, MarginMode::PORTFOLIO, ""sv, ""sv);
+}
+
+auto create_create_order() {
+  auto create_order = CreateOrder{};
+  create_order.symbol = "BTCUSDT"sv;
+  create_order.side = Side::BUY;
+  create_order.order_type = OrderType::LIMIT;
+  create_order.time_in_force = TimeInForce::GTC;
+  create_order.quantity = 1.0;
+  create_order.price = 9000.0;
+  create_order.stop_price = NaN;
+  return create_order;
+}
+
+auto create_order() {
+  auto order = server::oms::Order{};
+  order.exchange = "binance-futures"sv;
+  order.symbol = "BTCUSDT"sv;
+  order.side = Side::BUY;
+  order.client_order_id = REQUEST_ID;
+  order.quantity = 1.0;
+  order.price = 9000.0;
+  order.quantity_precision = {1.0, Precision::_0};
+  order.price_precision = {0.1, Precision::_1};
+  return order;
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+// note! mirrors the order-entry path: encode -> sign -> web::rest::Request -> parse ack -> server::oms::Response
+TEST_CASE("allocations_order_place_round_trip", "[allocations]") {
+  auto crypto = create_crypto();
+  json::OrderTemplates order_templates;
+  auto create_order_2 = create_create_order();
+  auto order = create_order();
+  std::vector<char> encode_buffer;
+  core::json::BufferStack buffers{65536, 2};
+  auto helper = [&](size_t i) {
+    // request
+    auto params = json::Encoder::order_place_url(encode_buffer, order_templates, create_order_2, order, REQUEST_ID, 5s);
+    auto body = (*crypto).sign_rest_body(encode_buffer, std::size(params), 1591702613943ms + std::chrono::milliseconds{i});
+    auto request = web::rest::Request{
+        .method = web::http::Method::POST,
+        .path = "/fapi/v1/order"sv,
+        .query = {},
+        .accept = web::http::Accept::APPLICATION_JSON,
+        .content_type = web::http::ContentType::APPLICATION_X_WWW_FORM_URLENCODED,
+        .headers = (*crypto).get_rest_headers(),
+        .body = body,
+        .quality_of_service = io::QualityOfService::IMMEDIATE,
+    };
+    // response
+    json::OrderPlaceAck order_place_ack{ORDER_PLACE_ACK, buffers};
+    ExternalOrderId external_order_id;
+    utils::charconv::to_string(std::back_inserter(external_order_id), order_place_ack.order_id);
+    auto response = server::oms::Response{
+        .request_type = RequestType::CREATE_ORDER,
+        .origin = Origin::EXCHANGE,
+        .request_status = RequestStatus::ACCEPTED,
+        .error = {},
+        .text = {},
+        .version = 1,
+        .request_id = {},
+        .quantity = order_place_ack.orig_qty,
+        .price = order_place_ack.price,
+    };
+    return std::make_pair(request, std::size(external_order_id) + (response.request_status == RequestStatus::ACCEPTED));
+  };
+  // warm-up
+  auto [request, _] = helper(0);
+  auto body = std::string_view{request.body};
+  CHECK(body.starts_with("symbol=BTCUSDT&side=BUY&type=LIMIT&"sv));
+  CHECK(body.find("&newClientOrderId=qQAC6QMAAQAAVtg9ctAW"sv) != std::string_view::npos);
+  CHECK(body.find("&timestamp=1591702613943&signature="sv) != std::string_view::npos);
+  auto length = std::size(body);
+  size_t total = 0;
+  AllocationCounter counter;
+  for (size_t i = 0; i < 100; ++i) {
+    auto [request_2, result] = helper(i);
+    total += std::size(request_2.body) + result;
+  }
+  auto allocations = counter.count();  // note! before catch2 gets a chance to allocate
+  CHECK(allocations == 0);
+  CHECK(total == 100 * (length + 11 + 1));
+}
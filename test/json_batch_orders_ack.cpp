@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/core/json/buffer_stack.hpp"
+
+#include "roq/binance_futures/json/batch_orders_ack.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace Catch::literals;
+
+using value_type = json::BatchOrdersAck;
+
+TEST_CASE("json_batch_orders_ack_mixed", "[json_batch_orders_ack]") {
+  auto message = R"([{)"
+                 R"("orderId":17759646892,)"
+                 R"("symbol":"XRPUSDT",)"
+                 R"("status":"NEW",)"
+                 R"("clientOrderId":"q1735689600123-3-1",)"
+                 R"("price":"1.0823",)"
+                 R"("avgPrice":"0.00000",)"
+                 R"("origQty":"5",)"
+                 R"("executedQty":"0",)"
+                 R"("cumQty":"0",)"
+                 R"("cumQuote":"0",)"
+                 R"("timeInForce":"GTC",)"
+                 R"("type":"LIMIT",)"
+                 R"("reduceOnly":false,)"
+                 R"("closePosition":false,)"
+                 R"("side":"BUY",)"
+                 R"("positionSide":"BOTH",)"
+                 R"("stopPrice":"0",)"
+                 R"("workingType":"CONTRACT_PRICE",)"
+                 R"("priceProtect":false,)"
+                 R"("origType":"LIMIT",)"
+                 R"("updateTime":1634545259912)"
+                 R"(},{)"
+                 R"("code":-2022,)"
+                 R"("msg":"ReduceOnly Order is rejected.")"
+                 R"(}])";
+  auto helper = [&](value_type &obj) {
+    auto &data = obj.data;
+    REQUIRE(std::size(data) == 2);
+    auto &data_0 = data[0];
+    CHECK(data_0.code == 0);
+    CHECK(data_0.order_id == 17759646892);
+    CHECK(data_0.symbol == "XRPUSDT"sv);
+    CHECK(data_0.status == json::OrderStatus::NEW);
+    CHECK(data_0.client_order_id == "q1735689600123-3-1"sv);
+    CHECK(data_0.price == 1.0823_a);
+    CHECK(data_0.orig_qty == 5.0_a);
+    CHECK(data_0.executed_qty == 0.0_a);
+    CHECK(data_0.time_in_force == json::TimeInForce::GTC);
+    CHECK(data_0.type == json::OrderType::LIMIT);
+    CHECK(data_0.side == json::Side::BUY);
+    CHECK(data_0.update_time == 1634545259912ms);
+    auto &data_1 = data[1];
+    CHECK(data_1.code == -2022);
+    CHECK(data_1.msg == "ReduceOnly Order is rejected."sv);
+    CHECK(data_1.order_id == 0);
+    CHECK(std::empty(data_1.client_order_id));
+  };
+  core::json::BufferStack buffers{65536, 2};
+  value_type obj{message, buffers};
+  helper(obj);
+}
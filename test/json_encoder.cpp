@@ -2,6 +2,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include <array>
+
 #include "roq/logging.hpp"
 
 #include "roq/binance_futures/json/encoder.hpp"
@@ -145,3 +147,90 @@ TEST_CASE("rounding_issue_oc45", "[json_encoder]") {
       result ==
       R"({"id":"SOME_ID","method":"order.modify","params":{"symbol":"BTC","side":"BUY","orderId":oid:1234,"quantity":"1","price":"90085.7","recvWindow":5000,"timestamp":0}})"sv);
 }
+
+TEST_CASE("order_cancel_json", "[json_encoder]") {
+  std::vector<char> buffer;
+  auto order = create_order(1.0, 1.0);
+  auto result = json::Encoder::order_cancel_json(buffer, {}, order, {}, {}, 5s, 1234ms, "SOME_ID");
+  CHECK(result == R"({"id":"SOME_ID","method":"order.cancel","params":{"symbol":"BTC","orderId":oid:1234,"recvWindow":5000,"timestamp":1234}})"sv);
+}
+
+TEST_CASE("open_orders_cancel_all_json", "[json_encoder]") {
+  std::vector<char> buffer;
+  auto result = json::Encoder::open_orders_cancel_all_json(buffer, "BTC"sv, 1234ms, "SOME_ID");
+  CHECK(result == R"({"id":"SOME_ID","method":"openOrders.cancelAll","params":{"symbol":"BTC","timestamp":"1234"}})"sv);
+}
+
+TEST_CASE("order_place_json", "[json_encoder]") {
+  std::vector<char> buffer;
+  json::OrderTemplates order_templates;
+  auto create_order_2 = CreateOrder{};
+  create_order_2.symbol = "BTC"sv;
+  create_order_2.side = Side::SELL;
+  create_order_2.order_type = OrderType::LIMIT;
+  create_order_2.time_in_force = TimeInForce::GTC;
+  create_order_2.quantity = 0.12;
+  create_order_2.price = 90085.7 - 1.0e-12;
+  create_order_2.stop_price = NaN;
+  auto order = create_order(1.0, 1.0);
+  order.quantity_precision = {0.001, Precision::_3};
+  order.price_precision = {0.1, Precision::_1};
+  for (size_t i = 0; i < 2; ++i) {
+    auto result = json::Encoder::order_place_json(buffer, order_templates, create_order_2, order, "REQ_ID"sv, 5s, 1234ms, "SOME_ID");
+    CHECK(
+        result ==
+        R"({"id":"SOME_ID","method":"order.place","params":{"symbol":"BTC","side":"SELL","type":"LIMIT","timeInForce":"GTC","newClientOrderId":"REQ_ID","quantity":"0.12","price":"90085.7","recvWindow":5000,"timestamp":1234}})"sv);
+  }
+  CHECK(order_templates.size() == 1);
+}
+
+TEST_CASE("fixed_point", "[json_encoder]") {
+  std::array<char, json::FixedPoint::MAX_LENGTH> buffer;
+  CHECK(json::FixedPoint::render(buffer, 90085.7 - 1.0e-12, Precision::_1) == "90085.7"sv);
+  CHECK(json::FixedPoint::render(buffer, 1.10, Precision::_2) == "1.1"sv);
+  CHECK(json::FixedPoint::render(buffer, -0.05, Precision::_2) == "-0.05"sv);
+  CHECK(json::FixedPoint::render(buffer, 100.0, Precision::_0) == "100"sv);
+  CHECK(json::FixedPoint::render(buffer, 0.00000001, Precision::_8) == "0.00000001"sv);
+  CHECK(std::empty(json::FixedPoint::render(buffer, 1.0, Precision::UNDEFINED)));
+  CHECK(std::empty(json::FixedPoint::render(buffer, NaN, Precision::_2)));
+}
+
+TEST_CASE("batch_orders_place_url", "[json_encoder]") {
+  std::vector<char> buffer;
+  json::Encoder::QuoteLeg legs[] = {
+      {
+          .symbol = "BTC"sv,
+          .side = Side::BUY,
+          .quantity = 1.0,
+          .price = 90085.7 - 1.0e-12,
+          .client_order_id = "q1"sv,
+          .quantity_precision = Precision::_3,
+          .price_precision = Precision::_1,
+      },
+      {
+          .symbol = "BTC"sv,
+          .side = Side::SELL,
+          .quantity = 2.0,
+          .price = 101.0,
+          .client_order_id = "q2"sv,
+      },
+  };
+  auto result = json::Encoder::batch_orders_place_url(buffer, legs, 5s);
+  CHECK(
+      result == "batchOrders=%5B"
+                "%7B%22symbol%22%3A%22BTC%22%2C%22side%22%3A%22BUY%22%2C%22type%22%3A%22LIMIT%22%2C%22timeInForce%22%3A%22GTC%22"
+                "%2C%22quantity%22%3A%221%22%2C%22price%22%3A%2290085.7%22%2C%22newClientOrderId%22%3A%22q1%22%7D"
+                "%2C"
+                "%7B%22symbol%22%3A%22BTC%22%2C%22side%22%3A%22SELL%22%2C%22type%22%3A%22LIMIT%22%2C%22timeInForce%22%3A%22GTC%22"
+                "%2C%22quantity%22%3A%222%22%2C%22price%22%3A%22101%22%2C%22newClientOrderId%22%3A%22q2%22%7D"
+                "%5D&recvWindow=5000"sv);
+}
+
+TEST_CASE("batch_orders_cancel_url", "[json_encoder]") {
+  std::vector<char> buffer;
+  ClientOrderId client_order_ids[2];
+  client_order_ids[0] = "q1"sv;
+  client_order_ids[1] = "q2"sv;
+  auto result = json::Encoder::batch_orders_cancel_url(buffer, "BTC"sv, client_order_ids, 5s);
+  CHECK(result == "symbol=BTC&origClientOrderIdList=%5B%22q1%22%2C%22q2%22%5D&recvWindow=5000"sv);
+}
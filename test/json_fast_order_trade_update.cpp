@@ -0,0 +1,126 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "user_stream_parser_tester.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace Catch::literals;
+
+// note! captured fill
+
+namespace {
+auto const FILL = R"({)"
+                  R"("e":"ORDER_TRADE_UPDATE",)"
+                  R"("T":1634812374563,)"
+                  R"("E":1634812374567,)"
+                  R"("o":{)"
+                  R"("s":"XRPUSDT",)"
+                  R"("c":"-gAC6QMAAQAAYIZV_g4X",)"
+                  R"("S":"SELL",)"
+                  R"("o":"LIMIT",)"
+                  R"("f":"GTC",)"
+                  R"("q":"5",)"
+                  R"("p":"1.1583",)"
+                  R"("ap":"1.15830",)"
+                  R"("sp":"0",)"
+                  R"("x":"TRADE",)"
+                  R"("X":"FILLED",)"
+                  R"("i":17803846427,)"
+                  R"("l":"5",)"
+                  R"("z":"5",)"
+                  R"("L":"1.1583",)"
+                  R"("n":"0.00115829",)"
+                  R"("N":"USDT",)"
+                  R"("T":1634812374563,)"
+                  R"("t":673747843,)"
+                  R"("b":"0",)"
+                  R"("a":"0",)"
+                  R"("m":true,)"
+                  R"("R":false,)"
+                  R"("wt":"CONTRACT_PRICE",)"
+                  R"("ot":"LIMIT",)"
+                  R"("ps":"BOTH",)"
+                  R"("cp":false,)"
+                  R"("rp":"0",)"
+                  R"("pP":false,)"
+                  R"("si":0,)"
+                  R"("ss":0)"
+                  R"(})"
+                  R"(})"sv;
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("json_fast_order_trade_update_simple", "[json_fast_order_trade_update]") {
+  json::FastOrderTradeUpdate obj;
+  core::json::Parser parser{FILL};
+  auto root = parser.root();
+  for (auto [key, value] : std::get<core::json::Object>(root)) {
+    obj.update(key, value);
+  }
+  CHECK(obj.event_type == json::EventType::ORDER_TRADE_UPDATE);
+  CHECK(obj.transaction_time == 1634812374563ms);
+  CHECK(obj.event_time == 1634812374567ms);
+  CHECK(obj.symbol == "XRPUSDT"sv);
+  CHECK(obj.client_order_id == "-gAC6QMAAQAAYIZV_g4X"sv);
+  CHECK(obj.side == json::Side::SELL);
+  CHECK(obj.order_type == json::OrderType::LIMIT);
+  CHECK(obj.time_in_force == json::TimeInForce::GTC);
+  CHECK(obj.original_quantity == 5.0_a);
+  CHECK(obj.original_price == 1.1583_a);
+  CHECK(obj.average_price == 1.1583_a);
+  CHECK(obj.stop_price == 0.0_a);
+  CHECK(obj.execution_type == json::ExecutionType::TRADE);
+  CHECK(obj.order_status == json::OrderStatus::FILLED);
+  CHECK(obj.order_id == 17803846427);
+  CHECK(obj.last_filled_quantity == 5.0_a);
+  CHECK(obj.order_filled_accumulated_quantity == 5.0_a);
+  CHECK(obj.last_filled_price == 1.1583_a);
+  CHECK(obj.commission == 0.00115829_a);
+  CHECK(obj.commission_asset == "USDT"sv);
+  CHECK(obj.order_trade_time == 1634812374563ms);
+  CHECK(obj.trade_id == 673747843);
+  CHECK(obj.is_trade_maker == true);
+}
+
+TEST_CASE("json_fast_order_trade_update_event_type_not_first", "[json_fast_order_trade_update]") {
+  // note! exercises the fallback (event type must be found before decoding)
+  auto message = R"({)"
+                 R"("T":1634812374563,)"
+                 R"("E":1634812374567,)"
+                 R"("e":"ORDER_TRADE_UPDATE",)"
+                 R"("o":{)"
+                 R"("s":"XRPUSDT",)"
+                 R"("c":"-gAC6QMAAQAAYIZV_g4X",)"
+                 R"("S":"SELL",)"
+                 R"("o":"LIMIT",)"
+                 R"("f":"GTC",)"
+                 R"("q":"5",)"
+                 R"("p":"1.1583",)"
+                 R"("ap":"1.15830",)"
+                 R"("sp":"0",)"
+                 R"("x":"TRADE",)"
+                 R"("X":"FILLED",)"
+                 R"("i":17803846427,)"
+                 R"("l":"5",)"
+                 R"("z":"5",)"
+                 R"("L":"1.1583",)"
+                 R"("n":"0.00115829",)"
+                 R"("N":"USDT",)"
+                 R"("T":1634812374563,)"
+                 R"("t":673747843,)"
+                 R"("m":true)"
+                 R"(})"
+                 R"(})";
+  auto helper = [](json::OrderTradeUpdate const &obj) {
+    CHECK(obj.event_type == json::EventType::ORDER_TRADE_UPDATE);
+    CHECK(obj.execution_report.trade_id == 673747843);
+  };
+  UserStreamParserTester<json::OrderTradeUpdate>::dispatch(helper, message, 8192, 1);
+}
@@ -0,0 +1,49 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "user_stream_parser_tester.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using namespace Catch::literals;
+
+using value_type = json::TradeLite;
+
+TEST_CASE("simple", "[json_trade_lite]") {
+  auto message = R"({)"
+                 R"("e":"TRADE_LITE",)"
+                 R"("E":1721895408092,)"
+                 R"("T":1721895408214,)"
+                 R"("s":"BTCUSDT",)"
+                 R"("q":"0.001",)"
+                 R"("p":"0",)"
+                 R"("m":false,)"
+                 R"("c":"z8hcUoOsqEdKMeKPSABslD",)"
+                 R"("S":"BUY",)"
+                 R"("L":"64089.20",)"
+                 R"("l":"0.040",)"
+                 R"("t":109100866,)"
+                 R"("i":8886774)"
+                 R"(})";
+  auto helper = [](value_type const &obj) {
+    CHECK(obj.event_type == json::EventType::TRADE_LITE);
+    CHECK(obj.event_time == 1721895408092ms);
+    CHECK(obj.transaction_time == 1721895408214ms);
+    CHECK(obj.symbol == "BTCUSDT"sv);
+    CHECK(obj.original_quantity == 0.001_a);
+    CHECK(obj.original_price == 0.0_a);
+    CHECK(obj.maker == false);
+    CHECK(obj.client_order_id == "z8hcUoOsqEdKMeKPSABslD"sv);
+    CHECK(obj.side == json::Side::BUY);
+    CHECK(obj.last_filled_price == 64089.2_a);
+    CHECK(obj.last_filled_quantity == 0.04_a);
+    CHECK(obj.trade_id == 109100866);
+    CHECK(obj.order_id == 8886774);
+  };
+  UserStreamParserTester<value_type>::dispatch(helper, message, 8192, 1);
+}
@@ -0,0 +1,93 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "wsapi_parser_tester.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using value_type = json::WSAPIOrderStatus;
+
+// fapi
+
+TEST_CASE("fapi_failure", "[json_wsapi_order_status]") {
+  auto message = R"({)"
+                 R"("id":"jYQeAA8CpIs3B0UAAAAAAAAAAAAAAAAAAAAA",)"
+                 R"("status":400,)"
+                 R"("error":{)"
+                 R"("code":-2013,)"
+                 R"("msg":"Order does not exist.")"
+                 R"(},)"
+                 R"("rateLimits":[{)"
+                 R"("rateLimitType":"REQUEST_WEIGHT",)"
+                 R"("interval":"MINUTE",)"
+                 R"("intervalNum":1,)"
+                 R"("limit":2400,)"
+                 R"("count":20)"
+                 R"(})"
+                 R"(])"
+                 R"(})"sv;
+  auto helper = [](value_type const &obj) {
+    CHECK(obj.id == "jYQeAA8CpIs3B0UAAAAAAAAAAAAAAAAAAAAA"sv);
+    CHECK(obj.status == 400);
+    CHECK(obj.error.code == -2013);
+    CHECK(obj.error.msg == "Order does not exist."sv);
+    REQUIRE(std::size(obj.rate_limits) == 1);
+  };
+  WSAPIParserTester<value_type>::dispatch(helper, message, 8192, 1);
+}
+
+TEST_CASE("fapi_success", "[json_wsapi_order_status]") {
+  auto message = R"({)"
+                 R"("id":"jYQeAA8CpIs3B0UAAAAAAAAAAAAAAAAAAAAA",)"
+                 R"("status":200,)"
+                 R"("result":{)"
+                 R"("avgPrice":"0.00",)"
+                 R"("clientOrderId":"HgACpIs3B0UAAQAAAAAA",)"
+                 R"("cumQuote":"0.00000",)"
+                 R"("executedQty":"0.000",)"
+                 R"("orderId":851545109401,)"
+                 R"("origQty":"1.000",)"
+                 R"("origType":"LIMIT",)"
+                 R"("price":"32323.00",)"
+                 R"("reduceOnly":false,)"
+                 R"("side":"BUY",)"
+                 R"("positionSide":"BOTH",)"
+                 R"("status":"NEW",)"
+                 R"("stopPrice":"0.00",)"
+                 R"("closePosition":false,)"
+                 R"("symbol":"BTCUSDT",)"
+                 R"("time":1765337031400,)"
+                 R"("timeInForce":"GTC",)"
+                 R"("type":"LIMIT",)"
+                 R"("updateTime":1765337031434,)"
+                 R"("workingType":"CONTRACT_PRICE",)"
+                 R"("priceProtect":false,)"
+                 R"("priceMatch":"NONE",)"
+                 R"("selfTradePreventionMode":"EXPIRE_MAKER",)"
+                 R"("goodTillDate":0)"
+                 R"(},)"
+                 R"("rateLimits":[{)"
+                 R"("rateLimitType":"REQUEST_WEIGHT",)"
+                 R"("interval":"MINUTE",)"
+                 R"("intervalNum":1,)"
+                 R"("limit":2400,)"
+                 R"("count":22)"
+                 R"(})"
+                 R"(])"
+                 R"(})"sv;
+  auto helper = [](value_type const &obj) {
+    CHECK(obj.id == "jYQeAA8CpIs3B0UAAAAAAAAAAAAAAAAAAAAA"sv);
+    CHECK(obj.status == 200);
+    CHECK(obj.result.order_id == 851545109401);
+    CHECK(obj.result.client_order_id == "HgACpIs3B0UAAQAAAAAA"sv);
+    CHECK(obj.result.executed_qty == 0.0_a);
+    REQUIRE(std::size(obj.rate_limits) == 1);
+  };
+  WSAPIParserTester<value_type>::dispatch(helper, message, 8192, 1);
+}
@@ -0,0 +1,40 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <fmt/format.h>
+
+#include "wsapi_parser_tester.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+using namespace Catch::literals;
+
+using value_type = json::WSAPISubscribe;
+
+TEST_CASE("simple", "[json_wsapi_subscribe]") {
+  auto request = json::WSAPIRequest{
+      .sequence = 123,
+      .type = json::WSAPIType::USER_DATA_STREAM_SUBSCRIBE,
+  };
+  std::vector<char> buffer;
+  auto request_id = json::WSAPIRequest::encode(buffer, request);
+  auto message = fmt::format(
+      R"({{)"
+      R"("id":"{}",)"
+      R"("status":200,)"
+      R"("result":{{)"
+      R"("subscriptionId":0)"
+      R"(}})"
+      R"(}})"sv,
+      request_id);
+  auto helper = [&](value_type const &obj) {
+    CHECK(obj.id == request_id);
+    CHECK(obj.status == 200);
+    CHECK(obj.result.subscription_id == 0);
+  };
+  WSAPIParserTester<value_type>::dispatch(helper, message, 8192, 1);
+}
@@ -0,0 +1,43 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <fmt/format.h>
+
+#include "wsapi_parser_tester.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+using value_type = json::WSAPIParser::UserDataEvent;
+
+TEST_CASE("simple", "[json_wsapi_user_data_event]") {
+  auto event = R"({)"
+               R"("e":"ORDER_TRADE_UPDATE",)"
+               R"("T":1568879465651,)"
+               R"("E":1568879465651,)"
+               R"("o":{)"
+               R"("s":"BTCUSDT",)"
+               R"("c":"TEST}{\"",)"
+               R"("S":"SELL",)"
+               R"("o":"TRAILING_STOP_MARKET",)"
+               R"("f":"GTC",)"
+               R"("q":"0.001",)"
+               R"("p":"0",)"
+               R"("x":"NEW",)"
+               R"("X":"NEW",)"
+               R"("i":8886774,)"
+               R"("t":0)"
+               R"(})"
+               R"(})"sv;
+  auto message = fmt::format(
+      R"({{)"
+      R"("subscriptionId":0,)"
+      R"("event":{})"
+      R"(}})"sv,
+      event);
+  auto helper = [&](value_type const &obj) { CHECK(obj.message == event); };
+  WSAPIParserTester<value_type>::dispatch(helper, message, 8192, 3);
+}
@@ -0,0 +1,36 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/numbers.hpp"
+
+#include "roq/binance_futures/tools/account_cache.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_account_cache_balance", "[tools_account_cache]") {
+  tools::AccountCache account_cache;
+  CHECK(account_cache.balance(MarginMode::CROSS, "USDT"sv, 100.0, NaN) == true);
+  CHECK(account_cache.balance(MarginMode::CROSS, "USDT"sv, 100.0, NaN) == false);
+  CHECK(account_cache.balance(MarginMode::CROSS, "USDT"sv, 100.0, 1.0) == true);
+  CHECK(account_cache.balance(MarginMode::CROSS, "USDT"sv, 99.0, 1.0) == true);
+  CHECK(account_cache.balance(MarginMode{}, "USDT"sv, 99.0, 1.0) == true);  // note! margin mode is part of the key
+  CHECK(account_cache.balance(MarginMode::CROSS, "BTC"sv, 99.0, 1.0) == true);
+  CHECK(account_cache.size() == 3);
+}
+
+TEST_CASE("tools_account_cache_position", "[tools_account_cache]") {
+  tools::AccountCache account_cache;
+  CHECK(account_cache.position(MarginMode::CROSS, "BTCUSDT"sv, 1.0, 0.0) == true);
+  CHECK(account_cache.position(MarginMode::CROSS, "BTCUSDT"sv, 1.0, 0.0) == false);
+  CHECK(account_cache.position(MarginMode::CROSS, "BTCUSDT"sv, 0.0, 0.0) == true);
+  CHECK(account_cache.balance(MarginMode::CROSS, "BTCUSDT"sv, 0.0, 0.0) == true);  // note! balances and positions are independent
+  account_cache.clear();
+  CHECK(account_cache.size() == 0);
+  CHECK(account_cache.position(MarginMode::CROSS, "BTCUSDT"sv, 0.0, 0.0) == true);
+}
@@ -0,0 +1,32 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+
+#include "roq/binance_futures/tools/bounded_set.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_bounded_set_simple", "[tools_bounded_set]") {
+  tools::BoundedSet<int64_t> bounded_set{4};
+  CHECK(bounded_set(101) == true);
+  CHECK(bounded_set(101) == false);
+  CHECK(bounded_set(102) == true);
+  CHECK(bounded_set.size() == 2);
+}
+
+TEST_CASE("tools_bounded_set_capacity", "[tools_bounded_set]") {
+  tools::BoundedSet<int64_t> bounded_set{2};
+  CHECK(bounded_set(101) == true);
+  CHECK(bounded_set(102) == true);
+  CHECK(bounded_set(103) == true);
+  CHECK(bounded_set.size() == 2);
+  CHECK(bounded_set(103) == false);
+  CHECK(bounded_set(101) == true);  // note! forgotten
+}
@@ -0,0 +1,32 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/client_order_id_filter.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_client_order_id_filter_simple", "[tools_client_order_id_filter]") {
+  tools::ClientOrderIdFilter filter;
+  CHECK(filter.is_external("web_8Q2cPqv1GZJb3n"sv) == false);  // note! nothing learned yet
+  CHECK(filter("GQACo4s3B0UAAQAAAAAA"sv) == true);
+  CHECK(filter("HgACpIs3B0UAAQAAAAAA"sv) == true);
+  CHECK(filter.is_external("KgQCuUHQB0UAAQAAAAAA"sv) == false);
+  CHECK(filter.is_external("web_8Q2cPqv1GZJb3n"sv) == true);
+  CHECK(filter.is_external("autoclose-1568879465651"sv) == true);
+}
+
+TEST_CASE("tools_client_order_id_filter_variable_length", "[tools_client_order_id_filter]") {
+  tools::ClientOrderIdFilter filter;
+  CHECK(filter("q1735689600123-3-9"sv) == true);
+  CHECK(filter.is_external("q1735689600123-3-10"sv) == true);
+  CHECK(filter("q1735689600123-3-10"sv) == false);  // note! disabled
+  CHECK(filter.is_external("web_8Q2cPqv1GZJb3n"sv) == false);
+  CHECK(filter("q1735689600123-3-11"sv) == true);
+  CHECK(filter.is_external("q1735689600123-3-9"sv) == false);
+}
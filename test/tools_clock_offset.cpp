@@ -0,0 +1,67 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/clock_offset.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_clock_offset_simple", "[tools_clock_offset]") {
+  tools::ClockOffset clock_offset{true};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(clock_offset.get() == 0ns);
+  CHECK(clock_offset.adjust(now) == now);
+  clock_offset.update(now, now + 10ms, now + 105ms);  // note! server is 100ms ahead
+  CHECK(clock_offset.samples() == 1);
+  CHECK(clock_offset.get() == 100ms);
+  CHECK(clock_offset.round_trip() == 10ms);
+  CHECK(clock_offset.adjust(now) == now + 100ms);
+  CHECK(clock_offset.adjust(1700000000000ms) == 1700000000100ms);
+}
+
+TEST_CASE("tools_clock_offset_smoothing", "[tools_clock_offset]") {
+  tools::ClockOffset clock_offset{true};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  clock_offset.update(now, now + 10ms, now + 5ms);
+  CHECK(clock_offset.get() == 0ns);
+  clock_offset.update(now, now + 10ms, now + 85ms);  // note! outlier
+  CHECK(clock_offset.get() == 10ms);
+  CHECK(clock_offset.jitter() > 0ns);
+}
+
+TEST_CASE("tools_clock_offset_lower_bound", "[tools_clock_offset]") {
+  tools::ClockOffset clock_offset{true};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  clock_offset.update_lower_bound(now, now + 50ms);  // note! ignored until the first request/response sample
+  CHECK(clock_offset.get() == 0ns);
+  clock_offset.update(now, now + 10ms, now + 5ms);
+  clock_offset.update_lower_bound(now + 20ms, now + 10ms);  // note! consistent with the estimate
+  CHECK(clock_offset.get() == 0ns);
+  clock_offset.update_lower_bound(now + 20ms, now + 22ms);  // note! event time is in our future
+  CHECK(clock_offset.get() == 2ms);
+}
+
+TEST_CASE("tools_clock_offset_disabled", "[tools_clock_offset]") {
+  tools::ClockOffset clock_offset{false};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  clock_offset.update(now, now + 10ms, now + 105ms);
+  CHECK(clock_offset.get() == 100ms);
+  CHECK(clock_offset.adjust(now) == now);
+}
+
+TEST_CASE("tools_clock_offset_recv_window", "[tools_clock_offset]") {
+  tools::ClockOffset clock_offset{true};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(clock_offset.recv_window(100ms, 5s) == 5s);  // note! no samples
+  clock_offset.update(now, now + 10ms, now + 5ms);
+  CHECK(clock_offset.recv_window(0ns, 5s) == 5s);  // note! disabled
+  CHECK(clock_offset.recv_window(100ms, 5s) == 100ms);
+  CHECK(clock_offset.recv_window(1ms, 5s) == 30ms);  // note! round-trip + 4 x jitter
+  CHECK(clock_offset.recv_window(1ms, 20ms) == 20ms);
+}
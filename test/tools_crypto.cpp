@@ -0,0 +1,53 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "roq/api.hpp"
+
+#include "roq/binance_futures/tools/crypto.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+// https://developers.binance.com/docs/derivatives/usds-margined-futures/general-info#signed-trade-and-user_data-endpoint-security
+auto const KEY = "dbefbc809e3e83c283a984c3a1459732ea7db1360ca80c5c2c8867408d28cc83"sv;
+auto const SECRET = "2b5eb11e18796d12d88f13dc27dbbd02c2cc51ff7059765ed9821957d82bb4d9"sv;
+
+auto create_crypto() {
+  // note! PORTFOLIO uses the secret as-is (HMAC-SHA256)
+  return std::make_unique<tools::Crypto>(KEY, SECRET, MarginMode::PORTFOLIO, ""sv, ""sv);
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_crypto_rest_signature_query", "[tools_crypto]") {
+  auto crypto = create_crypto();
+  std::vector<char> buffer;
+  auto query = "symbol=BTCUSDT&side=BUY&type=LIMIT&quantity=1&price=9000&timeInForce=GTC&recvWindow=5000"sv;
+  auto result = (*crypto).create_rest_signature_query(buffer, 1591702613943ms, query);
+  CHECK(
+      result == "?symbol=BTCUSDT&side=BUY&type=LIMIT&quantity=1&price=9000&timeInForce=GTC&recvWindow=5000&timestamp=1591702613943"
+                "&signature=3c661234138461fcc7a7d8746c6558c9842d4e10870d2ecbedf7777cad694af9"sv);
+}
+
+TEST_CASE("tools_crypto_sign_rest_body", "[tools_crypto]") {
+  auto crypto = create_crypto();
+  auto body = "symbol=BTCUSDT&side=BUY&type=LIMIT&quantity=1&price=9000&timeInForce=GTC&recvWindow=5000"sv;
+  std::vector<char> buffer(1024);
+  std::copy(std::begin(body), std::end(body), std::begin(buffer));
+  auto result = (*crypto).sign_rest_body(buffer, std::size(body), 1591702613943ms);
+  CHECK(
+      result == "symbol=BTCUSDT&side=BUY&type=LIMIT&quantity=1&price=9000&timeInForce=GTC&recvWindow=5000&timestamp=1591702613943"
+                "&signature=3c661234138461fcc7a7d8746c6558c9842d4e10870d2ecbedf7777cad694af9"sv);
+}
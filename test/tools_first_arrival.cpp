@@ -0,0 +1,55 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/first_arrival.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+using Type = tools::UserStreamEvent::Type;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_first_arrival_simple", "[tools_first_arrival]") {
+  tools::FirstArrival first_arrival{8};
+  auto key = tools::UserStreamEvent{
+      .type = Type::ORDER_TRADE_UPDATE,
+      .status = 1,
+      .order_id = 1,
+      .update_time = 1700000000000ms,
+      .trade_id = 101,
+  };
+  CHECK(first_arrival(key) == true);
+  CHECK(first_arrival(key) == false);  // note! same event from another connection
+  key.status = 2;
+  CHECK(first_arrival(key) == true);
+  key.type = Type::TRADE_LITE;
+  CHECK(first_arrival(key) == true);
+  key.update_time += 1ms;
+  CHECK(first_arrival(key) == true);
+  key.trade_id = 102;
+  CHECK(first_arrival(key) == true);
+  CHECK(first_arrival.size() == 5);
+}
+
+TEST_CASE("tools_first_arrival_capacity", "[tools_first_arrival]") {
+  tools::FirstArrival first_arrival{2};
+  CHECK(first_arrival({.type = Type::ACCOUNT_UPDATE, .update_time = 1ms}) == true);
+  CHECK(first_arrival({.type = Type::ACCOUNT_UPDATE, .update_time = 2ms}) == true);
+  CHECK(first_arrival({.type = Type::ACCOUNT_UPDATE, .update_time = 3ms}) == true);
+  CHECK(first_arrival.size() == 2);
+  CHECK(first_arrival({.type = Type::ACCOUNT_UPDATE, .update_time = 3ms}) == false);
+  CHECK(first_arrival({.type = Type::ACCOUNT_UPDATE, .update_time = 1ms}) == true);  // note! forgotten
+}
+
+TEST_CASE("tools_first_arrival_trade", "[tools_first_arrival]") {
+  tools::FirstArrival first_arrival{4};
+  CHECK(first_arrival({.type = Type::TRADE, .order_id = 1, .trade_id = 101}) == true);
+  CHECK(first_arrival({.type = Type::TRADE, .order_id = 1, .trade_id = 101}) == false);
+  CHECK(first_arrival({.type = Type::TRADE, .order_id = 2, .trade_id = 101}) == true);  // note! trade ids are not unique (e.g. self-trade)
+  CHECK(first_arrival.size() == 2);
+}
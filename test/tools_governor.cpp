@@ -0,0 +1,74 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/governor.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_governor_unknown_limits", "[tools_governor]") {
+  tools::Governor governor{90};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  for (size_t i = 0; i < 1000; ++i) {
+    CHECK(governor(now) == true);
+  }
+  CHECK(governor.size() == 0);
+}
+
+TEST_CASE("tools_governor_sync", "[tools_governor]") {
+  tools::Governor governor{50};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  governor.sync(10s, 300, 140, now);  // note! capacity is 150
+  CHECK(governor.size() == 1);
+  for (size_t i = 0; i < 10; ++i) {
+    CHECK(governor(now) == true);
+  }
+  CHECK(governor(now) == false);
+  CHECK(governor(now + 1s) == true);  // note! refill rate is 15/s
+  governor.sync(10s, 300, 150, now + 1s);
+  CHECK(governor(now + 1s) == false);
+}
+
+TEST_CASE("tools_governor_sync_in_flight", "[tools_governor]") {
+  tools::Governor governor{100};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  governor.sync(10s, 100, 90, now);
+  for (size_t i = 0; i < 10; ++i) {
+    CHECK(governor(now) == true);
+  }
+  CHECK(governor(now) == false);
+  // note! the exchange has not yet counted the requests in flight
+  governor.sync(10s, 100, 90, now);
+  CHECK(governor(now) == false);
+  governor.sync(10s, 100, 95, now + 1s);  // note! refill is 10/s, but the exchange count only allows 5
+  CHECK(governor(now + 1s) == true);
+  CHECK(governor.check(now + 1s, 4) == true);
+  CHECK(governor.check(now + 1s, 4) == true);  // note! not consumed
+  CHECK(governor.check(now + 1s, 5) == false);
+  governor.consume(4);
+  CHECK(governor.check(now + 1s) == false);
+}
+
+TEST_CASE("tools_governor_all_buckets", "[tools_governor]") {
+  tools::Governor governor{100};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  governor.sync(10s, 300, 0, now);
+  governor.sync(1min, 1200, 1199, now);
+  CHECK(governor.size() == 2);
+  CHECK(governor(now) == true);
+  CHECK(governor(now) == false);  // note! limited by the 1min bucket
+}
+
+TEST_CASE("tools_governor_disabled", "[tools_governor]") {
+  tools::Governor governor{0};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  governor.sync(10s, 300, 300, now);
+  CHECK(governor.size() == 0);
+  CHECK(governor(now) == true);
+}
@@ -0,0 +1,62 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/in_flight.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_in_flight_simple", "[tools_in_flight]") {
+  tools::InFlight<uint64_t> in_flight{8};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(in_flight.add(1, now, 101) == true);
+  CHECK(in_flight.add(2, now + 1ms, 102) == true);
+  CHECK(in_flight.size() == 2);
+  uint64_t value = {};
+  CHECK(in_flight.remove(2, [&](auto &entry) { value = entry.value; }) == true);
+  CHECK(value == 102);
+  CHECK(in_flight.remove(2, [&](auto &) { FAIL(); }) == false);
+  CHECK(in_flight.remove(3, [&](auto &) { FAIL(); }) == false);
+  CHECK(in_flight.oldest() == now);
+  CHECK(in_flight.size() == 1);
+}
+
+TEST_CASE("tools_in_flight_expire", "[tools_in_flight]") {
+  tools::InFlight<uint64_t> in_flight{8};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(in_flight.add(1, now, 101) == true);
+  CHECK(in_flight.add(3, now + 1s, 103) == true);  // note! gap
+  CHECK(in_flight.add(4, now + 2s, 104) == true);
+  CHECK(in_flight.remove(3, [](auto &) {}) == true);
+  std::vector<uint64_t> values;
+  CHECK(in_flight.expire(now + 1s, [&](auto &entry) { values.emplace_back(entry.value); }) == 1);
+  CHECK(std::size(values) == 1);
+  CHECK(values[0] == 101);
+  CHECK(in_flight.oldest() == now + 2s);
+  CHECK(in_flight.expire(now + 2s, [&](auto &entry) { values.emplace_back(entry.value); }) == 1);
+  CHECK(std::size(values) == 2);
+  CHECK(values[1] == 104);
+  CHECK(in_flight.empty() == true);
+  CHECK(in_flight.oldest() == 0ns);
+}
+
+TEST_CASE("tools_in_flight_full", "[tools_in_flight]") {
+  tools::InFlight<uint64_t> in_flight{4};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  for (uint32_t i = 0; i < 4; ++i) {
+    CHECK(in_flight.add(i + 1, now, i) == true);
+  }
+  CHECK(in_flight.add(5, now, 4) == false);  // note! slot still used by sequence 1
+  CHECK(in_flight.remove(1, [](auto &) {}) == true);
+  CHECK(in_flight.add(5, now, 4) == true);
+  size_t count = 0;
+  in_flight.clear([&](auto &) { ++count; });
+  CHECK(count == 4);
+  CHECK(in_flight.empty() == true);
+}
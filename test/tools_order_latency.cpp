@@ -0,0 +1,46 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/order_latency.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_order_latency_simple", "[tools_order_latency]") {
+  tools::OrderLatency order_latency{1min};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  auto key = tools::OrderLatency::Key{.user_id = 1, .order_id = 2};
+  order_latency.begin(key, now);
+  CHECK(order_latency.size() == 1);
+  CHECK(order_latency.new_order(key, now + 1ms) == 1ms);
+  CHECK(order_latency.new_order(key, now + 2ms) == 0ns);  // note! only once
+  CHECK(order_latency.first_fill(key, now + 3ms) == 3ms);
+  CHECK(order_latency.first_fill(key, now + 4ms) == 0ns);  // note! only once
+  CHECK(order_latency.size() == 0);
+}
+
+TEST_CASE("tools_order_latency_unknown", "[tools_order_latency]") {
+  tools::OrderLatency order_latency{1min};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  auto key = tools::OrderLatency::Key{.user_id = 1, .order_id = 2};
+  CHECK(order_latency.new_order(key, now) == 0ns);
+  CHECK(order_latency.first_fill(key, now) == 0ns);
+}
+
+TEST_CASE("tools_order_latency_horizon", "[tools_order_latency]") {
+  tools::OrderLatency order_latency{1min};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  auto key_1 = tools::OrderLatency::Key{.user_id = 1, .order_id = 1};
+  auto key_2 = tools::OrderLatency::Key{.user_id = 1, .order_id = 2};
+  order_latency.begin(key_1, now);
+  order_latency.begin(key_2, now + 1min);  // note! expires key_1
+  CHECK(order_latency.size() == 1);
+  CHECK(order_latency.first_fill(key_1, now + 1min) == 0ns);
+  CHECK(order_latency.first_fill(key_2, now + 1min + 1ms) == 1ms);
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <limits>
+
+#include "roq/binance_futures/tools/order_state.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+auto const NaN = std::numeric_limits<double>::quiet_NaN();
+
+auto create_update(auto update_time, uint8_t rank, double traded_quantity, bool completed = false) {
+  return tools::OrderState::Update{
+      .update_time = update_time,
+      .rank = rank,
+      .traded_quantity = traded_quantity,
+      .quantity = 10.0,
+      .price = 100.0,
+      .completed = completed,
+  };
+}
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_order_state_redundant", "[tools_order_state]") {
+  tools::OrderState order_state{16, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == false);
+  CHECK(order_state(1, create_update(now, 1, 1.0)) == true);
+  CHECK(order_state(2, create_update(now, 1, 0.0)) == true);  // note! other order
+  auto update = create_update(now, 1, 1.0);
+  update.price = 101.0;  // note! amended
+  CHECK(order_state(1, update) == true);
+  CHECK(order_state.size() == 2);
+}
+
+TEST_CASE("tools_order_state_out_of_order", "[tools_order_state]") {
+  tools::OrderState order_state{16, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(order_state(1, create_update(now + 1ms, 1, 2.0)) == true);
+  CHECK(order_state(1, create_update(now, 1, 1.0)) == false);        // note! older
+  CHECK(order_state(1, create_update(now + 1ms, 1, 1.0)) == false);  // note! less traded
+  CHECK(order_state(1, create_update(now + 2ms, 2, 2.0, true)) == true);
+  CHECK(order_state(1, create_update(now + 3ms, 1, 2.0)) == false);  // note! status regression
+}
+
+TEST_CASE("tools_order_state_unknown", "[tools_order_state]") {
+  tools::OrderState order_state{16, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(order_state(1, create_update(now, 1, NaN)) == true);
+  CHECK(order_state(1, create_update(now, 1, NaN)) == false);
+  CHECK(order_state(1, create_update(0ns, 1, 1.0)) == true);  // note! unknown update time
+}
+
+TEST_CASE("tools_order_state_completed", "[tools_order_state]") {
+  tools::OrderState order_state{2, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  for (uint64_t order_id = 1; order_id <= 3; ++order_id) {
+    CHECK(order_state(order_id, create_update(now, 2, 0.0, true)) == true);
+  }
+  CHECK(order_state.size() == 2);
+  CHECK(order_state(3, create_update(now, 2, 0.0, true)) == false);
+  CHECK(order_state(1, create_update(now, 2, 0.0, true)) == true);  // note! forgotten
+}
+
+TEST_CASE("tools_order_state_working", "[tools_order_state]") {
+  tools::OrderState order_state{2, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state(2, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state(3, create_update(now, 2, 0.0, true)) == true);
+  CHECK(order_state.working() == 2);
+  CHECK(order_state(1, create_update(now + 1ms, 2, 0.0, true)) == true);
+  CHECK(order_state.working() == 1);
+  CHECK(order_state(1, create_update(now + 2ms, 2, 0.0, true)) == true);  // note! already completed
+  CHECK(order_state.working() == 1);
+  for (uint64_t order_id = 4; order_id <= 6; ++order_id) {
+    CHECK(order_state(order_id, create_update(now, 2, 0.0, true)) == true);
+  }
+  CHECK(order_state.working() == 1);
+}
+
+TEST_CASE("tools_order_state_reconcile", "[tools_order_state]") {
+  tools::OrderState order_state{16, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state(2, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state(3, create_update(now, 2, 0.0, true)) == true);
+  CHECK(order_state.working() == 2);
+  // note! the terminal update for order 1 was missed
+  CHECK(order_state.reconcile([](auto order_id) { return order_id == 2; }) == 1);
+  CHECK(order_state.working() == 1);
+  CHECK(order_state.size() == 2);
+  CHECK(order_state(1, create_update(now + 1ms, 2, 0.0, true)) == true);
+  CHECK(order_state.working() == 1);
+}
+
+TEST_CASE("tools_order_state_max_orders", "[tools_order_state]") {
+  tools::OrderState order_state{16, 4};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  for (uint64_t order_id = 1; order_id <= 4; ++order_id) {
+    CHECK(order_state(order_id, create_update(now, 1, 0.0)) == true);
+  }
+  CHECK(order_state.working() == 4);
+  CHECK(order_state(5, create_update(now, 2, 0.0, true)) == true);
+  CHECK(order_state.size() == 4);
+  CHECK(order_state.working() == 3);  // note! oldest removed
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == true);  // note! forgotten
+  CHECK(order_state.size() == 4);
+  CHECK(order_state.working() == 3);
+  for (uint64_t order_id = 6; order_id <= 100; ++order_id) {
+    CHECK(order_state(order_id, create_update(now, 2, 0.0, true)) == true);
+  }
+  CHECK(order_state.size() == 4);
+  CHECK(order_state.working() == 0);
+}
+
+TEST_CASE("tools_order_state_route", "[tools_order_state]") {
+  tools::OrderState order_state{16, 64};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  order_state.set_route(1, {.user_id = 1, .order_id = 2, .strategy_id = 3});
+  CHECK(order_state.find_route(1) == nullptr);  // note! unknown order
+  CHECK(order_state(1, create_update(now, 1, 0.0)) == true);
+  CHECK(order_state.find_route(1) == nullptr);
+  order_state.set_route(1, {.user_id = 1, .order_id = 2, .strategy_id = 3});
+  CHECK(order_state(1, create_update(now + 1ms, 1, 1.0)) == true);
+  auto route = order_state.find_route(1);
+  REQUIRE(route != nullptr);
+  CHECK((*route).user_id == 1);
+  CHECK((*route).order_id == 2);
+  CHECK((*route).strategy_id == 3);
+}
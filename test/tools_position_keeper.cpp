@@ -0,0 +1,62 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/position_keeper.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_position_keeper_simple", "[tools_position_keeper]") {
+  tools::PositionKeeper position_keeper;
+  tools::PositionKeeper::Position position;
+  CHECK(position_keeper.fill("BTCUSDT"sv, 1.0, 1000ms, position) == false);  // note! not yet reconciled
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::CROSS, 1.0, 1000ms) == true);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 2.0, 1000ms, position) == false);  // note! already included
+  CHECK(position_keeper.fill("BTCUSDT"sv, 2.0, 1001ms, position) == true);
+  CHECK(position.margin_mode == MarginMode::CROSS);
+  CHECK(position.long_quantity == 3.0);
+  CHECK(position.short_quantity == 0.0);
+  CHECK(position_keeper.fill("BTCUSDT"sv, -5.0, 1002ms, position) == true);
+  CHECK(position.long_quantity == 0.0);
+  CHECK(position.short_quantity == 2.0);
+  CHECK(position_keeper.size() == 1);
+}
+
+TEST_CASE("tools_position_keeper_reconcile", "[tools_position_keeper]") {
+  tools::PositionKeeper position_keeper;
+  tools::PositionKeeper::Position position;
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::ISOLATED, 0.0, 1000ms) == true);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 1.0, 1002ms, position) == true);
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::ISOLATED, 0.0, 1001ms) == false);  // note! older than the fill
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::ISOLATED, 4.0, 1002ms) == true);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 1.0, 1003ms, position) == true);
+  CHECK(position.margin_mode == MarginMode::ISOLATED);
+  CHECK(position.long_quantity == 5.0);
+}
+
+TEST_CASE("tools_position_keeper_hedged", "[tools_position_keeper]") {
+  tools::PositionKeeper position_keeper;
+  tools::PositionKeeper::Position position;
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::CROSS, 1.0, 1000ms, true) == true);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 1.0, 1001ms, position) == false);
+  position_keeper.clear();
+  CHECK(position_keeper.size() == 0);
+}
+
+TEST_CASE("tools_position_keeper_stale_account_update", "[tools_position_keeper]") {
+  tools::PositionKeeper position_keeper;
+  tools::PositionKeeper::Position position;
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::CROSS, 1.0, 1000ms) == true);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 2.0, 1005ms, position) == true);
+  CHECK(position.long_quantity == 3.0);
+  // note! ACCOUNT_UPDATE generated before the fill (the caller must not publish it)
+  CHECK(position_keeper.reconcile("BTCUSDT"sv, MarginMode::CROSS, 1.0, 1003ms) == false);
+  CHECK(position_keeper.fill("BTCUSDT"sv, 1.0, 1006ms, position) == true);
+  CHECK(position.long_quantity == 4.0);  // note! not moved backwards
+}
@@ -0,0 +1,120 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/pre_trade.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_pre_trade_unknown_limits", "[tools_pre_trade]") {
+  tools::PreTrade pre_trade{{}};
+  auto order = tools::PreTrade::Order{
+      .buy = true,
+      .quantity = 1e9,
+      .price = 1e9,
+  };
+  CHECK(pre_trade.check(order, 1000) == tools::PreTrade::Result::OK);
+  order.market = true;
+  CHECK(pre_trade.check(order, 1000) == tools::PreTrade::Result::OK);
+}
+
+TEST_CASE("tools_pre_trade_exchange_filters", "[tools_pre_trade]") {
+  tools::PreTrade pre_trade{{}};
+  pre_trade.set_limits({
+      .max_quantity = 100.0,
+      .max_market_quantity = 10.0,
+      .min_notional = 5.0,
+      .multiplier_up = 1.05,
+      .multiplier_down = 0.95,
+      .max_open_orders = 2,
+  });
+  pre_trade.update(99.0, 101.0, 1);
+  auto order = tools::PreTrade::Order{
+      .buy = true,
+      .quantity = 1.0,
+      .price = 100.0,
+  };
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);
+  CHECK(pre_trade.check(order, 2) == tools::PreTrade::Result::MAX_OPEN_ORDERS);
+  order.quantity = 101.0;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::MAX_QUANTITY);
+  order.quantity = 0.01;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::MIN_NOTIONAL);
+  order.reduce_only = true;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);  // note! exempt
+  order.reduce_only = false;
+  order.quantity = 1.0;
+  order.price = 105.5;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::PRICE_BAND);
+  order.buy = false;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);  // note! selling above the market
+  order.price = 94.5;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::PRICE_BAND);
+  order.market = true;
+  order.quantity = 11.0;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::MAX_QUANTITY);
+  order.quantity = 0.04;  // note! notional is 0.04 * 99.0 (bid)
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::MIN_NOTIONAL);
+}
+
+TEST_CASE("tools_pre_trade_config", "[tools_pre_trade]") {
+  tools::PreTrade pre_trade{{
+      .max_notional = 1000.0,
+      .multiplier_up = 1.01,
+      .multiplier_down = 0.99,
+      .max_open_orders = 10,
+  }};
+  pre_trade.update(99.0, 101.0, 1);
+  auto order = tools::PreTrade::Order{
+      .buy = true,
+      .quantity = 11.0,
+      .price = 100.0,
+  };
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::MAX_NOTIONAL);
+  pre_trade.set_limits({
+      .max_notional = 2000.0,
+      .multiplier_up = 1.05,
+      .multiplier_down = 0.95,
+      .max_open_orders = 5,
+  });
+  auto &limits = pre_trade.get_limits();
+  CHECK(limits.max_notional == 1000.0);  // note! the tighter limit wins
+  CHECK(limits.multiplier_up == 1.01);
+  CHECK(limits.multiplier_down == 0.99);
+  CHECK(limits.max_open_orders == 5);
+  order.quantity = 1.0;
+  order.price = 101.5;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::PRICE_BAND);
+  CHECK(pre_trade.check(order, 5) == tools::PreTrade::Result::MAX_OPEN_ORDERS);
+}
+
+TEST_CASE("tools_pre_trade_reference_price", "[tools_pre_trade]") {
+  tools::PreTrade pre_trade{{}};
+  pre_trade.set_limits({
+      .min_notional = 5.0,
+  });
+  auto order = tools::PreTrade::Order{
+      .buy = true,
+      .market = true,
+      .quantity = 1.0,
+  };
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::NO_REFERENCE_PRICE);
+  pre_trade.update(99.0, 101.0, 2);
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);
+  // note! older updates are ignored
+  pre_trade.update(1.0, 2.0, 1);
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);
+  pre_trade.clear();
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::NO_REFERENCE_PRICE);
+  order.reduce_only = true;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);  // note! no notional check
+  order.reduce_only = false;
+  order.market = false;
+  order.price = 100.0;
+  CHECK(pre_trade.check(order, 0) == tools::PreTrade::Result::OK);  // note! limit price is the reference
+}
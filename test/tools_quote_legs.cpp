@@ -0,0 +1,78 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "roq/binance_futures/tools/quote_legs.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_quote_legs_simple", "[tools_quote_legs]") {
+  tools::QuoteLegs quote_legs;
+  quote_legs.add("BTCUSDT"sv, "q1"sv, 1);
+  quote_legs.add("BTCUSDT"sv, "q2"sv, 1);
+  quote_legs.add("ETHUSDT"sv, "q3"sv, 2);
+  CHECK(quote_legs.size() == 3);
+  auto leg = quote_legs.find("ETHUSDT"sv, "q3"sv);
+  REQUIRE(leg != nullptr);
+  CHECK((*leg).user_id == 2);
+  CHECK(quote_legs.find("BTCUSDT"sv, "q3"sv) == nullptr);
+  CHECK(quote_legs.find("XRPUSDT"sv, "q1"sv) == nullptr);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q1"sv) == true);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q1"sv) == false);
+  CHECK(quote_legs.size() == 2);
+}
+
+TEST_CASE("tools_quote_legs_cancel", "[tools_quote_legs]") {
+  tools::QuoteLegs quote_legs;
+  quote_legs.add("BTCUSDT"sv, "q1"sv, 1);
+  quote_legs.add("BTCUSDT"sv, "q2"sv, 1);
+  std::vector<std::string> result;
+  auto callback = [&](auto &client_order_id) { result.emplace_back(client_order_id); };
+  quote_legs.cancel("BTCUSDT"sv, 100s, 5s, callback);
+  CHECK(std::size(result) == 2);
+  // note! legs are kept until the cancel has been acknowledged
+  CHECK(quote_legs.size() == 2);
+  quote_legs.add("BTCUSDT"sv, "q3"sv, 1);
+  result.clear();
+  quote_legs.cancel("BTCUSDT"sv, 101s, 5s, callback);
+  REQUIRE(std::size(result) == 1);
+  CHECK(result[0] == "q3"sv);
+  // note! retry only includes legs where the cancel has timed out
+  result.clear();
+  quote_legs.retry("BTCUSDT"sv, 104s, 5s, callback);
+  CHECK(std::empty(result));
+  quote_legs.retry("BTCUSDT"sv, 105s, 5s, callback);
+  CHECK(std::size(result) == 2);
+  result.clear();
+  quote_legs.retry("BTCUSDT"sv, 106s, 5s, callback);
+  REQUIRE(std::size(result) == 1);
+  CHECK(result[0] == "q3"sv);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q1"sv) == true);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q2"sv) == true);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q3"sv) == true);
+  std::vector<std::string> symbols;
+  quote_legs.get_symbols([&](auto &symbol) { symbols.emplace_back(symbol); });
+  CHECK(std::empty(symbols));
+}
+
+TEST_CASE("tools_quote_legs_cancelling", "[tools_quote_legs]") {
+  tools::QuoteLegs quote_legs;
+  CHECK(quote_legs.cancelling("BTCUSDT"sv) == false);
+  quote_legs.add("BTCUSDT"sv, "q1"sv, 1);
+  CHECK(quote_legs.cancelling("BTCUSDT"sv) == false);
+  quote_legs.cancel("BTCUSDT"sv, 100s, 5s, [](auto &) {});
+  CHECK(quote_legs.cancelling("BTCUSDT"sv) == true);
+  CHECK(quote_legs.cancelling("ETHUSDT"sv) == false);
+  // note! new legs can be placed once the cancel has been acknowledged
+  quote_legs.add("BTCUSDT"sv, "q2"sv, 1);
+  CHECK(quote_legs.remove("BTCUSDT"sv, "q1"sv) == true);
+  CHECK(quote_legs.cancelling("BTCUSDT"sv) == false);
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/race.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+auto const KEY = tools::Race::Key{
+    .user_id = 1,
+    .order_id = 2,
+    .version = 3,
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_race_first_accept_wins", "[tools_race]") {
+  tools::Race race{5s};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  race.begin(KEY, 2, now);
+  CHECK(race.size() == 1);
+  CHECK(race(KEY, true) == true);
+  CHECK(race(KEY, true) == false);
+  CHECK(race.size() == 0);
+  CHECK(race(KEY, true) == true);  // note! unknown => forwarded
+}
+
+TEST_CASE("tools_race_reject_then_accept", "[tools_race]") {
+  tools::Race race{5s};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  race.begin(KEY, 2, now);
+  CHECK(race(KEY, false) == false);
+  CHECK(race(KEY, true) == true);
+  CHECK(race.size() == 0);
+}
+
+TEST_CASE("tools_race_all_rejected", "[tools_race]") {
+  tools::Race race{5s};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  race.begin(KEY, 2, now);
+  CHECK(race(KEY, false) == false);
+  CHECK(race(KEY, false) == true);
+  CHECK(race.size() == 0);
+}
+
+TEST_CASE("tools_race_expired", "[tools_race]") {
+  tools::Race race{5s};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  race.begin(KEY, 2, now);
+  CHECK(race(KEY, true) == true);
+  auto key_2 = tools::Race::Key{
+      .user_id = 1,
+      .order_id = 2,
+      .version = 4,
+  };
+  race.begin(key_2, 2, now + 5s);  // note! the first request never completed
+  CHECK(race.size() == 1);
+  CHECK(race(KEY, true) == true);
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "roq/binance_futures/tools/request_queue.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+struct MyHandler final : public tools::TimerWheel::Handler {
+  void operator()(tools::TimerWheel::Timeout const &timeout) override { result.emplace_back(timeout.now); }
+  std::vector<std::chrono::nanoseconds> result;
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_request_queue_simple", "[tools_request_queue]") {
+  tools::TimerWheel timer_wheel{1ms};
+  MyHandler handler;
+  tools::TimerWheel::Timer timer{timer_wheel, handler, 1};
+  tools::RequestQueue<std::string> request_queue{10s, 250ms};
+  request_queue.attach(&timer);
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(timer_wheel.refresh(now) == 0);
+  request_queue.emplace_back("BTCUSDT"s, now);
+  request_queue.emplace_back("ETHUSDT"s, now + 3ms);
+  CHECK(request_queue.next() == now + 10s);
+  CHECK(timer.pending() == true);
+  // note! the timer fires when the request is due (not quantized by any refresh frequency)
+  CHECK(timer_wheel.refresh(now + 10s - 1ms) == 0);
+  CHECK(timer_wheel.refresh(now + 10s) == 1);
+  std::vector<std::string> result;
+  auto callback = [&](auto &value) { result.emplace_back(value); };
+  request_queue.dispatch([](auto) { return true; }, callback, now + 10s);
+  REQUIRE(std::size(result) == 1);
+  CHECK(result[0] == "BTCUSDT"sv);
+  CHECK(timer.pending() == true);
+  CHECK(timer_wheel.refresh(now + 10s + 2ms) == 0);
+  CHECK(timer_wheel.refresh(now + 10s + 3ms) == 1);
+  // note! rate-limited
+  request_queue.dispatch([](auto) { return false; }, callback, now + 10s + 3ms);
+  CHECK(std::size(result) == 1);
+  CHECK(request_queue.size() == 1);
+  CHECK(timer_wheel.refresh(now + 10s + 252ms) == 0);
+  CHECK(timer_wheel.refresh(now + 10s + 253ms) == 1);
+  request_queue.dispatch([](auto) { return true; }, callback, now + 10s + 253ms);
+  REQUIRE(std::size(result) == 2);
+  CHECK(result[1] == "ETHUSDT"sv);
+  CHECK(request_queue.empty() == true);
+  CHECK(timer.pending() == false);
+}
+
+TEST_CASE("tools_request_queue_attach", "[tools_request_queue]") {
+  tools::TimerWheel timer_wheel{1ms};
+  MyHandler handler;
+  tools::TimerWheel::Timer timer{timer_wheel, handler, 1};
+  tools::RequestQueue<std::string> request_queue{0s, 250ms};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(timer_wheel.refresh(now) == 0);
+  request_queue.emplace_back("BTCUSDT"s, now);
+  CHECK(timer.pending() == false);
+  request_queue.attach(&timer);
+  CHECK(timer.pending() == true);
+  CHECK(timer_wheel.refresh(now + 1ms) == 1);
+}
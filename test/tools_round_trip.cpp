@@ -0,0 +1,33 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include "roq/binance_futures/tools/round_trip.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_round_trip_simple", "[tools_round_trip]") {
+  tools::RoundTrip round_trip;
+  CHECK(round_trip.get() == 0ns);
+  round_trip.update(8ms);
+  CHECK(round_trip.get() == 8ms);
+  round_trip.update(16ms);
+  CHECK(round_trip.get() == 9ms);  // note! 8ms + (16ms - 8ms) / 8
+  CHECK(round_trip.samples() == 2);
+}
+
+TEST_CASE("tools_round_trip_update", "[tools_round_trip]") {
+  tools::RoundTrip round_trip;
+  round_trip.update(10ms);
+  for (size_t i = 0; i < 100; ++i) {
+    round_trip.update(2ms);
+  }
+  CHECK(round_trip.get() < 3ms);
+  CHECK(round_trip.get() >= 2ms);
+}
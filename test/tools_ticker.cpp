@@ -0,0 +1,71 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <vector>
+
+#include "roq/binance_futures/tools/ticker.hpp"
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+struct MyHandler final : public tools::TimerWheel::Handler {
+  void operator()(tools::TimerWheel::Timeout const &timeout) override { result.emplace_back(timeout.type); }
+  std::vector<uint32_t> result;
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_ticker_simple", "[tools_ticker]") {
+  tools::TimerWheel timer_wheel{1ms};
+  tools::Ticker ticker{timer_wheel, 100ms};
+  MyHandler handler_1, handler_2;
+  tools::Ticker::Subscription subscription_1{ticker, handler_1, 1}, subscription_2{ticker, handler_2, 2};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(timer_wheel.refresh(now) == 0);
+  CHECK(timer_wheel.size() == 0);
+  subscription_1.start(now);
+  subscription_2.start(now);
+  // note! only one timer
+  CHECK(timer_wheel.size() == 1);
+  CHECK(ticker.size() == 2);
+  CHECK(timer_wheel.refresh(now + 99ms) == 0);
+  CHECK(timer_wheel.refresh(now + 100ms) == 1);
+  REQUIRE(std::size(handler_1.result) == 1);
+  CHECK(handler_1.result[0] == 1);
+  REQUIRE(std::size(handler_2.result) == 1);
+  CHECK(handler_2.result[0] == 2);
+  subscription_2.stop();
+  CHECK(subscription_2.active() == false);
+  CHECK(timer_wheel.refresh(now + 200ms) == 1);
+  CHECK(std::size(handler_1.result) == 2);
+  CHECK(std::size(handler_2.result) == 1);
+  // note! the timer is cancelled when no handler is active
+  subscription_1.stop();
+  CHECK(timer_wheel.size() == 0);
+  CHECK(timer_wheel.refresh(now + 300ms) == 0);
+  CHECK(std::size(handler_1.result) == 2);
+}
+
+TEST_CASE("tools_ticker_release", "[tools_ticker]") {
+  tools::TimerWheel timer_wheel{1ms};
+  tools::Ticker ticker{timer_wheel, 100ms};
+  MyHandler handler;
+  auto now = std::chrono::nanoseconds{1700000000s};
+  timer_wheel.refresh(now);
+  {
+    tools::Ticker::Subscription subscription{ticker, handler, 1};
+    subscription.start(now);
+    CHECK(timer_wheel.size() == 1);
+  }
+  CHECK(ticker.size() == 0);
+  CHECK(timer_wheel.size() == 0);
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <vector>
+
+#include "roq/binance_futures/tools/timer_wheel.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+using namespace std::chrono_literals;
+
+// === HELPERS ===
+
+namespace {
+struct MyHandler final : public tools::TimerWheel::Handler {
+  void operator()(tools::TimerWheel::Timeout const &timeout) override { result.emplace_back(timeout.type); }
+  std::vector<uint32_t> result;
+};
+}  // namespace
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_timer_wheel_simple", "[tools_timer_wheel]") {
+  tools::TimerWheel timer_wheel{1ms};
+  MyHandler handler;
+  tools::TimerWheel::Timer timer_1{timer_wheel, handler, 1}, timer_2{timer_wheel, handler, 2};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  CHECK(timer_wheel.refresh(now) == 0);
+  timer_1.schedule(now + 10ms);
+  timer_2.schedule(now + 5s);
+  CHECK(timer_wheel.size() == 2);
+  CHECK(timer_wheel.refresh(now + 9ms) == 0);
+  CHECK(timer_wheel.refresh(now + 10ms) == 1);
+  REQUIRE(std::size(handler.result) == 1);
+  CHECK(handler.result[0] == 1);
+  CHECK(timer_1.pending() == false);
+  CHECK(timer_2.pending() == true);
+  CHECK(timer_wheel.refresh(now + 4999ms) == 0);
+  CHECK(timer_wheel.refresh(now + 5001ms) == 1);
+  REQUIRE(std::size(handler.result) == 2);
+  CHECK(handler.result[1] == 2);
+  CHECK(timer_wheel.size() == 0);
+}
+
+TEST_CASE("tools_timer_wheel_reschedule", "[tools_timer_wheel]") {
+  tools::TimerWheel timer_wheel{1ms};
+  MyHandler handler;
+  tools::TimerWheel::Timer timer{timer_wheel, handler, 1};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  timer_wheel.refresh(now);
+  timer.schedule(now + 1h);
+  timer.schedule(now + 1s);  // note! replaces
+  CHECK(timer_wheel.size() == 1);
+  CHECK(timer_wheel.refresh(now + 1s) == 1);
+  timer.schedule(now + 2s);
+  timer.cancel();
+  CHECK(timer_wheel.size() == 0);
+  CHECK(timer_wheel.refresh(now + 3s) == 0);
+  CHECK(std::size(handler.result) == 1);
+}
+
+TEST_CASE("tools_timer_wheel_beyond_horizon", "[tools_timer_wheel]") {
+  tools::TimerWheel timer_wheel{1ms};
+  MyHandler handler;
+  tools::TimerWheel::Timer timer{timer_wheel, handler, 1};
+  auto now = std::chrono::nanoseconds{1700000000s};
+  timer_wheel.refresh(now);
+  timer.schedule(now + 24h);
+  for (auto i = 1; i < 24 * 60; ++i) {
+    CHECK(timer_wheel.refresh(now + std::chrono::minutes{i}) == 0);
+  }
+  CHECK(timer_wheel.refresh(now + 24h) == 1);
+}
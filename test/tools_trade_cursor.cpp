@@ -0,0 +1,63 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+
+#include "roq/binance_futures/tools/trade_cursor.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_trade_cursor_simple", "[tools_trade_cursor]") {
+  tools::TradeCursor trade_cursor;
+  CHECK(trade_cursor.get("BTCUSDT"sv) == 0);
+  CHECK(trade_cursor.update("BTCUSDT"sv, 100) == true);
+  CHECK(trade_cursor.update("BTCUSDT"sv, 99) == false);  // note! never moves backwards
+  CHECK(trade_cursor.update("BTCUSDT"sv, 100) == false);
+  CHECK(trade_cursor.update("ETHUSDT"sv, 10) == true);
+  CHECK(trade_cursor.get("BTCUSDT"sv) == 100);
+  CHECK(trade_cursor.get("ETHUSDT"sv) == 10);
+  CHECK(trade_cursor.size() == 2);
+  CHECK(trade_cursor.save() == true);  // note! persistence disabled
+}
+
+TEST_CASE("tools_trade_cursor_stale", "[tools_trade_cursor]") {
+  tools::TradeCursor trade_cursor;
+  CHECK(trade_cursor.stale() == true);  // note! until the first download has completed
+  trade_cursor.downloaded(100s);
+  CHECK(trade_cursor.stale() == false);
+  trade_cursor.set_stale(200s);
+  CHECK(trade_cursor.stale() == true);
+  trade_cursor.downloaded(150s);  // note! started before the disconnect
+  CHECK(trade_cursor.stale() == true);
+  trade_cursor.downloaded(200s);
+  CHECK(trade_cursor.stale() == false);
+}
+
+TEST_CASE("tools_trade_cursor_persistence", "[tools_trade_cursor]") {
+  auto path = (std::filesystem::temp_directory_path() / "tools_trade_cursor_persistence.trades").string();
+  std::filesystem::remove(path);
+  {
+    tools::TradeCursor trade_cursor;
+    trade_cursor.load(path);
+    CHECK(trade_cursor.size() == 0);
+    trade_cursor.update("BTCUSDT"sv, 100);
+    trade_cursor.update("ETHUSDT"sv, 10);
+    CHECK(trade_cursor.save() == true);
+    trade_cursor.update("BTCUSDT"sv, 101);
+    CHECK(trade_cursor.save() == true);
+  }
+  {
+    tools::TradeCursor trade_cursor;
+    trade_cursor.load(path);
+    CHECK(trade_cursor.size() == 2);
+    CHECK(trade_cursor.get("BTCUSDT"sv) == 101);
+    CHECK(trade_cursor.get("ETHUSDT"sv) == 10);
+  }
+  std::filesystem::remove(path);
+}
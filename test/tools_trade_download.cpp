@@ -0,0 +1,34 @@
+/* Copyright (c) 2017-2025, Hans Erik Thrane */
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "roq/binance_futures/tools/trade_download.hpp"
+
+using namespace roq;
+using namespace roq::binance_futures;
+
+using namespace std::literals;
+
+// === IMPLEMENTATION ===
+
+TEST_CASE("tools_trade_download_simple", "[tools_trade_download]") {
+  tools::TradeDownload trade_download;
+  CHECK(trade_download.downloading() == false);
+  std::vector<std::string> symbols{"BTCUSDT", "ETHUSDT"};
+  trade_download.begin(symbols, 100s);
+  CHECK(trade_download.downloading() == true);
+  CHECK(trade_download.start() == 100s);
+  CHECK(trade_download.current() == "BTCUSDT"sv);
+  trade_download.next(true);  // note! page was full
+  CHECK(trade_download.current() == "BTCUSDT"sv);
+  trade_download.next(false);
+  CHECK(trade_download.current() == "ETHUSDT"sv);
+  trade_download.next(false);
+  CHECK(trade_download.downloading() == false);
+  trade_download.begin(symbols, 200s);
+  trade_download.reset();
+  CHECK(trade_download.downloading() == false);
+}
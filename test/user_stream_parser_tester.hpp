@@ -2,6 +2,8 @@
 
 #include <catch2/catch_all.hpp>
 
+#include "roq/binance_futures/json/order_trade_update.hpp"
+#include "roq/binance_futures/json/trade_lite.hpp"
 #include "roq/binance_futures/json/user_stream_parser.hpp"
 
 namespace roq {
@@ -20,22 +22,22 @@ struct UserStreamParserTester final : public json::UserStreamParser::Handler {
     callback(obj);
     // parser
     // XXX FIXME TODO catch2 block ???
-    UserStreamParserTester handler{callback};
+    UserStreamParserTester handler{callback, obj};
     auto res = json::UserStreamParser::dispatch(handler, message, buffers, {}, false);
     CHECK(res == true);
     CHECK(handler.found_ == true);
   }
 
  protected:
-  explicit UserStreamParserTester(callback_type const &callback) : callback_{callback} {}
+  UserStreamParserTester(callback_type const &callback, value_type const &reference) : callback_{callback}, reference_{reference} {}
 
-  void operator()(Trace<json::OrderTradeUpdate> const &event) override { dispatch_helper(event); }
+  void operator()(Trace<json::FastOrderTradeUpdate> const &event) override { compare_helper(event); }
   void operator()(Trace<json::AccountUpdate> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::MarginCall> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::StrategyUpdate> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::GridUpdate> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::AccountConfigUpdate> const &event) override { dispatch_helper(event); }
-  void operator()(Trace<json::TradeLite> const &event) override { dispatch_helper(event); }
+  void operator()(Trace<json::FastTradeLite> const &event) override { compare_helper(event); }
   void operator()(Trace<json::ExecutionReport2> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::BalanceUpdate> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::LiabilityChange> const &event) override { dispatch_helper(event); }
@@ -51,8 +53,55 @@ struct UserStreamParserTester final : public json::UserStreamParser::Handler {
     }
   }
 
+  // note! the fast path decodes a flat projection which is compared with the reference decoder
+  template <typename U>
+  void compare_helper(Trace<U> const &event) {
+    auto &lhs = event.value;
+    if constexpr (std::is_same_v<U, json::FastOrderTradeUpdate> && std::is_same_v<value_type, json::OrderTradeUpdate>) {
+      found_ = true;
+      auto &rhs = reference_.execution_report;
+      CHECK(lhs.event_type == reference_.event_type);
+      CHECK(lhs.event_time == reference_.event_time);
+      CHECK(lhs.transaction_time == reference_.transaction_time);
+      CHECK(lhs.symbol == rhs.symbol);
+      CHECK(lhs.client_order_id == rhs.client_order_id);
+      CHECK(lhs.side == rhs.side);
+      CHECK(lhs.order_type == rhs.order_type);
+      CHECK(lhs.time_in_force == rhs.time_in_force);
+      CHECK(lhs.original_quantity == Catch::Approx{rhs.original_quantity});
+      CHECK(lhs.original_price == Catch::Approx{rhs.original_price});
+      CHECK(lhs.average_price == Catch::Approx{rhs.average_price});
+      CHECK(lhs.stop_price == Catch::Approx{rhs.stop_price});
+      CHECK(lhs.execution_type == rhs.execution_type);
+      CHECK(lhs.order_status == rhs.order_status);
+      CHECK(lhs.order_id == rhs.order_id);
+      CHECK(lhs.last_filled_quantity == Catch::Approx{rhs.last_filled_quantity});
+      CHECK(lhs.order_filled_accumulated_quantity == Catch::Approx{rhs.order_filled_accumulated_quantity});
+      CHECK(lhs.last_filled_price == Catch::Approx{rhs.last_filled_price});
+      CHECK(lhs.commission_asset == rhs.commission_asset);
+      CHECK(lhs.order_trade_time == rhs.order_trade_time);
+      CHECK(lhs.trade_id == rhs.trade_id);
+      CHECK(lhs.is_trade_maker == rhs.is_trade_maker);
+    } else if constexpr (std::is_same_v<U, json::FastTradeLite> && std::is_same_v<value_type, json::TradeLite>) {
+      found_ = true;
+      auto &rhs = reference_;
+      CHECK(lhs.event_time == rhs.event_time);
+      CHECK(lhs.transaction_time == rhs.transaction_time);
+      CHECK(lhs.symbol == rhs.symbol);
+      CHECK(lhs.client_order_id == rhs.client_order_id);
+      CHECK(lhs.side == rhs.side);
+      CHECK(lhs.last_filled_quantity == Catch::Approx{rhs.last_filled_quantity});
+      CHECK(lhs.last_filled_price == Catch::Approx{rhs.last_filled_price});
+      CHECK(lhs.trade_id == rhs.trade_id);
+      CHECK(lhs.order_id == rhs.order_id);
+    } else {
+      FAIL();
+    }
+  }
+
  private:
   callback_type const callback_;
+  value_type const &reference_;
   bool found_ = false;
 };
 
@@ -16,8 +16,10 @@ struct WSAPIParserTester final : public json::WSAPIParser::Handler {
     core::json::BufferStack buffers{buffer_size, max_depth};
     // simple
     // XXX FIXME TODO catch2 block ???
-    T obj{message, buffers};
-    callback(obj);
+    if constexpr (std::is_constructible_v<T, std::string_view const &, core::json::BufferStack &>) {
+      T obj{message, buffers};
+      callback(obj);
+    }
     // parser
     // XXX FIXME TODO catch2 block ???
     WSAPIParserTester handler{callback};
@@ -32,6 +34,8 @@ struct WSAPIParserTester final : public json::WSAPIParser::Handler {
   void operator()(Trace<json::WSAPIError> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPISessionLogon> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIListenKey> const &event) override { dispatch_helper(event); }
+  void operator()(Trace<json::WSAPISubscribe> const &event) override { dispatch_helper(event); }
+  void operator()(Trace<json::WSAPIParser::UserDataEvent> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIAccountBalance> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIAccountStatus> const &event) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIAccountPosition> const &event) override { dispatch_helper(event); }
@@ -41,6 +45,7 @@ struct WSAPIParserTester final : public json::WSAPIParser::Handler {
   void operator()(Trace<json::WSAPIOrderPlace> const &event, json::WSAPIRequest const &) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIOrderModify> const &event, json::WSAPIRequest const &) override { dispatch_helper(event); }
   void operator()(Trace<json::WSAPIOrderCancel> const &event, json::WSAPIRequest const &) override { dispatch_helper(event); }
+  void operator()(Trace<json::WSAPIOrderStatus> const &event, json::WSAPIRequest const &) override { dispatch_helper(event); }
 
   template <typename U>
   void dispatch_helper(Trace<U> const &event) {